@@ -0,0 +1,291 @@
+# Intended to be included by sail-codecs-archive to convert codec info files into constant
+# C structures at build time. Mirrors the runtime codec info parser in libsail.
+#
+
+# Converts a value like "BPP24-RGB" into a C enum name like "SAIL_PIXEL_FORMAT_BPP24_RGB"
+#
+function(sail_codec_info_enum_name PREFIX VALUE RESULT)
+    string(STRIP "${VALUE}" VALUE)
+    string(TOUPPER "${VALUE}" VALUE)
+    string(REPLACE "-" "_" VALUE "${VALUE}")
+    set(${RESULT} "${PREFIX}${VALUE}" PARENT_SCOPE)
+endfunction()
+
+# Converts a serialized list like "A;B;C" into "PREFIX_A, PREFIX_B, PREFIX_C" and its length
+#
+function(sail_codec_info_enum_list PREFIX VALUE RESULT RESULT_LENGTH)
+    set(items "")
+    set(length 0)
+
+    foreach(item IN LISTS VALUE)
+        sail_codec_info_enum_name(${PREFIX} "${item}" item)
+        list(APPEND items ${item})
+        math(EXPR length "${length} + 1")
+    endforeach()
+
+    string(REPLACE ";" ", " items "${items}")
+
+    set(${RESULT} "${items}" PARENT_SCOPE)
+    set(${RESULT_LENGTH} ${length} PARENT_SCOPE)
+endfunction()
+
+# Converts serialized flags like "A;B" into "PREFIX_A | PREFIX_B" or 0
+#
+function(sail_codec_info_flags PREFIX VALUE RESULT)
+    set(flags "")
+
+    foreach(item IN LISTS VALUE)
+        sail_codec_info_enum_name(${PREFIX} "${item}" item)
+        list(APPEND flags ${item})
+    endforeach()
+
+    if (flags STREQUAL "")
+        set(flags "0")
+    endif()
+
+    string(REPLACE ";" " | " flags "${flags}")
+
+    set(${RESULT} "${flags}" PARENT_SCOPE)
+endfunction()
+
+# Converts a string into a C string literal
+#
+function(sail_codec_info_string_literal VALUE RESULT)
+    string(REPLACE "\\" "\\\\" VALUE "${VALUE}")
+    string(REPLACE "\"" "\\\"" VALUE "${VALUE}")
+    set(${RESULT} "(char *)\"${VALUE}\"" PARENT_SCOPE)
+endfunction()
+
+# Converts a serialized string list into a chain of static string nodes. Returns the C code
+# and the expression pointing to the first node.
+#
+function(sail_codec_info_string_nodes NAME VALUE RESULT RESULT_FIRST)
+    set(code "")
+    set(next "NULL")
+
+    list(LENGTH VALUE length)
+
+    # Define the nodes in reverse order so every node is declared before it's referenced
+    #
+    while (length GREATER 0)
+        math(EXPR length "${length} - 1")
+        list(GET VALUE ${length} item)
+        string(STRIP "${item}" item)
+        string(TOLOWER "${item}" item)
+        sail_codec_info_string_literal("${item}" item)
+
+        string(APPEND code "static struct sail_string_node ${NAME}_${length} = { ${item}, ${next} };\n")
+        set(next "&${NAME}_${length}")
+    endwhile()
+
+    set(${RESULT} "${code}" PARENT_SCOPE)
+    set(${RESULT_FIRST} "${next}" PARENT_SCOPE)
+endfunction()
+
+# Parses the specified codec info file and generates static C definitions of its read and write
+# features, string nodes, and the codec info structure named by VARIABLE. Optionally sets
+# READ_SCAN_LINES to TRUE if the codec declares the SCAN-LINES read feature.
+#
+# Usage:
+#   sail_codec_info_to_c(FILE <path> VARIABLE <C variable name> RESULT <CMake variable>
+#                        [READ_SCAN_LINES <CMake variable>])
+#
+function(sail_codec_info_to_c)
+    cmake_parse_arguments(SAIL_CODEC_INFO "" "FILE;VARIABLE;RESULT;READ_SCAN_LINES" "" ${ARGN})
+
+    file(READ ${SAIL_CODEC_INFO_FILE} contents)
+
+    # Values are separated with semicolons that are list separators in CMake. Split the contents
+    # into lines first, and then split every value.
+    #
+    string(REPLACE ";" "<sail-separator>" contents "${contents}")
+    string(REPLACE "\r" "" contents "${contents}")
+    string(REPLACE "\n" ";" lines "${contents}")
+
+    set(section "")
+    set(mapping_keys "")
+
+    foreach(line IN LISTS lines)
+        string(STRIP "${line}" line)
+
+        if (line STREQUAL "" OR line MATCHES "^[#;]")
+            continue()
+        endif()
+
+        if (line MATCHES "^\\[(.+)\\]$")
+            set(section ${CMAKE_MATCH_1})
+            continue()
+        endif()
+
+        if (NOT line MATCHES "^([^=]+)=(.*)$")
+            message(FATAL_ERROR "Failed to parse '${line}' in ${SAIL_CODEC_INFO_FILE}")
+        endif()
+
+        string(STRIP "${CMAKE_MATCH_1}" key)
+        string(STRIP "${CMAKE_MATCH_2}" value)
+        string(REPLACE "<sail-separator>" ";" value "${value}")
+
+        # Silently ignore empty values like the runtime parser does
+        #
+        if (value STREQUAL "")
+            continue()
+        endif()
+
+        if (section STREQUAL "write-pixel-formats-mapping")
+            list(APPEND mapping_keys ${key})
+            set(mapping_${key} "${value}")
+        elseif (section STREQUAL "codec" OR section STREQUAL "read-features" OR section STREQUAL "write-features")
+            set(${section}_${key} "${value}")
+        else()
+            message(FATAL_ERROR "Unsupported codec info section '${section}' in ${SAIL_CODEC_INFO_FILE}")
+        endif()
+    endforeach()
+
+    if (NOT codec_layout EQUAL 4)
+        message(FATAL_ERROR "Unsupported codec layout version '${codec_layout}' in ${SAIL_CODEC_INFO_FILE}")
+    endif()
+
+    set(code "")
+
+    # String nodes
+    #
+    foreach(magic_number IN LISTS codec_magic-numbers)
+        string(LENGTH "${magic_number}" magic_number_length)
+        math(EXPR magic_number_length_max "${SAIL_MAGIC_BUFFER_SIZE} * 3 - 1")
+
+        if (magic_number_length GREATER magic_number_length_max)
+            message(FATAL_ERROR "Magic number '${magic_number}' is too long in ${SAIL_CODEC_INFO_FILE}")
+        endif()
+    endforeach()
+
+    sail_codec_info_string_nodes(magic_number_node "${codec_magic-numbers}" nodes magic_number_node)
+    string(APPEND code "${nodes}")
+    sail_codec_info_string_nodes(extension_node "${codec_extensions}" nodes extension_node)
+    string(APPEND code "${nodes}")
+    sail_codec_info_string_nodes(mime_type_node "${codec_mime-types}" nodes mime_type_node)
+    string(APPEND code "${nodes}")
+
+    # Read features
+    #
+    if (DEFINED read-features_output-pixel-formats)
+        sail_codec_info_enum_list(SAIL_PIXEL_FORMAT_ "${read-features_output-pixel-formats}" items length)
+        string(APPEND code "\nstatic enum SailPixelFormat read_output_pixel_formats[] = { ${items} };\n")
+        set(read_output_pixel_formats "read_output_pixel_formats")
+    else()
+        set(read_output_pixel_formats "NULL")
+        set(length 0)
+    endif()
+
+    if (DEFINED read-features_default-output-pixel-format)
+        sail_codec_info_enum_name(SAIL_PIXEL_FORMAT_ "${read-features_default-output-pixel-format}" default_output_pixel_format)
+    else()
+        set(default_output_pixel_format SAIL_PIXEL_FORMAT_UNKNOWN)
+    endif()
+
+    sail_codec_info_flags(SAIL_CODEC_FEATURE_ "${read-features_features}" read_features)
+
+    string(APPEND code "
+static struct sail_read_features read_features = {
+    .output_pixel_formats        = ${read_output_pixel_formats},
+    .output_pixel_formats_length = ${length},
+    .default_output_pixel_format = ${default_output_pixel_format},
+    .features                    = ${read_features},
+};
+")
+
+    # Write pixel formats mapping
+    #
+    set(mapping_node "NULL")
+    list(LENGTH mapping_keys mapping_length)
+
+    while (mapping_length GREATER 0)
+        math(EXPR mapping_length "${mapping_length} - 1")
+        list(GET mapping_keys ${mapping_length} key)
+
+        sail_codec_info_enum_name(SAIL_PIXEL_FORMAT_ "${key}" input_pixel_format)
+        sail_codec_info_enum_list(SAIL_PIXEL_FORMAT_ "${mapping_${key}}" items length)
+
+        string(APPEND code "
+static enum SailPixelFormat mapping_output_pixel_formats_${mapping_length}[] = { ${items} };
+static struct sail_pixel_formats_mapping_node mapping_node_${mapping_length} = {
+    .input_pixel_format          = ${input_pixel_format},
+    .output_pixel_formats        = mapping_output_pixel_formats_${mapping_length},
+    .output_pixel_formats_length = ${length},
+    .next                        = ${mapping_node},
+};
+")
+        set(mapping_node "&mapping_node_${mapping_length}")
+    endwhile()
+
+    # Write features
+    #
+    if (DEFINED write-features_compression-types)
+        sail_codec_info_enum_list(SAIL_COMPRESSION_ "${write-features_compression-types}" items compressions_length)
+        string(APPEND code "\nstatic enum SailCompression write_compressions[] = { ${items} };\n")
+        set(compressions "write_compressions")
+    else()
+        set(compressions "NULL")
+        set(compressions_length 0)
+    endif()
+
+    if (DEFINED write-features_default-compression)
+        sail_codec_info_enum_name(SAIL_COMPRESSION_ "${write-features_default-compression}" default_compression)
+    else()
+        set(default_compression SAIL_COMPRESSION_UNSUPPORTED)
+    endif()
+
+    sail_codec_info_flags(SAIL_CODEC_FEATURE_ "${write-features_features}" write_features)
+    sail_codec_info_flags(SAIL_IMAGE_PROPERTY_ "${write-features_properties}" write_properties)
+
+    foreach(key interlaced-passes compression-level-min compression-level-max compression-level-default compression-level-step)
+        if (NOT DEFINED write-features_${key})
+            set(write-features_${key} 0)
+        endif()
+    endforeach()
+
+    string(APPEND code "
+static struct sail_write_features write_features = {
+    .pixel_formats_mapping_node = ${mapping_node},
+    .features                   = ${write_features},
+    .properties                 = ${write_properties},
+    .interlaced_passes          = ${write-features_interlaced-passes},
+    .compressions               = ${compressions},
+    .compressions_length        = ${compressions_length},
+    .default_compression        = ${default_compression},
+    .compression_level_min      = ${write-features_compression-level-min},
+    .compression_level_max      = ${write-features_compression-level-max},
+    .compression_level_default  = ${write-features_compression-level-default},
+    .compression_level_step     = ${write-features_compression-level-step},
+};
+")
+
+    # Codec info
+    #
+    sail_codec_info_string_literal("${codec_version}"     version)
+    sail_codec_info_string_literal("${codec_name}"        name)
+    sail_codec_info_string_literal("${codec_description}" description)
+
+    string(APPEND code "
+const struct sail_codec_info ${SAIL_CODEC_INFO_VARIABLE} = {
+    .path              = NULL,
+    .layout            = ${codec_layout},
+    .version           = ${version},
+    .name              = ${name},
+    .description       = ${description},
+    .magic_number_node = ${magic_number_node},
+    .extension_node    = ${extension_node},
+    .mime_type_node    = ${mime_type_node},
+    .read_features     = &read_features,
+    .write_features    = &write_features,
+};")
+
+    set(${SAIL_CODEC_INFO_RESULT} "${code}" PARENT_SCOPE)
+
+    if (SAIL_CODEC_INFO_READ_SCAN_LINES)
+        if ("SCAN-LINES" IN_LIST read-features_features)
+            set(${SAIL_CODEC_INFO_READ_SCAN_LINES} TRUE PARENT_SCOPE)
+        else()
+            set(${SAIL_CODEC_INFO_READ_SCAN_LINES} FALSE PARENT_SCOPE)
+        endif()
+    endif()
+endfunction()
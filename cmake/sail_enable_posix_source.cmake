@@ -1,11 +1,12 @@
-# Intended to be included by SAIL libraries to enable _POSIX_C_SOURCE on UNIX
+# Intended to be included by SAIL libraries to enable _POSIX_C_SOURCE and 64-bit file offsets on UNIX
 #
 macro(sail_enable_posix_source)
     cmake_parse_arguments(SAIL_POSIX_SOURCE "" "TARGET;VERSION" "" ${ARGN})
 
-    # Enable _POSIX_C_SOURCE on the specified target
+    # Enable _POSIX_C_SOURCE on the specified target. Also make off_t 64-bit on 32-bit platforms
+    # to access files larger than 2 GB.
     #
     if (UNIX)
-        target_compile_definitions(${SAIL_POSIX_SOURCE_TARGET} PRIVATE _POSIX_C_SOURCE=${SAIL_POSIX_SOURCE_VERSION})
+        target_compile_definitions(${SAIL_POSIX_SOURCE_TARGET} PRIVATE _POSIX_C_SOURCE=${SAIL_POSIX_SOURCE_VERSION} _FILE_OFFSET_BITS=64)
     endif()
 endmacro()
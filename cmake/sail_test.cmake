@@ -1,7 +1,7 @@
 # Intended to be included by every test.
 #
 macro(sail_test)
-    cmake_parse_arguments(SAIL_TEST "" "TARGET" "SOURCES" ${ARGN})
+    cmake_parse_arguments(SAIL_TEST "CODECS" "TARGET" "SOURCES" ${ARGN})
 
     # Add a test
     #
@@ -16,4 +16,30 @@ macro(sail_test)
     # Depend on sail-munit
     #
     target_link_libraries(${SAIL_TEST_TARGET} sail-munit)
+
+    # Copy the enabled codecs into a private directory of the test and load them from there.
+    # Combined codecs are linked into sail.
+    #
+    if (SAIL_TEST_CODECS AND NOT SAIL_COMBINE_CODECS)
+        set(SAIL_TEST_CODECS_PATH "${CMAKE_CURRENT_BINARY_DIR}/${SAIL_TEST_TARGET}-codecs")
+
+        # Copy on every build, so rebuilt codecs are tested too
+        #
+        add_custom_target(${SAIL_TEST_TARGET}-codecs
+                          COMMAND ${CMAKE_COMMAND} -E make_directory "${SAIL_TEST_CODECS_PATH}")
+
+        foreach (codec IN LISTS ENABLED_CODECS)
+            add_dependencies(${SAIL_TEST_TARGET}-codecs sail-codec-${codec})
+
+            add_custom_command(TARGET ${SAIL_TEST_TARGET}-codecs POST_BUILD
+                               COMMAND ${CMAKE_COMMAND} -E copy_if_different
+                                       $<TARGET_FILE:sail-codec-${codec}>
+                                       "${PROJECT_BINARY_DIR}/src/sail-codecs/${codec}/sail-codec-${codec}.codec.info"
+                                       "${SAIL_TEST_CODECS_PATH}")
+        endforeach()
+
+        add_dependencies(${SAIL_TEST_TARGET} ${SAIL_TEST_TARGET}-codecs)
+
+        set_tests_properties(${SAIL_TEST_TARGET} PROPERTIES ENVIRONMENT "SAIL_CODECS_PATH=${SAIL_TEST_CODECS_PATH}")
+    endif()
 endmacro()
@@ -181,7 +181,7 @@ sail_status_t codec_info::from_magic_number(const void *buffer, size_t buffer_le
     SAIL_CHECK_CODEC_INFO_PTR(scodec_info);
 
     const struct sail_codec_info *sail_codec_info;
-    SAIL_TRY(sail_codec_info_by_magic_number_from_mem(buffer, buffer_length, &sail_codec_info));
+    SAIL_TRY(sail_codec_info_by_magic_number_from_bytes(buffer, buffer_length, &sail_codec_info));
 
     *scodec_info = codec_info(sail_codec_info);
 
@@ -261,6 +261,25 @@ sail_status_t codec_info::from_mime_type(const char *mime_type, codec_info *scod
     return SAIL_OK;
 }
 
+sail_status_t codec_info::from_name(const std::string &name, codec_info *scodec_info)
+{
+    SAIL_TRY(from_name(name.c_str(), scodec_info));
+
+    return SAIL_OK;
+}
+
+sail_status_t codec_info::from_name(const char *name, codec_info *scodec_info)
+{
+    SAIL_CHECK_CODEC_INFO_PTR(scodec_info);
+
+    const struct sail_codec_info *sail_codec_info;
+    SAIL_TRY(sail_codec_info_from_name(name, &sail_codec_info));
+
+    *scodec_info = codec_info(sail_codec_info);
+
+    return SAIL_OK;
+}
+
 std::vector<codec_info> codec_info::list()
 {
     std::vector<codec_info> codec_info_list;
@@ -48,6 +48,8 @@ struct sail_codec_info;
 namespace sail
 {
 
+class io;
+
 /*
  * A C++ interface to struct sail_codec_info.
  */
@@ -174,6 +176,25 @@ public:
     static sail_status_t from_mime_type(const std::string &mime_type, codec_info *scodec_info);
     static sail_status_t from_mime_type(const char *mime_type, codec_info *scodec_info);
 
+    /*
+     * Finds a codec info object by the specified codec name. The comparison
+     * algorithm is case-insensitive. For example: "jpeg".
+     *
+     * Typical usage: codec_info::from_name()            ->
+     *                image_reader::start_reading_file() ->
+     *                image_reader::read_next_frame()    ->
+     *                image_reader::stop_reading().
+     *
+     * Or:            codec_info::from_name()         ->
+     *                image_writer::start_writing()   ->
+     *                image_writer::read_next_frame() ->
+     *                image_writer::stop_writing().
+     *
+     * Returns SAIL_OK on success.
+     */
+    static sail_status_t from_name(const std::string &name, codec_info *scodec_info);
+    static sail_status_t from_name(const char *name, codec_info *scodec_info);
+
     /*
      * Returns a list of found codec info objects. Use it to determine the list of possible
      * image formats, file extensions, and mime types that could be hypothetically read or written by SAIL.
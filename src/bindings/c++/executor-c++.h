@@ -0,0 +1,47 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_EXECUTOR_CPP_H
+#define SAIL_EXECUTOR_CPP_H
+
+#include <functional>
+
+namespace sail
+{
+
+/*
+ * Runs tasks of the asynchronous functions like image_reader::read_async(). An executor must run
+ * every submitted task exactly once in any thread.
+ *
+ * When no executor is specified, tasks run in the thread pool shared by the asynchronous functions.
+ * Pool threads are attached to the shared SAIL context, so they don't enumerate codecs again.
+ * Threads of custom executors use their own SAIL contexts unless they're attached to the shared context
+ * with context::init(SAIL_FLAG_SHARED_CONTEXT). They should call context::finish() before exiting.
+ */
+typedef std::function<void(std::function<void()>)> executor;
+
+}
+
+#endif
@@ -0,0 +1,157 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "sail-common.h"
+#include "sail.h"
+#include "sail-c++.h"
+
+namespace sail
+{
+
+class SAIL_HIDDEN frames::pimpl
+{
+public:
+    pimpl()
+        : status(SAIL_OK)
+        , started(false)
+        , finished(false)
+    {
+    }
+
+    image_reader reader;
+    image frame;
+    sail_status_t status;
+
+    /* The first frame was read. */
+    bool started;
+
+    /* No frames are left or an error occurred. */
+    bool finished;
+};
+
+frames::iterator::iterator()
+    : m_range(nullptr)
+{
+}
+
+frames::iterator::iterator(frames *range)
+    : m_range(range)
+{
+}
+
+frames::iterator::reference frames::iterator::operator*() const
+{
+    return m_range->d->frame;
+}
+
+frames::iterator::pointer frames::iterator::operator->() const
+{
+    return &m_range->d->frame;
+}
+
+frames::iterator& frames::iterator::operator++()
+{
+    if (m_range != nullptr && !m_range->read_next()) {
+        m_range = nullptr;
+    }
+
+    return *this;
+}
+
+bool frames::iterator::operator==(const iterator &other) const
+{
+    return m_range == other.m_range;
+}
+
+bool frames::iterator::operator!=(const iterator &other) const
+{
+    return !(*this == other);
+}
+
+frames::frames(const std::string &path)
+    : d(new pimpl)
+{
+    d->status = d->reader.start_reading(path);
+    d->finished = d->status != SAIL_OK;
+}
+
+frames::frames(const std::string &path, const read_options &sread_options)
+    : d(new pimpl)
+{
+    d->status = d->reader.start_reading(path, sread_options);
+    d->finished = d->status != SAIL_OK;
+}
+
+frames::~frames()
+{
+    /* The reader stops reading. */
+    delete d;
+}
+
+frames::iterator frames::begin()
+{
+    if (!d->started) {
+        d->started = true;
+        read_next();
+    }
+
+    return d->finished ? end() : iterator(this);
+}
+
+frames::iterator frames::end()
+{
+    return iterator();
+}
+
+sail_status_t frames::status() const
+{
+    return d->status;
+}
+
+bool frames::read_next()
+{
+    if (d->finished) {
+        return false;
+    }
+
+    /* Release the previous frame before reading the next one. */
+    d->frame = image();
+
+    const sail_status_t status = d->reader.read_next_frame(&d->frame);
+
+    if (status != SAIL_OK) {
+        d->finished = true;
+        d->status   = (status == SAIL_ERROR_NO_MORE_FRAMES) ? SAIL_OK : status;
+
+        /* Stop reading early to release the codec resources. */
+        SAIL_TRY_OR_SUPPRESS(d->reader.stop_reading());
+
+        return false;
+    }
+
+    return true;
+}
+
+}
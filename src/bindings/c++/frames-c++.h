@@ -0,0 +1,143 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_FRAMES_CPP_H
+#define SAIL_FRAMES_CPP_H
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+namespace sail
+{
+
+class image;
+class read_options;
+
+/*
+ * A lazy range of the frames of an image file. Frames are read one by one with image_reader::read_next_frame()
+ * while iterating, so breaking out of the loop early doesn't read the rest of the frames. Reading
+ * is stopped with image_reader::stop_reading() when the range is destroyed.
+ *
+ * For example:
+ *
+ *     for (const sail::image &frame : sail::frames("animation.gif")) {
+ *         ...
+ *     }
+ *
+ * The range could be iterated only once. Iteration stops at the last frame or on the first error.
+ * Use status() to distinguish them.
+ */
+class SAIL_EXPORT frames
+{
+public:
+    /*
+     * An input iterator over the frames. Dereferencing returns the current frame.
+     */
+    class SAIL_EXPORT iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef image value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const image* pointer;
+        typedef const image& reference;
+
+        iterator();
+
+        reference operator*() const;
+        pointer operator->() const;
+
+        /*
+         * Reads the next frame. The iterator becomes equal to end() when no more frames are left
+         * or an error occurs.
+         */
+        iterator& operator++();
+
+        bool operator==(const iterator &other) const;
+        bool operator!=(const iterator &other) const;
+
+    private:
+        friend class frames;
+
+        explicit iterator(frames *range);
+
+        frames *m_range;
+    };
+
+    /*
+     * Starts reading the specified image file. Codec-specific default read options are used.
+     */
+    explicit frames(const std::string &path);
+
+    /*
+     * Starts reading the specified image file with the specified read options.
+     */
+    frames(const std::string &path, const read_options &sread_options);
+
+    /*
+     * Stops reading. The rest of the frames are not read.
+     */
+    ~frames();
+
+    /*
+     * Reads the first frame and returns an iterator pointing to it, or end() if there are no frames
+     * or an error occurred. Subsequent calls return an iterator to the current frame.
+     */
+    iterator begin();
+
+    /*
+     * Returns the past-the-end iterator.
+     */
+    iterator end();
+
+    /*
+     * Returns SAIL_OK if no errors occurred so far. SAIL_ERROR_NO_MORE_FRAMES is not an error,
+     * so SAIL_OK is returned when all the frames were read.
+     */
+    sail_status_t status() const;
+
+private:
+    frames(const frames &) = delete;
+    frames& operator=(const frames &) = delete;
+
+    /* Reads the next frame. Returns false if no frames are left or an error occurred. */
+    bool read_next();
+
+    class pimpl;
+    pimpl * const d;
+};
+
+}
+
+#endif
@@ -23,6 +23,7 @@
     SOFTWARE.
 */
 
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 
@@ -46,14 +47,25 @@ public:
         , properties(0)
         , pixels(nullptr)
         , pixels_size(0)
+        , pixels_pool_size(0)
         , shallow_pixels(false)
     {}
 
     ~pimpl()
+    {
+        free_pixels();
+    }
+
+    void free_pixels()
     {
         if (!shallow_pixels) {
-            sail_free(pixels);
+            sail_release_pooled_pixels(pixels, pixels_pool_size);
         }
+
+        pixels           = nullptr;
+        pixels_size      = 0;
+        pixels_pool_size = 0;
+        shallow_pixels   = false;
     }
 
     unsigned width;
@@ -69,7 +81,8 @@ public:
     int properties;
     sail::source_image source_image;
     void *pixels;
-    unsigned pixels_size;
+    size_t pixels_size;
+    size_t pixels_pool_size;
     bool shallow_pixels;
 };
 
@@ -198,7 +211,7 @@ const void* image::pixels() const
     return d->pixels;
 }
 
-unsigned image::pixels_size() const
+size_t image::pixels_size() const
 {
     return d->pixels_size;
 }
@@ -261,21 +274,22 @@ image& image::with_meta_data(const std::vector<sail::meta_data> &meta_data)
 
 image& image::with_pixels(const void *pixels)
 {
-    unsigned bytes_per_image;
+    uint64_t bytes_per_image;
     SAIL_TRY_OR_EXECUTE(image::bytes_per_image(*this, &bytes_per_image),
                         /* on error */ return *this);
 
-    with_pixels(pixels, bytes_per_image);
+    if (bytes_per_image > SIZE_MAX) {
+        SAIL_LOG_ERROR("The image of %llu bytes doesn't fit into the address space", static_cast<unsigned long long>(bytes_per_image));
+        return *this;
+    }
+
+    with_pixels(pixels, static_cast<size_t>(bytes_per_image));
     return *this;
 }
 
-image& image::with_pixels(const void *pixels, unsigned pixels_size)
+image& image::with_pixels(const void *pixels, size_t pixels_size)
 {
-    sail_free(d->pixels);
-
-    d->pixels         = nullptr;
-    d->pixels_size    = 0;
-    d->shallow_pixels = false;
+    d->free_pixels();
 
     if (pixels == nullptr || pixels_size == 0) {
         return *this;
@@ -293,22 +307,22 @@ image& image::with_pixels(const void *pixels, unsigned pixels_size)
 
 image& image::with_shallow_pixels(void *pixels)
 {
-    unsigned bytes_per_image;
+    uint64_t bytes_per_image;
     SAIL_TRY_OR_EXECUTE(image::bytes_per_image(*this, &bytes_per_image),
                         /* on error */ return *this);
 
-    with_shallow_pixels(pixels, bytes_per_image);
+    if (bytes_per_image > SIZE_MAX) {
+        SAIL_LOG_ERROR("The image of %llu bytes doesn't fit into the address space", static_cast<unsigned long long>(bytes_per_image));
+        return *this;
+    }
+
+    with_shallow_pixels(pixels, static_cast<size_t>(bytes_per_image));
     return *this;
 }
 
-image& image::with_shallow_pixels(void *pixels, unsigned pixels_size)
+image& image::with_shallow_pixels(void *pixels, size_t pixels_size)
 {
-    if(!d->shallow_pixels)
-        sail_free(d->pixels);
-
-    d->pixels         = nullptr;
-    d->pixels_size    = 0;
-    d->shallow_pixels = false;
+    d->free_pixels();
 
     if (pixels == nullptr) {
         SAIL_LOG_ERROR("Not assigning invalid pixels. pixels pointer: %p", pixels);
@@ -360,6 +374,21 @@ sail_status_t image::bytes_per_image(const image &simage, unsigned *result)
     return SAIL_OK;
 }
 
+sail_status_t image::bytes_per_image(const image &simage, uint64_t *result)
+{
+    SAIL_CHECK_PTR(result);
+
+    sail_image sail_image;
+
+    sail_image.width        = simage.width();
+    sail_image.height       = simage.height();
+    sail_image.pixel_format = simage.pixel_format();
+
+    SAIL_TRY(sail_bytes_per_image64(&sail_image, result));
+
+    return SAIL_OK;
+}
+
 sail_status_t image::pixel_format_to_string(SailPixelFormat pixel_format, const char **result)
 {
     SAIL_TRY(sail_pixel_format_to_string(pixel_format, result));
@@ -441,21 +470,18 @@ sail_status_t image::transfer_pixels_pointer(const sail_image *sail_image)
 {
     SAIL_CHECK_IMAGE_PTR(sail_image);
 
-    sail_free(d->pixels);
-
-    d->pixels         = nullptr;
-    d->pixels_size    = 0;
-    d->shallow_pixels = false;
+    d->free_pixels();
 
     if (sail_image->pixels == nullptr) {
         return SAIL_OK;
     }
 
-    unsigned bytes_per_image;
-    SAIL_TRY(sail_bytes_per_image(sail_image, &bytes_per_image));
+    uint64_t bytes_per_image;
+    SAIL_TRY(sail_bytes_per_image64(sail_image, &bytes_per_image));
 
-    d->pixels      = sail_image->pixels;
-    d->pixels_size = bytes_per_image;
+    d->pixels           = sail_image->pixels;
+    d->pixels_size      = static_cast<size_t>(bytes_per_image);
+    d->pixels_pool_size = sail_image->pixels_pool_size;
 
     return SAIL_OK;
 }
@@ -26,6 +26,8 @@
 #ifndef SAIL_IMAGE_CPP_H
 #define SAIL_IMAGE_CPP_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -205,7 +207,7 @@ public:
     /*
      * Returns the size of deep copied pixel data in bytes.
      */
-    unsigned pixels_size() const;
+    size_t pixels_size() const;
 
     /*
      * Sets a new width.
@@ -264,7 +266,7 @@ public:
      * Deep copies the specified pixel data and stores its size. The data can be accessed later with pixels().
      * The deep copied data is deleted upon image destruction.
      */
-    image& with_pixels(const void *pixels, unsigned pixels_size);
+    image& with_pixels(const void *pixels, size_t pixels_size);
 
     /*
      * Stores the pointer to the external pixel data. Frees the previously stored deep-copied pixel data.
@@ -281,7 +283,7 @@ public:
      * deep-copied pixel data. The pixel data must remain valid until the image exists. The shallow data
      * is not deleted upon image destruction.
      */
-    image& with_shallow_pixels(void *pixels, unsigned pixels_size);
+    image& with_shallow_pixels(void *pixels, size_t pixels_size);
 
     /*
      * Sets a new ICC profile.
@@ -322,9 +324,17 @@ public:
      * It is effectively bytes per line * image height.
      *
      * Returns SAIL_OK on success.
+     * Returns SAIL_ERROR_INCORRECT_IMAGE_DIMENSIONS if the result doesn't fit into unsigned.
      */
     static sail_status_t bytes_per_image(const image &simage, unsigned *result);
 
+    /*
+     * An interface to sail_bytes_per_image64(). Images bigger than 4 GB fit into the result.
+     *
+     * Returns SAIL_OK on success.
+     */
+    static sail_status_t bytes_per_image(const image &simage, uint64_t *result);
+
     /*
      * Assigns a non-NULL string representation of the specified pixel format.
      * The assigned string MUST NOT be destroyed. For example: "RGB".
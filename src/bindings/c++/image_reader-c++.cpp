@@ -23,13 +23,18 @@
     SOFTWARE.
 */
 
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <utility>
 
 #include "sail-common.h"
 #include "sail.h"
 #include "sail-c++.h"
 
+#include "thread_pool-c++.h"
+
 namespace sail
 {
 
@@ -38,7 +43,7 @@ class SAIL_HIDDEN image_reader::pimpl
 public:
     pimpl()
         : state(nullptr)
-        , sail_io{0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr}
+        , sail_io{0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 0, nullptr, nullptr}
     {
     }
 
@@ -134,6 +139,41 @@ sail_status_t image_reader::probe(const sail::io &io, image *simage, codec_info
     return SAIL_OK;
 }
 
+sail_status_t image_reader::probe(const std::vector<std::string> &paths, std::vector<probe_result> *results, unsigned threads)
+{
+    SAIL_CHECK_PTR(results);
+
+    std::vector<const char *> sail_paths;
+    sail_paths.reserve(paths.size());
+
+    for (const std::string &path : paths) {
+        sail_paths.push_back(path.c_str());
+    }
+
+    std::vector<sail_probe_result> sail_results(paths.size());
+
+    SAIL_TRY(sail_probe_files(sail_paths.data(), sail_paths.size(), sail_results.data(), threads));
+
+    results->clear();
+    results->reserve(sail_results.size());
+
+    for (const sail_probe_result &sail_result : sail_results) {
+        probe_result result;
+        result.status = sail_result.status;
+
+        if (sail_result.status == SAIL_OK) {
+            result.simage = image(sail_result.image);
+            sail_destroy_image(sail_result.image);
+
+            result.scodec_info = codec_info(sail_result.codec_info);
+        }
+
+        results->push_back(std::move(result));
+    }
+
+    return SAIL_OK;
+}
+
 sail_status_t image_reader::read(const std::string &path, image *simage)
 {
     SAIL_TRY(read(path.c_str(), simage));
@@ -175,6 +215,83 @@ sail_status_t image_reader::read(const void *buffer, size_t buffer_length, image
     return SAIL_OK;
 }
 
+sail_status_t image_reader::read(const std::vector<std::string> &paths, const read_options &sread_options,
+                                 size_t max_bytes_in_flight, unsigned threads,
+                                 const std::function<void(size_t, sail_status_t, image)> &callback)
+{
+    std::vector<const char *> sail_paths;
+    sail_paths.reserve(paths.size());
+
+    for (const std::string &path : paths) {
+        sail_paths.push_back(path.c_str());
+    }
+
+    sail_read_options sail_read_options;
+    SAIL_TRY(sread_options.to_sail_read_options(&sail_read_options));
+
+    auto sail_callback = [](size_t index, sail_status_t status, sail_image *sail_image, void *user_data) {
+        image simage;
+
+        if (sail_image != nullptr) {
+            simage = image(sail_image);
+            sail_image->pixels = NULL;
+            sail_destroy_image(sail_image);
+        }
+
+        (*static_cast<const std::function<void(size_t, sail_status_t, image)> *>(user_data))(index, status, std::move(simage));
+    };
+
+    SAIL_TRY(sail_read_files_with_options(sail_paths.data(),
+                                          sail_paths.size(),
+                                          &sail_read_options,
+                                          max_bytes_in_flight,
+                                          threads,
+                                          sail_callback,
+                                          const_cast<std::function<void(size_t, sail_status_t, image)> *>(&callback)));
+
+    return SAIL_OK;
+}
+
+std::future<image> image_reader::read_async(const std::string &path, const executor &sexecutor)
+{
+    /* std::function must be copyable. */
+    std::shared_ptr<std::promise<image>> promise = std::make_shared<std::promise<image>>();
+
+    thread_pool::dispatch(sexecutor, [path, promise] {
+        image simage;
+        image_reader reader;
+
+        /* The image stays invalid on error. */
+        SAIL_TRY_OR_SUPPRESS(reader.read(path, &simage));
+
+        promise->set_value(std::move(simage));
+    });
+
+    return promise->get_future();
+}
+
+std::future<image> image_reader::read_async(const std::string &path, const read_options &sread_options,
+                                            const executor &sexecutor)
+{
+    std::shared_ptr<std::promise<image>> promise = std::make_shared<std::promise<image>>();
+
+    thread_pool::dispatch(sexecutor, [path, sread_options, promise] {
+        image simage;
+        image_reader reader;
+
+        /* The image stays invalid on error. */
+        if (reader.start_reading(path, sread_options) == SAIL_OK) {
+            SAIL_TRY_OR_SUPPRESS(reader.read_next_frame(&simage));
+        }
+
+        SAIL_TRY_OR_SUPPRESS(reader.stop_reading());
+
+        promise->set_value(std::move(simage));
+    });
+
+    return promise->get_future();
+}
+
 sail_status_t image_reader::start_reading(const std::string &path)
 {
     SAIL_TRY(start_reading(path.c_str()));
@@ -207,6 +324,20 @@ sail_status_t image_reader::start_reading(const char *path, const codec_info &sc
     return SAIL_OK;
 }
 
+sail_status_t image_reader::start_reading(const std::string &path, const read_options &sread_options)
+{
+    SAIL_TRY(start_reading(path.c_str(), sread_options));
+
+    return SAIL_OK;
+}
+
+sail_status_t image_reader::start_reading(const char *path, const read_options &sread_options)
+{
+    SAIL_TRY(start_reading(path, codec_info(), sread_options));
+
+    return SAIL_OK;
+}
+
 sail_status_t image_reader::start_reading(const std::string &path, const codec_info &scodec_info, const read_options &sread_options)
 {
     SAIL_TRY(start_reading(path.c_str(), scodec_info, sread_options));
@@ -257,6 +388,63 @@ sail_status_t image_reader::start_reading(const void *buffer, size_t buffer_leng
     return SAIL_OK;
 }
 
+sail_status_t image_reader::start_reading(const std::vector<sail_mem_segment> &segments)
+{
+    SAIL_TRY(sail_start_reading_mem_segments(segments.data(),
+                                             segments.size(),
+                                             NULL,
+                                             &d->state));
+
+    return SAIL_OK;
+}
+
+sail_status_t image_reader::start_reading(const std::vector<sail_mem_segment> &segments, const read_options &sread_options)
+{
+    sail_read_options sail_read_options;
+    SAIL_TRY(sread_options.to_sail_read_options(&sail_read_options));
+
+    SAIL_TRY(sail_start_reading_mem_segments_with_options(segments.data(),
+                                                          segments.size(),
+                                                          NULL,
+                                                          &sail_read_options,
+                                                          &d->state));
+
+    return SAIL_OK;
+}
+
+sail_status_t image_reader::start_reading(const io &sio)
+{
+    SAIL_TRY(sio.to_sail_io(&d->sail_io));
+
+    sail_io *sail_io = &d->sail_io;
+    SAIL_CHECK_IO(sail_io);
+
+    SAIL_TRY(sail_start_reading_io_with_options(&d->sail_io,
+                                                NULL,
+                                                NULL,
+                                                &d->state));
+
+    return SAIL_OK;
+}
+
+sail_status_t image_reader::start_reading(const io &sio, const read_options &sread_options)
+{
+    SAIL_TRY(sio.to_sail_io(&d->sail_io));
+
+    sail_io *sail_io = &d->sail_io;
+    SAIL_CHECK_IO(sail_io);
+
+    sail_read_options sail_read_options;
+    SAIL_TRY(sread_options.to_sail_read_options(&sail_read_options));
+
+    SAIL_TRY(sail_start_reading_io_with_options(&d->sail_io,
+                                                NULL,
+                                                &sail_read_options,
+                                                &d->state));
+
+    return SAIL_OK;
+}
+
 sail_status_t image_reader::start_reading(const io &sio, const codec_info &scodec_info)
 {
     SAIL_TRY(sio.to_sail_io(&d->sail_io));
@@ -297,8 +485,8 @@ sail_status_t image_reader::read_next_frame(image *simage)
     sail_image *sail_image;
     SAIL_TRY(sail_read_next_frame(d->state, &sail_image));
 
-    unsigned bytes_per_image;
-    SAIL_TRY_OR_CLEANUP(sail_bytes_per_image(sail_image, &bytes_per_image),
+    uint64_t bytes_per_image;
+    SAIL_TRY_OR_CLEANUP(sail_bytes_per_image64(sail_image, &bytes_per_image),
                         /* cleanup */ sail_destroy_image(sail_image));
 
     *simage = image(sail_image);
@@ -308,12 +496,56 @@ sail_status_t image_reader::read_next_frame(image *simage)
     return SAIL_OK;
 }
 
+sail_status_t image_reader::read_next_frame(void *buffer, size_t buffer_size, image *simage)
+{
+    SAIL_TRY(read_next_frame(buffer, buffer_size, 0, simage));
+
+    return SAIL_OK;
+}
+
+sail_status_t image_reader::read_next_frame(void *buffer, size_t buffer_size, unsigned bytes_per_line, image *simage)
+{
+    SAIL_CHECK_IMAGE_PTR(simage);
+
+    sail_image *sail_image;
+    SAIL_TRY(sail_read_next_frame_to_buffer(d->state, buffer, buffer_size, bytes_per_line, &sail_image));
+
+    *simage = image(sail_image);
+    simage->with_shallow_pixels(buffer, (size_t)sail_image->bytes_per_line * sail_image->height);
+    sail_destroy_image(sail_image);
+
+    return SAIL_OK;
+}
+
+sail_status_t image_reader::read_next_frame_header(image *simage)
+{
+    SAIL_CHECK_IMAGE_PTR(simage);
+
+    sail_image *sail_image;
+    SAIL_TRY(sail_read_next_frame_header(d->state, &sail_image));
+
+    *simage = image(sail_image);
+    sail_destroy_image(sail_image);
+
+    return SAIL_OK;
+}
+
+sail_status_t image_reader::read_next_rows(void *rows, unsigned count)
+{
+    SAIL_TRY(sail_read_next_rows(d->state, rows, count));
+
+    return SAIL_OK;
+}
+
 sail_status_t image_reader::stop_reading()
 {
-    SAIL_TRY(sail_stop_reading(d->state));
+    const sail_status_t status = sail_stop_reading(d->state);
 
+    /* The state is destroyed even on error. */
     d->state = nullptr;
 
+    SAIL_TRY(status);
+
     return SAIL_OK;
 }
 
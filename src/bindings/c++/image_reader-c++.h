@@ -27,24 +27,45 @@
 #define SAIL_IMAGE_READER_CPP_H
 
 #include <cstddef>
+#include <functional>
+#include <future>
 #include <string>
+#include <vector>
 
 #ifdef SAIL_BUILD
     #include "error.h"
     #include "export.h"
+
+    #include "codec_info-c++.h"
+    #include "executor-c++.h"
+    #include "image-c++.h"
 #else
     #include <sail-common/error.h>
     #include <sail-common/export.h>
+
+    #include <sail-c++/codec_info-c++.h>
+    #include <sail-c++/executor-c++.h>
+    #include <sail-c++/image-c++.h>
 #endif
 
+struct sail_mem_segment;
+
 namespace sail
 {
 
-class image;
 class io;
-class codec_info;
 class read_options;
 
+/*
+ * Result of probing a single file with image_reader::probe(). See sail_probe_result for more.
+ */
+struct probe_result
+{
+    sail_status_t status;
+    image simage;
+    codec_info scodec_info;
+};
+
 /*
  * A C++ interface to the SAIL image reading functions.
  */
@@ -70,6 +91,12 @@ public:
      */
     sail_status_t probe(const sail::io &io, image *simage, codec_info *scodec_info = nullptr);
 
+    /*
+     * An interface to sail_probe_files(). Fills results with a result per path in the same order.
+     * See sail_probe_files() for more.
+     */
+    sail_status_t probe(const std::vector<std::string> &paths, std::vector<probe_result> *results, unsigned threads = 0);
+
     /*
      * An interface to sail_read_file(). See sail_read_file() for more.
      */
@@ -81,6 +108,29 @@ public:
      */
     sail_status_t read(const void *buffer, size_t buffer_length, image *simage);
 
+    /*
+     * An interface to sail_read_files_with_options(). The callback receives the index of the path,
+     * the status, and the read image which is invalid on error. See sail_read_files_with_options() for more.
+     */
+    sail_status_t read(const std::vector<std::string> &paths, const read_options &sread_options,
+                       size_t max_bytes_in_flight, unsigned threads,
+                       const std::function<void(size_t, sail_status_t, image)> &callback);
+
+    /*
+     * Reads the first frame of the specified image file in background like read() does. The read image
+     * is invalid on error. Runs in the shared thread pool or with the specified executor. The reader
+     * object could be destroyed before the returned future is ready. See executor for more.
+     */
+    std::future<image> read_async(const std::string &path, const executor &sexecutor = executor());
+
+    /*
+     * Reads the first frame of the specified image file with the specified read options in background.
+     * The read image is invalid on error. Runs in the shared thread pool or with the specified executor.
+     * The reader object could be destroyed before the returned future is ready. See executor for more.
+     */
+    std::future<image> read_async(const std::string &path, const read_options &sread_options,
+                                  const executor &sexecutor = executor());
+
     /*
      * An interface to sail_start_reading_file(). See sail_start_reading() for more.
      */
@@ -111,6 +161,20 @@ public:
     sail_status_t start_reading(const void *buffer, size_t buffer_length, const codec_info &scodec_info);
     sail_status_t start_reading(const void *buffer, size_t buffer_length, const codec_info &scodec_info, const read_options &sread_options);
 
+    /*
+     * An interface to sail_start_reading_mem_segments() that detects the image format by its magic number.
+     * See sail_start_reading_mem_segments() for more. The segment data must stay valid until stop_reading().
+     */
+    sail_status_t start_reading(const std::vector<sail_mem_segment> &segments);
+    sail_status_t start_reading(const std::vector<sail_mem_segment> &segments, const read_options &sread_options);
+
+    /*
+     * An interface to sail_start_reading_io() that detects the image format by its magic number.
+     * See sail_start_reading_io() for more.
+     */
+    sail_status_t start_reading(const io &sio);
+    sail_status_t start_reading(const io &sio, const read_options &sread_options);
+
     /*
      * An interface to sail_start_reading_io(). See sail_start_reading_io() for more.
      */
@@ -122,6 +186,26 @@ public:
      */
     sail_status_t read_next_frame(image *simage);
 
+    /*
+     * An interface to sail_read_next_frame_to_buffer(). See sail_read_next_frame_to_buffer() for more.
+     *
+     * The output image shallow-references the buffer. The buffer must outlive the image.
+     */
+    sail_status_t read_next_frame(void *buffer, size_t buffer_size, image *simage);
+    sail_status_t read_next_frame(void *buffer, size_t buffer_size, unsigned bytes_per_line, image *simage);
+
+    /*
+     * An interface to sail_read_next_frame_header(). See sail_read_next_frame_header() for more.
+     *
+     * The output image has no pixels. Use read_next_rows() to decode them.
+     */
+    sail_status_t read_next_frame_header(image *simage);
+
+    /*
+     * An interface to sail_read_next_rows(). See sail_read_next_rows() for more.
+     */
+    sail_status_t read_next_rows(void *rows, unsigned count);
+
     /*
      * An interface to sail_stop_reading(). See sail_stop_reading() for more.
      */
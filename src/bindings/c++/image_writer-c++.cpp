@@ -25,11 +25,14 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <memory>
 
 #include "sail-common.h"
 #include "sail.h"
 #include "sail-c++.h"
 
+#include "thread_pool-c++.h"
+
 namespace sail
 {
 
@@ -38,7 +41,7 @@ class SAIL_HIDDEN image_writer::pimpl
 public:
     pimpl()
         : state(nullptr)
-        , sail_io{0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr}
+        , sail_io{0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 0, nullptr, nullptr}
     {
     }
 
@@ -117,6 +120,78 @@ sail_status_t image_writer::write(void *buffer, size_t buffer_length, const imag
     return SAIL_OK;
 }
 
+sail_status_t image_writer::write(const codec_info &scodec_info, const image &simage, std::vector<uint8_t> *buffer)
+{
+    write_options swrite_options;
+    SAIL_TRY(scodec_info.write_features().to_write_options(&swrite_options));
+
+    SAIL_TRY(write(scodec_info, swrite_options, simage, buffer));
+
+    return SAIL_OK;
+}
+
+sail_status_t image_writer::write(const codec_info &scodec_info, const write_options &swrite_options, const image &simage, std::vector<uint8_t> *buffer)
+{
+    SAIL_CHECK_BUFFER_PTR(buffer);
+
+    sail_write_options sail_write_options;
+    SAIL_TRY(swrite_options.to_sail_write_options(&sail_write_options));
+
+    sail_image *sail_image;
+    SAIL_TRY(sail_alloc_image(&sail_image));
+
+    SAIL_TRY_OR_CLEANUP(simage.to_sail_image(sail_image),
+                        /* cleanup */ sail_image->pixels = NULL,
+                                      sail_destroy_image(sail_image));
+
+    /* Assigned by the I/O object when writing stops. */
+    void *data = nullptr;
+    size_t data_length = 0;
+    void *state = nullptr;
+
+    SAIL_TRY_OR_CLEANUP(sail_start_writing_growing_mem_with_options(&data,
+                                                                    &data_length,
+                                                                    scodec_info.sail_codec_info_c(),
+                                                                    &sail_write_options,
+                                                                    &state),
+                        /* cleanup */ sail_stop_writing(state),
+                                      sail_free(data),
+                                      sail_image->pixels = NULL,
+                                      sail_destroy_image(sail_image));
+
+    SAIL_TRY_OR_CLEANUP(sail_write_next_frame(state, sail_image),
+                        /* cleanup */ sail_stop_writing(state),
+                                      sail_free(data),
+                                      sail_image->pixels = NULL,
+                                      sail_destroy_image(sail_image));
+
+    sail_image->pixels = NULL;
+    sail_destroy_image(sail_image);
+
+    SAIL_TRY_OR_CLEANUP(sail_stop_writing(state),
+                        /* cleanup */ sail_free(data));
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    buffer->assign(bytes, bytes + data_length);
+
+    sail_free(data);
+
+    return SAIL_OK;
+}
+
+std::future<sail_status_t> image_writer::write_async(const std::string &path, const image &simage, const executor &sexecutor)
+{
+    /* std::function must be copyable. */
+    std::shared_ptr<std::promise<sail_status_t>> promise = std::make_shared<std::promise<sail_status_t>>();
+
+    thread_pool::dispatch(sexecutor, [path, simage, promise] {
+        image_writer writer;
+        promise->set_value(writer.write(path, simage));
+    });
+
+    return promise->get_future();
+}
+
 sail_status_t image_writer::start_writing(const std::string &path)
 {
     SAIL_TRY(start_writing(path.c_str()));
@@ -27,14 +27,21 @@
 #define SAIL_IMAGE_WRITER_CPP_H
 
 #include <cstddef>
+#include <cstdint>
+#include <future>
 #include <string>
+#include <vector>
 
 #ifdef SAIL_BUILD
     #include "error.h"
     #include "export.h"
+
+    #include "executor-c++.h"
 #else
     #include <sail-common/error.h>
     #include <sail-common/export.h>
+
+    #include <sail-c++/executor-c++.h>
 #endif
 
 namespace sail
@@ -66,6 +73,23 @@ public:
     sail_status_t write(void *buffer, size_t buffer_length, const image &simage);
     sail_status_t write(void *buffer, size_t buffer_length, const image &simage, size_t *written);
 
+    /*
+     * An interface to sail_start_writing_growing_mem(). Writes the image into a memory buffer
+     * growing on demand and assigns the written data to the vector.
+     * See sail_start_writing_growing_mem() for more.
+     */
+    sail_status_t write(const codec_info &scodec_info, const image &simage, std::vector<uint8_t> *buffer);
+    sail_status_t write(const codec_info &scodec_info, const write_options &swrite_options, const image &simage, std::vector<uint8_t> *buffer);
+
+    /*
+     * Writes the image into the specified file in background like write() does. The image is copied,
+     * so it could be modified or destroyed right away. Runs in the shared thread pool or with
+     * the specified executor. The writer object could be destroyed before the returned future is ready.
+     * See executor for more.
+     */
+    std::future<sail_status_t> write_async(const std::string &path, const image &simage,
+                                           const executor &sexecutor = executor());
+
     /*
      * An interface to sail_start_writing(). See sail_start_writing() for more.
      */
@@ -48,15 +48,20 @@ public:
 
 void io::pimpl::empty_sail_io()
 {
-    sail_io.id     = 0;
-    sail_io.stream = nullptr;
-    sail_io.read   = nullptr;
-    sail_io.seek   = nullptr;
-    sail_io.tell   = nullptr;
-    sail_io.write  = nullptr;
-    sail_io.flush  = nullptr;
-    sail_io.close  = nullptr;
-    sail_io.eof    = nullptr;
+    sail_io.id       = 0;
+    sail_io.stream   = nullptr;
+    sail_io.read     = nullptr;
+    sail_io.seek     = nullptr;
+    sail_io.tell     = nullptr;
+    sail_io.write    = nullptr;
+    sail_io.flush    = nullptr;
+    sail_io.close    = nullptr;
+    sail_io.eof      = nullptr;
+    sail_io.borrow   = nullptr;
+    sail_io.read_at  = nullptr;
+    sail_io.features = 0;
+    sail_io.seek64   = nullptr;
+    sail_io.tell64   = nullptr;
 }
 
 io::io()
@@ -161,6 +166,36 @@ io& io::with_eof(sail_io_eof_t eof)
     return *this;
 }
 
+io& io::with_borrow(sail_io_borrow_t borrow)
+{
+    d->sail_io.borrow = borrow;
+    return *this;
+}
+
+io& io::with_read_at(sail_io_read_at_t read_at)
+{
+    d->sail_io.read_at = read_at;
+    return *this;
+}
+
+io& io::with_features(int features)
+{
+    d->sail_io.features = features;
+    return *this;
+}
+
+io& io::with_seek64(sail_io_seek64_t seek64)
+{
+    d->sail_io.seek64 = seek64;
+    return *this;
+}
+
+io& io::with_tell64(sail_io_tell64_t tell64)
+{
+    d->sail_io.tell64 = tell64;
+    return *this;
+}
+
 sail_status_t io::is_valid_private() const
 {
     sail_io *sail_io = &d->sail_io;
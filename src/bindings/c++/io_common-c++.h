@@ -67,6 +67,11 @@ public:
     io& with_flush(sail_io_flush_t flush);
     io& with_close(sail_io_close_t close);
     io& with_eof(sail_io_eof_t eof);
+    io& with_borrow(sail_io_borrow_t borrow);
+    io& with_read_at(sail_io_read_at_t read_at);
+    io& with_features(int features);
+    io& with_seek64(sail_io_seek64_t seek64);
+    io& with_tell64(sail_io_tell64_t tell64);
 
 private:
     sail_status_t is_valid_private() const;
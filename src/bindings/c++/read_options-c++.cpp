@@ -36,10 +36,22 @@ public:
     pimpl()
         : output_pixel_format(SAIL_PIXEL_FORMAT_UNKNOWN)
         , io_options(0)
+        , roi_x(0)
+        , roi_y(0)
+        , roi_width(0)
+        , roi_height(0)
+        , scale_denominator(1)
+        , target_size(0)
     {}
 
     SailPixelFormat output_pixel_format;
     int io_options;
+    unsigned roi_x;
+    unsigned roi_y;
+    unsigned roi_width;
+    unsigned roi_height;
+    unsigned scale_denominator;
+    unsigned target_size;
 };
 
 read_options::read_options()
@@ -56,7 +68,10 @@ read_options::read_options(const sail_read_options *ro)
     }
 
     with_output_pixel_format(ro->output_pixel_format)
-        .with_io_options(ro->io_options);
+        .with_io_options(ro->io_options)
+        .with_roi(ro->roi_x, ro->roi_y, ro->roi_width, ro->roi_height)
+        .with_scale_denominator(ro->scale_denominator)
+        .with_target_size(ro->target_size);
 }
 
 read_options::read_options(const read_options &ro)
@@ -68,7 +83,10 @@ read_options::read_options(const read_options &ro)
 read_options& read_options::operator=(const read_options &ro)
 {
     with_output_pixel_format(ro.output_pixel_format())
-        .with_io_options(ro.io_options());
+        .with_io_options(ro.io_options())
+        .with_roi(ro.roi_x(), ro.roi_y(), ro.roi_width(), ro.roi_height())
+        .with_scale_denominator(ro.scale_denominator())
+        .with_target_size(ro.target_size());
 
     return *this;
 }
@@ -103,6 +121,36 @@ int read_options::io_options() const
     return d->io_options;
 }
 
+unsigned read_options::roi_x() const
+{
+    return d->roi_x;
+}
+
+unsigned read_options::roi_y() const
+{
+    return d->roi_y;
+}
+
+unsigned read_options::roi_width() const
+{
+    return d->roi_width;
+}
+
+unsigned read_options::roi_height() const
+{
+    return d->roi_height;
+}
+
+unsigned read_options::scale_denominator() const
+{
+    return d->scale_denominator;
+}
+
+unsigned read_options::target_size() const
+{
+    return d->target_size;
+}
+
 read_options& read_options::with_output_pixel_format(SailPixelFormat output_pixel_format)
 {
     d->output_pixel_format = output_pixel_format;
@@ -115,12 +163,40 @@ read_options& read_options::with_io_options(int io_options)
     return *this;
 }
 
+read_options& read_options::with_roi(unsigned x, unsigned y, unsigned width, unsigned height)
+{
+    d->roi_x      = x;
+    d->roi_y      = y;
+    d->roi_width  = width;
+    d->roi_height = height;
+
+    return *this;
+}
+
+read_options& read_options::with_scale_denominator(unsigned scale_denominator)
+{
+    d->scale_denominator = scale_denominator;
+    return *this;
+}
+
+read_options& read_options::with_target_size(unsigned target_size)
+{
+    d->target_size = target_size;
+    return *this;
+}
+
 sail_status_t read_options::to_sail_read_options(sail_read_options *read_options) const
 {
     SAIL_CHECK_READ_OPTIONS_PTR(read_options);
 
     read_options->output_pixel_format = d->output_pixel_format;
     read_options->io_options          = d->io_options;
+    read_options->roi_x               = d->roi_x;
+    read_options->roi_y               = d->roi_y;
+    read_options->roi_width           = d->roi_width;
+    read_options->roi_height          = d->roi_height;
+    read_options->scale_denominator   = d->scale_denominator;
+    read_options->target_size         = d->target_size;
 
     return SAIL_OK;
 }
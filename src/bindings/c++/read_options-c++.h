@@ -60,9 +60,44 @@ public:
     SailPixelFormat output_pixel_format() const;
     int io_options() const;
 
+    /*
+     * Returns the region of interest to decode. Zero width or height means the whole frames are decoded.
+     */
+    unsigned roi_x() const;
+    unsigned roi_y() const;
+    unsigned roi_width() const;
+    unsigned roi_height() const;
+
+    /*
+     * Returns the denominator to reduce frames with: 1, 2, 4, or 8.
+     */
+    unsigned scale_denominator() const;
+
+    /*
+     * Returns the size to reduce frames to instead of using the scale denominator. 0 means not applied.
+     */
+    unsigned target_size() const;
+
     read_options& with_output_pixel_format(SailPixelFormat output_pixel_format);
     read_options& with_io_options(int io_options);
 
+    /*
+     * Sets the region of interest to decode. Frames are read with the region dimensions.
+     * Zero width or height decodes the whole frames.
+     */
+    read_options& with_roi(unsigned x, unsigned y, unsigned width, unsigned height);
+
+    /*
+     * Sets the denominator to reduce frames with. Possible values are 1 (no reduction), 2, 4, and 8.
+     */
+    read_options& with_scale_denominator(unsigned scale_denominator);
+
+    /*
+     * Reduces frames by the biggest possible denominator that keeps the longest frame side greater than
+     * or equal to the specified size. Useful to read previews quickly. 0 disables it.
+     */
+    read_options& with_target_size(unsigned target_size);
+
 private:
     /*
      * Makes a deep copy of the specified read options and stores the pointer for further use.
@@ -33,6 +33,8 @@
 
     #include "at_scope_exit-c++.h"
     #include "context-c++.h"
+    #include "executor-c++.h"
+    #include "frames-c++.h"
     #include "iccp-c++.h"
     #include "image-c++.h"
     #include "image_reader-c++.h"
@@ -54,6 +56,8 @@
 
     #include <sail-c++/at_scope_exit-c++.h>
     #include <sail-c++/context-c++.h>
+    #include <sail-c++/executor-c++.h>
+    #include <sail-c++/frames-c++.h>
     #include <sail-c++/iccp-c++.h>
     #include <sail-c++/image-c++.h>
     #include <sail-c++/image_reader-c++.h>
@@ -71,7 +71,8 @@ source_image& source_image::operator=(const source_image &si)
 {
     with_pixel_format(si.pixel_format())
         .with_properties(si.properties())
-        .with_compression(si.compression());
+        .with_compression(si.compression())
+        .with_frames(si.frames());
 
     return *this;
 }
@@ -116,6 +117,11 @@ SailCompression source_image::compression() const
     return d->source_image->compression;
 }
 
+unsigned source_image::frames() const
+{
+    return d->source_image->frames;
+}
+
 source_image::source_image(const sail_source_image *si)
     : source_image()
 {
@@ -126,7 +132,8 @@ source_image::source_image(const sail_source_image *si)
 
     with_pixel_format(si->pixel_format)
         .with_properties(si->properties)
-        .with_compression(si->compression);
+        .with_compression(si->compression)
+        .with_frames(si->frames);
 }
 
 sail_status_t source_image::to_sail_source_image(sail_source_image *si) const
@@ -136,6 +143,7 @@ sail_status_t source_image::to_sail_source_image(sail_source_image *si) const
     si->pixel_format = d->source_image->pixel_format;
     si->properties   = d->source_image->properties;
     si->compression  = d->source_image->compression;
+    si->frames       = d->source_image->frames;
 
     return SAIL_OK;
 }
@@ -158,5 +166,11 @@ source_image& source_image::with_compression(SailCompression compression)
     return *this;
 }
 
+source_image& source_image::with_frames(unsigned frames)
+{
+    d->source_image->frames = frames;
+    return *this;
+}
+
 
 }
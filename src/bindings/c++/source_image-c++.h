@@ -86,6 +86,15 @@ public:
      */
     SailCompression compression() const;
 
+    /*
+     * Returns the number of frames in the image file as stored in its headers like APNG or multi-page TIFF.
+     * It's only a hint as the actual number of frames could differ for broken files.
+     *
+     * READ:  Set by SAIL to the number of frames or to 0 if the image format doesn't store it in headers.
+     * WRITE: Ignored.
+     */
+    unsigned frames() const;
+
 private:
     /*
      * Makes a deep copy of the specified source image.
@@ -97,6 +106,7 @@ private:
     source_image& with_pixel_format(SailPixelFormat pixel_format);
     source_image& with_properties(int properties);
     source_image& with_compression(SailCompression compression);
+    source_image& with_frames(unsigned frames);
 
 private:
     class pimpl;
@@ -0,0 +1,119 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <utility>
+
+#include "sail-common.h"
+#include "sail.h"
+#include "sail-c++.h"
+
+#include "thread_pool-c++.h"
+
+namespace sail
+{
+
+thread_pool& thread_pool::shared()
+{
+    static thread_pool pool(std::thread::hardware_concurrency());
+
+    return pool;
+}
+
+thread_pool::thread_pool(unsigned threads)
+    : m_stop(false)
+{
+    /* hardware_concurrency() returns 0 if it's unknown. */
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    SAIL_LOG_DEBUG("Starting %u threads in the shared thread pool", threads);
+
+    for (unsigned i = 0; i < threads; i++) {
+        m_threads.emplace_back(&thread_pool::run, this);
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_cond.notify_all();
+
+    for (std::thread &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void thread_pool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+
+    m_cond.notify_one();
+}
+
+void thread_pool::dispatch(const executor &sexecutor, std::function<void()> task)
+{
+    if (sexecutor) {
+        sexecutor(std::move(task));
+    } else {
+        shared().submit(std::move(task));
+    }
+}
+
+void thread_pool::run()
+{
+    /* Pool threads share a single context. */
+    SAIL_TRY_OR_SUPPRESS(sail_init_with_flags(SAIL_FLAG_SHARED_CONTEXT));
+
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+
+            /* Run all the submitted tasks before stopping. */
+            if (m_tasks.empty()) {
+                break;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        task();
+    }
+
+    sail_finish();
+}
+
+}
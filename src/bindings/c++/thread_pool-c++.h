@@ -0,0 +1,92 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_THREAD_POOL_CPP_H
+#define SAIL_THREAD_POOL_CPP_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef SAIL_BUILD
+    #include "export.h"
+
+    #include "executor-c++.h"
+#else
+    #include <sail-common/export.h>
+
+    #include <sail-c++/executor-c++.h>
+#endif
+
+namespace sail
+{
+
+/*
+ * A fixed-size pool of threads running the tasks of the asynchronous functions. Not a part
+ * of the public API.
+ */
+class SAIL_HIDDEN thread_pool
+{
+public:
+    /*
+     * Returns the process-wide pool. The pool is started on the first call and stopped when
+     * the library is unloaded after running all the submitted tasks.
+     */
+    static thread_pool& shared();
+
+    ~thread_pool();
+
+    /*
+     * Queues the task to run in some pool thread.
+     */
+    void submit(std::function<void()> task);
+
+    /*
+     * Runs the task with the specified executor or in the shared pool if the executor is empty.
+     */
+    static void dispatch(const executor &sexecutor, std::function<void()> task);
+
+private:
+    explicit thread_pool(unsigned threads);
+
+    thread_pool(const thread_pool &) = delete;
+    thread_pool& operator=(const thread_pool &) = delete;
+
+    void run();
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_stop;
+
+    std::vector<std::thread> m_threads;
+};
+
+}
+
+#endif
@@ -0,0 +1,285 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+#include "allocator_private.h"
+
+/*
+ * Private functions.
+ */
+
+/* Alignment of every block returned by the arena. */
+#define ARENA_ALIGNMENT 16
+
+/* Default size of memory chunks. */
+#define ARENA_CHUNK_SIZE (64 * 1024)
+
+/* Aligned size of the block header storing the block size. */
+#define ARENA_BLOCK_HEADER_SIZE ARENA_ALIGNMENT
+
+struct arena_chunk {
+
+    struct arena_chunk *next;
+
+    /* The number of usable bytes and the number of bytes already handed out. */
+    size_t size;
+    size_t used;
+
+    /* The most recently allocated block. It could be resized in place. */
+    unsigned char *last_block;
+};
+
+struct sail_arena {
+
+    struct arena_chunk *chunks;
+    size_t chunk_size;
+};
+
+SAIL_THREAD_LOCAL static struct sail_arena *current_thread_arena = NULL;
+
+static size_t chunk_header_size(void) {
+
+    return (sizeof(struct arena_chunk) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+static unsigned char* chunk_data(struct arena_chunk *chunk) {
+
+    return (unsigned char *)chunk + chunk_header_size();
+}
+
+static size_t* block_size(void *ptr) {
+
+    return (size_t *)((unsigned char *)ptr - ARENA_BLOCK_HEADER_SIZE);
+}
+
+static sail_status_t aligned_block_size(size_t size, size_t *result) {
+
+    if (size > SIZE_MAX - ARENA_BLOCK_HEADER_SIZE - ARENA_ALIGNMENT) {
+        SAIL_LOG_ERROR("Arena allocation of %lu bytes is too big", (unsigned long)size);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
+    }
+
+    *result = ARENA_BLOCK_HEADER_SIZE + ((size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1));
+
+    return SAIL_OK;
+}
+
+static sail_status_t alloc_chunk(size_t size, struct arena_chunk **chunk) {
+
+    if (size > SIZE_MAX - chunk_header_size()) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
+    }
+
+    struct arena_chunk *chunk_local = allocator_malloc(chunk_header_size() + size);
+
+    if (chunk_local == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
+    }
+
+    chunk_local->next       = NULL;
+    chunk_local->size       = size;
+    chunk_local->used       = 0;
+    chunk_local->last_block = NULL;
+
+    *chunk = chunk_local;
+
+    return SAIL_OK;
+}
+
+static void* carve_block(struct arena_chunk *chunk, size_t size, size_t aligned_size) {
+
+    unsigned char *block = chunk_data(chunk) + chunk->used + ARENA_BLOCK_HEADER_SIZE;
+
+    *block_size(block) = size;
+    chunk->used       += aligned_size;
+    chunk->last_block  = block;
+
+    return block;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t sail_alloc_arena(size_t chunk_size, struct sail_arena **arena) {
+
+    SAIL_CHECK_PTR(arena);
+
+    struct sail_arena *arena_local = allocator_malloc(sizeof(struct sail_arena));
+
+    if (arena_local == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
+    }
+
+    arena_local->chunks     = NULL;
+    arena_local->chunk_size = (chunk_size == 0) ? ARENA_CHUNK_SIZE : chunk_size;
+
+    *arena = arena_local;
+
+    return SAIL_OK;
+}
+
+void sail_destroy_arena(struct sail_arena *arena) {
+
+    if (arena == NULL) {
+        return;
+    }
+
+    if (current_thread_arena == arena) {
+        current_thread_arena = NULL;
+    }
+
+    while (arena->chunks != NULL) {
+        struct arena_chunk *chunk = arena->chunks;
+        arena->chunks = chunk->next;
+
+        allocator_free(chunk);
+    }
+
+    allocator_free(arena);
+}
+
+sail_status_t sail_arena_malloc(struct sail_arena *arena, size_t size, void **ptr) {
+
+    SAIL_CHECK_PTR(arena);
+    SAIL_CHECK_PTR(ptr);
+
+    size_t aligned_size;
+    SAIL_TRY(aligned_block_size(size, &aligned_size));
+
+    struct arena_chunk *head = arena->chunks;
+
+    if (head != NULL && head->size - head->used >= aligned_size) {
+        *ptr = carve_block(head, size, aligned_size);
+        return SAIL_OK;
+    }
+
+    /*
+     * Big blocks get dedicated chunks placed behind the head chunk. This way the rest
+     * of the head chunk is still used for small blocks.
+     */
+    struct arena_chunk *chunk;
+
+    if (aligned_size > arena->chunk_size / 4) {
+        SAIL_TRY(alloc_chunk(aligned_size, &chunk));
+
+        if (head == NULL) {
+            arena->chunks = chunk;
+        } else {
+            chunk->next = head->next;
+            head->next  = chunk;
+        }
+    } else {
+        SAIL_TRY(alloc_chunk(arena->chunk_size, &chunk));
+
+        chunk->next   = head;
+        arena->chunks = chunk;
+    }
+
+    *ptr = carve_block(chunk, size, aligned_size);
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_arena_realloc(struct sail_arena *arena, size_t size, void **ptr) {
+
+    SAIL_CHECK_PTR(arena);
+    SAIL_CHECK_PTR(ptr);
+
+    if (*ptr == NULL) {
+        SAIL_TRY(sail_arena_malloc(arena, size, ptr));
+        return SAIL_OK;
+    }
+
+    const size_t old_size = *block_size(*ptr);
+
+    if (size <= old_size) {
+        *block_size(*ptr) = size;
+        return SAIL_OK;
+    }
+
+    /* Grow the most recently allocated block in place. */
+    struct arena_chunk *head = arena->chunks;
+
+    if (head != NULL && head->last_block == *ptr) {
+        const size_t offset = (size_t)((unsigned char *)*ptr - ARENA_BLOCK_HEADER_SIZE - chunk_data(head));
+        size_t aligned_size;
+        SAIL_TRY(aligned_block_size(size, &aligned_size));
+
+        if (head->size - offset >= aligned_size) {
+            head->used        = offset + aligned_size;
+            *block_size(*ptr) = size;
+            return SAIL_OK;
+        }
+    }
+
+    void *new_ptr;
+    SAIL_TRY(sail_arena_malloc(arena, size, &new_ptr));
+
+    memcpy(new_ptr, *ptr, old_size);
+    *ptr = new_ptr;
+
+    return SAIL_OK;
+}
+
+bool sail_arena_owns(const struct sail_arena *arena, const void *ptr) {
+
+    if (arena == NULL || ptr == NULL) {
+        return false;
+    }
+
+    const uintptr_t address = (uintptr_t)ptr;
+
+    for (struct arena_chunk *chunk = arena->chunks; chunk != NULL; chunk = chunk->next) {
+        const uintptr_t begin = (uintptr_t)chunk_data(chunk);
+
+        if (address >= begin && address < begin + chunk->size) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+struct sail_arena* sail_set_thread_arena(struct sail_arena *arena) {
+
+    struct sail_arena *previous_arena = current_thread_arena;
+    current_thread_arena = arena;
+
+    return previous_arena;
+}
+
+struct sail_arena* sail_thread_arena(void) {
+
+    return current_thread_arena;
+}
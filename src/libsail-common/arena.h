@@ -0,0 +1,110 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_ARENA_H
+#define SAIL_ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Bump allocator. Serves allocations from big memory chunks and frees them all at once
+ * in sail_destroy_arena(). Freeing individual allocations is a no-op.
+ *
+ * When an arena is set as the current arena of the calling thread with sail_set_thread_arena(),
+ * sail_malloc() and sail_calloc() allocate from it, sail_realloc() grows the allocations it owns,
+ * and sail_free() ignores the allocations it owns. Reading and writing operations use a thread arena
+ * when SAIL_IO_OPTION_ARENA is requested.
+ *
+ * Arenas are not thread-safe.
+ */
+struct sail_arena;
+
+/*
+ * Allocates a new arena. Memory chunks are allocated with sail_set_allocator() callbacks
+ * or with the system allocator. Pass 0 as chunk_size to use the default size of 64 KiB.
+ * The assigned arena MUST be destroyed later with sail_destroy_arena().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_alloc_arena(size_t chunk_size, struct sail_arena **arena);
+
+/*
+ * Destroys the specified arena and all the memory allocated from it. Does nothing if the arena is NULL.
+ */
+SAIL_EXPORT void sail_destroy_arena(struct sail_arena *arena);
+
+/*
+ * Allocates a memory block of the specified size from the arena. The block is aligned
+ * to 16 bytes. It's valid until the arena is destroyed.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_arena_malloc(struct sail_arena *arena, size_t size, void **ptr);
+
+/*
+ * Grows or shrinks the specified memory block allocated from the arena. The last allocated block
+ * is resized in place when possible. Otherwise, a new block is allocated and the data is copied.
+ * Allocates a new block if *ptr is NULL.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_arena_realloc(struct sail_arena *arena, size_t size, void **ptr);
+
+/*
+ * Returns true if the specified pointer belongs to the memory chunks of the arena.
+ */
+SAIL_EXPORT bool sail_arena_owns(const struct sail_arena *arena, const void *ptr);
+
+/*
+ * Sets the current arena of the calling thread. Pass NULL to stop allocating from arenas.
+ *
+ * Returns the previous arena of the calling thread.
+ */
+SAIL_EXPORT struct sail_arena* sail_set_thread_arena(struct sail_arena *arena);
+
+/*
+ * Returns the current arena of the calling thread or NULL.
+ */
+SAIL_EXPORT struct sail_arena* sail_thread_arena(void);
+
+/* extern "C" */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -305,6 +305,15 @@ enum SailCodecFeature {
 
     /* Ability to read or write embedded ICC profiles. */
     SAIL_CODEC_FEATURE_ICCP        = 1 << 6,
+
+    /* Ability to read from or write into non-seekable I/O streams like pipes and sockets without seeking. */
+    SAIL_CODEC_FEATURE_STREAMING   = 1 << 7,
+
+    /* Ability to read frames by bands of scan lines without decoding whole frames into memory. */
+    SAIL_CODEC_FEATURE_SCAN_LINES  = 1 << 8,
+
+    /* Ability to decode frames reduced with sail_read_options.scale_denominator natively. */
+    SAIL_CODEC_FEATURE_SCALING     = 1 << 9,
 };
 
 /* Read or write options. */
@@ -321,6 +330,27 @@ enum SailIoOption {
 
     /* Instruction to read or write embedded ICC profile. */
     SAIL_IO_OPTION_ICCP       = 1 << 3,
+
+    /*
+     * Instruction to memory-map files for reading. Codecs could borrow the mapped bytes directly
+     * instead of copying them. Has no effect for writing operations and non-file sources.
+     * Could be also enabled for all file reading operations with the SAIL_MMAP_IO environment variable.
+     */
+    SAIL_IO_OPTION_MMAP       = 1 << 4,
+
+    /*
+     * Instruction to allocate codec states, copied options, and other internal data of a reading
+     * or writing operation from an arena. The arena is freed at once by sail_stop_reading() or sail_stop_writing().
+     * Images returned to the caller are never allocated from the arena. See sail_alloc_arena().
+     */
+    SAIL_IO_OPTION_ARENA      = 1 << 5,
+
+    /*
+     * Instruction to parse image headers only. Codecs skip setting up decoders and allocating canvases,
+     * so frames cannot be decoded. Set by sail_probe_io() and brothers. Reading operations cannot be
+     * started with this option.
+     */
+    SAIL_IO_OPTION_PROBE      = 1 << 6,
 };
 
 #endif
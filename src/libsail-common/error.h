@@ -119,6 +119,8 @@ enum SailStatus {
     SAIL_ERROR_ENV_UPDATE,
     SAIL_ERROR_CONTEXT_UNINITIALIZED,
     SAIL_ERROR_GET_DLL_PATH,
+    SAIL_ERROR_THREADING,
+    SAIL_ERROR_OUTDATED_CODECS_CACHE,
 };
 
 typedef enum SailStatus sail_status_t;
@@ -23,6 +23,7 @@
     SOFTWARE.
 */
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -51,6 +52,7 @@ sail_status_t sail_alloc_image(struct sail_image **image) {
     (*image)->iccp                    = NULL;
     (*image)->properties              = 0;
     (*image)->source_image            = NULL;
+    (*image)->pixels_pool_size        = 0;
 
     return SAIL_OK;
 }
@@ -61,7 +63,7 @@ void sail_destroy_image(struct sail_image *image) {
         return;
     }
 
-    sail_free(image->pixels);
+    sail_release_pooled_pixels(image->pixels, image->pixels_pool_size);
 
     sail_destroy_resolution(image->resolution);
     sail_destroy_palette(image->palette);
@@ -77,16 +79,20 @@ sail_status_t sail_copy_image(const struct sail_image *source, struct sail_image
     SAIL_CHECK_IMAGE_PTR(source);
     SAIL_CHECK_IMAGE_PTR(target);
 
-    unsigned pixels_size;
-    SAIL_TRY(sail_bytes_per_image(source, &pixels_size));
+    uint64_t pixels_size;
+    SAIL_TRY(sail_bytes_per_image64(source, &pixels_size));
+
+    if (pixels_size > SIZE_MAX) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
+    }
 
     SAIL_TRY(sail_alloc_image(target));
 
     if (source->pixels != NULL) {
-        SAIL_TRY_OR_CLEANUP(sail_malloc(pixels_size, &(*target)->pixels),
+        SAIL_TRY_OR_CLEANUP(sail_malloc((size_t)pixels_size, &(*target)->pixels),
                             /* cleanup */ sail_destroy_image(*target));
 
-        memcpy((*target)->pixels, source->pixels, pixels_size);
+        memcpy((*target)->pixels, source->pixels, (size_t)pixels_size);
     }
 
     (*target)->width                = source->width;
@@ -27,6 +27,7 @@
 #define SAIL_IMAGE_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef SAIL_BUILD
     #include "error.h"
@@ -179,6 +180,18 @@ struct sail_image {
      * WRITE: Ignored.
      */
     struct sail_source_image *source_image;
+
+    /*
+     * Capacity of the pixel buffer acquired from the pixel pool or 0 if the pixels are not pooled.
+     * sail_destroy_image() returns pooled pixels back to the pool. See sail_enable_pixel_pool().
+     *
+     * This field is used internally by SAIL. Reset it to 0 when replacing the pixels or taking
+     * over their ownership.
+     *
+     * READ:  N/A.
+     * WRITE: N/A.
+     */
+    size_t pixels_pool_size;
 };
 
 typedef struct sail_image sail_image_t;
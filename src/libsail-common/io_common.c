@@ -25,6 +25,8 @@
 
 #include "config.h"
 
+#include <limits.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #include "sail-common.h"
@@ -37,15 +39,20 @@ sail_status_t sail_alloc_io(struct sail_io **io) {
     SAIL_TRY(sail_malloc(sizeof(struct sail_io), &ptr));
     *io = ptr;
 
-    (*io)->id     = 0;
-    (*io)->stream = NULL;
-    (*io)->read   = NULL;
-    (*io)->seek   = NULL;
-    (*io)->tell   = NULL;
-    (*io)->write  = NULL;
-    (*io)->flush  = NULL;
-    (*io)->close  = NULL;
-    (*io)->eof    = NULL;
+    (*io)->id       = 0;
+    (*io)->stream   = NULL;
+    (*io)->read     = NULL;
+    (*io)->seek     = NULL;
+    (*io)->tell     = NULL;
+    (*io)->write    = NULL;
+    (*io)->flush    = NULL;
+    (*io)->close    = NULL;
+    (*io)->eof      = NULL;
+    (*io)->borrow   = NULL;
+    (*io)->read_at  = NULL;
+    (*io)->features = 0;
+    (*io)->seek64   = NULL;
+    (*io)->tell64   = NULL;
 
     return SAIL_OK;
 }
@@ -63,3 +70,40 @@ void sail_destroy_io(struct sail_io *io) {
 
     sail_free(io);
 }
+
+sail_status_t sail_io_seek(struct sail_io *io, int64_t offset, int whence) {
+
+    SAIL_CHECK_IO_PTR(io);
+
+    if (io->seek64 != NULL) {
+        SAIL_TRY(io->seek64(io->stream, offset, whence));
+        return SAIL_OK;
+    }
+
+    if (offset < LONG_MIN || offset > LONG_MAX) {
+        SAIL_LOG_ERROR("The I/O offset %lld doesn't fit into long. Set sail_io.seek64 to support it", (long long)offset);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    SAIL_TRY(io->seek(io->stream, (long)offset, whence));
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_io_tell(struct sail_io *io, uint64_t *offset) {
+
+    SAIL_CHECK_IO_PTR(io);
+    SAIL_CHECK_PTR(offset);
+
+    if (io->tell64 != NULL) {
+        SAIL_TRY(io->tell64(io->stream, offset));
+        return SAIL_OK;
+    }
+
+    size_t offset_local;
+    SAIL_TRY(io->tell(io->stream, &offset_local));
+
+    *offset = offset_local;
+
+    return SAIL_OK;
+}
@@ -49,6 +49,10 @@ typedef sail_status_t (*sail_io_write_t)(void *stream, const void *buf, size_t o
 typedef sail_status_t (*sail_io_flush_t)(void *stream);
 typedef sail_status_t (*sail_io_close_t)(void *stream);
 typedef sail_status_t (*sail_io_eof_t)(void *stream, bool *result);
+typedef sail_status_t (*sail_io_borrow_t)(void *stream, size_t size, const void **buf, size_t *borrowed_size);
+typedef sail_status_t (*sail_io_read_at_t)(void *stream, uint64_t offset, void *buf, size_t size, size_t *read_size);
+typedef sail_status_t (*sail_io_seek64_t)(void *stream, int64_t offset, int whence);
+typedef sail_status_t (*sail_io_tell64_t)(void *stream, uint64_t *offset);
 
 /*
  * Well-known I/O ids used in libsail for file and memory I/O classes.
@@ -56,11 +60,29 @@ typedef sail_status_t (*sail_io_eof_t)(void *stream, bool *result);
  * You MUST use your own unique id for custom I/O classes. For example, you can use sail_hash()
  * to generate a unique id and store it in the source code.
  *
- * SAIL_FILE_IO_ID   = sail_hash("sail-file-io-id")
- * SAIL_MEMORY_IO_ID = sail_hash("sail-memory-io-id")
+ * SAIL_FILE_IO_ID         = sail_hash("sail-file-io-id")
+ * SAIL_MEMORY_IO_ID       = sail_hash("sail-memory-io-id")
+ * SAIL_MMAP_IO_ID         = sail_hash("sail-mmap-io-id")
+ * SAIL_RING_BUFFER_IO_ID  = sail_hash("sail-ring-buffer-io-id")
+ * SAIL_COUNTING_IO_ID     = sail_hash("sail-counting-io-id")
+ * SAIL_MEM_SEGMENTS_IO_ID = sail_hash("sail-memory-segments-io-id")
  */
-static const uint64_t SAIL_FILE_IO_ID   = UINT64_C(5820790535323209114);
-static const uint64_t SAIL_MEMORY_IO_ID = UINT64_C(11955407548648566675);
+static const uint64_t SAIL_FILE_IO_ID         = UINT64_C(5820790535323209114);
+static const uint64_t SAIL_MEMORY_IO_ID       = UINT64_C(11955407548648566675);
+static const uint64_t SAIL_MMAP_IO_ID         = UINT64_C(5821120586751770661);
+static const uint64_t SAIL_RING_BUFFER_IO_ID  = UINT64_C(16924185892731032017);
+static const uint64_t SAIL_COUNTING_IO_ID     = UINT64_C(16118060224336727457);
+static const uint64_t SAIL_MEM_SEGMENTS_IO_ID = UINT64_C(12605540433628725254);
+
+/* I/O features. */
+enum SailIoFeature {
+
+    /*
+     * The I/O object doesn't support seeking. Non-seekable sources and sinks like pipes and sockets must set
+     * this feature. Their seek() and tell() callbacks must still be set, but they could fail.
+     */
+    SAIL_IO_FEATURE_NON_SEEKABLE = 1 << 0,
+};
 
 /*
  * A structure representing an input/output abstraction. Use sail_alloc_io_read_file() and brothers to
@@ -136,10 +158,79 @@ struct sail_io {
      * Returns SAIL_OK on success.
      */
     sail_io_eof_t eof;
+
+    /*
+     * Optional. Borrows up to size contiguous bytes at the current I/O position without copying them
+     * and advances the I/O position by the number of borrowed bytes. Assigns the number of borrowed bytes
+     * which could be less than requested near the end of the stream. The borrowed bytes stay valid
+     * and unchanged until the I/O object is closed.
+     *
+     * Codecs could use it instead of read() to avoid copying data into their own buffers. NULL if the I/O
+     * object doesn't support borrowing. Codecs MUST fall back to read() in this case.
+     *
+     * Returns SAIL_OK on success or SAIL_ERROR_EOF if no bytes left.
+     */
+    sail_io_borrow_t borrow;
+
+    /*
+     * Optional. Reads up to size bytes starting at the specified absolute offset into the buffer
+     * and assigns the number of bytes read which could be less than requested near the end of the stream.
+     * Doesn't use or change the I/O position, so it's safe to call it from multiple threads concurrently,
+     * and concurrently with the other callbacks.
+     *
+     * Codecs and libsail could use it to read parts of the stream without seeking. NULL if the I/O
+     * object doesn't support positioned reads. Callers MUST fall back to seek() and read() in this case.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_io_read_at_t read_at;
+
+    /*
+     * Or-ed I/O features. See SailIoFeature. 0 means a regular seekable I/O object.
+     *
+     * libsail reads non-seekable sources through a ring buffer with a limited rewind window
+     * where it needs to seek, for example to detect an image format by its magic number.
+     * Non-seekable sinks could be written only by codecs with SAIL_CODEC_FEATURE_STREAMING.
+     */
+    int features;
+
+    /*
+     * Optional. 64-bit version of seek(). Offsets are 64-bit on all platforms to support streams
+     * larger than 4 GB where long is 32-bit. NULL if the I/O object doesn't support 64-bit offsets.
+     *
+     * libsail prefers it over seek() when it's set. Use sail_io_seek() to call it.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_io_seek64_t seek64;
+
+    /*
+     * Optional. 64-bit version of tell(). NULL if the I/O object doesn't support 64-bit offsets.
+     *
+     * libsail prefers it over tell() when it's set. Use sail_io_tell() to call it.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_io_tell64_t tell64;
 };
 
 typedef struct sail_io sail_io_t;
 
+/*
+ * A contiguous memory segment. A list of segments describes a single logical stream
+ * stored in non-contiguous memory, for example, a chain of network buffers.
+ */
+struct sail_mem_segment {
+
+    /* Segment data. */
+    const void *buffer;
+
+    /* The length of the segment data in bytes. Empty segments are allowed and skipped. */
+    size_t length;
+};
+
+typedef struct sail_mem_segment sail_mem_segment_t;
+
 /*
  * Allocates a new I/O object. The assigned I/O object MUST be destroyed later with sail_destroy_io().
  *
@@ -158,6 +249,22 @@ SAIL_EXPORT sail_status_t sail_alloc_io(struct sail_io **io);
  */
 SAIL_EXPORT void sail_destroy_io(struct sail_io *io);
 
+/*
+ * Sets the I/O position in the specified I/O object. Calls sail_io.seek64() if it's set.
+ * Otherwise, calls sail_io.seek() and fails with SAIL_ERROR_SEEK_IO if the offset doesn't fit into long.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_io_seek(struct sail_io *io, int64_t offset, int whence);
+
+/*
+ * Assigns the current I/O position in the specified I/O object. Calls sail_io.tell64() if it's set.
+ * Otherwise, calls sail_io.tell().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_io_tell(struct sail_io *io, uint64_t *offset);
+
 /* extern "C" */
 #ifdef __cplusplus
 }
@@ -0,0 +1,559 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef SAIL_WIN32
+    #include <windows.h>
+#else
+    #include <pthread.h>
+#endif
+
+#include "sail-common.h"
+
+#include "allocator_private.h"
+
+/*
+ * Private functions.
+ */
+
+/* The smallest size class is 4 KiB. Smaller buffers use it too. */
+#define POOL_MIN_CLASS_SHIFT 12
+
+/* Every power of two is split into 4 size classes. */
+#define POOL_CLASSES_PER_POWER 4
+
+#define POOL_CLASSES ((sizeof(size_t) * 8 - POOL_MIN_CLASS_SHIFT) * POOL_CLASSES_PER_POWER + 1)
+
+/* Number of buffers cached by every thread. */
+#define THREAD_CACHE_SIZE 4
+
+/* Unused buffers of the shared pool are linked through their first bytes. */
+struct free_buffer {
+
+    struct free_buffer *next;
+};
+
+struct thread_cache {
+
+    /* The most recently released buffer is the last one. */
+    void *buffers[THREAD_CACHE_SIZE];
+    size_t capacities[THREAD_CACHE_SIZE];
+    unsigned count;
+
+    /* Pool generation the cached buffers belong to. The cache is freed when the pool is disabled. */
+    uint64_t generation;
+};
+
+/*
+ * Thread caches are touched by their threads only, so they're used without the lock.
+ * The counters below are shared by all threads and updated atomically.
+ */
+struct pixel_pool {
+
+    /* Written under the pool lock. */
+    uint64_t enabled;
+    uint64_t memory_limit;
+
+    /* Incremented when the pool is disabled. */
+    uint64_t generation;
+
+    /* Guarded by the pool lock. */
+    struct free_buffer *free_buffers[POOL_CLASSES];
+
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t releases;
+    uint64_t evictions;
+    uint64_t cached_bytes;
+};
+
+/* Guards the shared free lists. */
+#ifdef SAIL_WIN32
+static SRWLOCK pool_lock = SRWLOCK_INIT;
+#else
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static struct pixel_pool pool;
+
+SAIL_THREAD_LOCAL static struct thread_cache *current_thread_cache = NULL;
+
+static void lock_pool(void) {
+
+#ifdef SAIL_WIN32
+    AcquireSRWLockExclusive(&pool_lock);
+#else
+    pthread_mutex_lock(&pool_lock);
+#endif
+}
+
+static void unlock_pool(void) {
+
+#ifdef SAIL_WIN32
+    ReleaseSRWLockExclusive(&pool_lock);
+#else
+    pthread_mutex_unlock(&pool_lock);
+#endif
+}
+
+static uint64_t load_counter(uint64_t *counter) {
+
+#ifdef SAIL_WIN32
+    return (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)counter, 0, 0);
+#else
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
+#endif
+}
+
+static void store_counter(uint64_t *counter, uint64_t value) {
+
+#ifdef SAIL_WIN32
+    InterlockedExchange64((volatile LONG64 *)counter, (LONG64)value);
+#else
+    __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+#endif
+}
+
+/* Adds the value to the counter and returns the new value. Pass the negated value to subtract it. */
+static uint64_t add_counter(uint64_t *counter, uint64_t value) {
+
+#ifdef SAIL_WIN32
+    return (uint64_t)InterlockedExchangeAdd64((volatile LONG64 *)counter, (LONG64)value) + value;
+#else
+    return __atomic_add_fetch(counter, value, __ATOMIC_RELAXED);
+#endif
+}
+
+/*
+ * Assigns the index and the capacity of the size class of the specified size.
+ * Returns false if the size is too big to be pooled.
+ */
+static bool size_class(size_t size, size_t *index, size_t *capacity) {
+
+    const size_t min_capacity = (size_t)1 << POOL_MIN_CLASS_SHIFT;
+
+    if (size <= min_capacity) {
+        *index    = 0;
+        *capacity = min_capacity;
+        return true;
+    }
+
+    if (size > SIZE_MAX / 2) {
+        return false;
+    }
+
+    /* 2^shift < size <= 2^(shift+1) */
+    unsigned shift = POOL_MIN_CLASS_SHIFT;
+
+    while (((size_t)2 << shift) < size) {
+        shift++;
+    }
+
+    const size_t base  = (size_t)1 << shift;
+    const size_t step  = base / POOL_CLASSES_PER_POWER;
+    const size_t steps = (size - base + step - 1) / step;
+
+    *index    = (shift - POOL_MIN_CLASS_SHIFT) * POOL_CLASSES_PER_POWER + steps;
+    *capacity = base + steps * step;
+
+    return true;
+}
+
+/* Returns the capacity of the size class with the specified index. */
+static size_t class_capacity(size_t index) {
+
+    if (index == 0) {
+        return (size_t)1 << POOL_MIN_CLASS_SHIFT;
+    }
+
+    const size_t base  = (size_t)1 << (POOL_MIN_CLASS_SHIFT + (index - 1) / POOL_CLASSES_PER_POWER);
+    const size_t steps = (index - 1) % POOL_CLASSES_PER_POWER + 1;
+
+    return base + steps * (base / POOL_CLASSES_PER_POWER);
+}
+
+/* Must be called with the pool lock held. */
+static void push_free_buffer(void *buffer, size_t capacity) {
+
+    size_t index;
+    size_t class_capacity;
+    size_class(capacity, &index, &class_capacity);
+
+    struct free_buffer *free_buffer = buffer;
+    free_buffer->next = pool.free_buffers[index];
+    pool.free_buffers[index] = free_buffer;
+}
+
+/* Frees the cached buffers and moves the cache to the specified pool generation. */
+static void drain_thread_cache(struct thread_cache *cache, uint64_t generation) {
+
+    for (unsigned i = 0; i < cache->count; i++) {
+        allocator_free(cache->buffers[i]);
+        add_counter(&pool.cached_bytes, (uint64_t)0 - cache->capacities[i]);
+    }
+
+    cache->count      = 0;
+    cache->generation = generation;
+}
+
+/* Must be called with the pool lock held. Moves the buffer to the shared pool or frees it if the pool is disabled. */
+static void share_buffer(void *buffer, size_t capacity) {
+
+    if (pool.enabled) {
+        push_free_buffer(buffer, capacity);
+    } else {
+        allocator_free(buffer);
+        add_counter(&pool.cached_bytes, (uint64_t)0 - capacity);
+    }
+}
+
+/* Called when threads exit. Moves the cached buffers to the shared pool. */
+static void destroy_thread_cache(void *data) {
+
+    struct thread_cache *cache = data;
+
+    if (cache->generation != load_counter(&pool.generation)) {
+        drain_thread_cache(cache, 0);
+    } else {
+        lock_pool();
+
+        for (unsigned i = 0; i < cache->count; i++) {
+            share_buffer(cache->buffers[i], cache->capacities[i]);
+        }
+
+        unlock_pool();
+    }
+
+    /* The cache is not used by the exiting thread anymore. */
+    if (current_thread_cache == cache) {
+        current_thread_cache = NULL;
+    }
+
+    allocator_free(cache);
+}
+
+#ifdef SAIL_WIN32
+static INIT_ONCE thread_cache_key_once = INIT_ONCE_STATIC_INIT;
+static DWORD thread_cache_key = FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI thread_cache_fls_callback(PVOID data) {
+
+    if (data != NULL) {
+        destroy_thread_cache(data);
+    }
+}
+
+static BOOL CALLBACK create_thread_cache_key(PINIT_ONCE once, PVOID parameter, PVOID *context) {
+
+    (void)once;
+    (void)parameter;
+    (void)context;
+
+    thread_cache_key = FlsAlloc(thread_cache_fls_callback);
+
+    return TRUE;
+}
+#else
+static pthread_once_t thread_cache_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t thread_cache_key;
+static bool thread_cache_key_created = false;
+
+static void create_thread_cache_key(void) {
+
+    thread_cache_key_created = pthread_key_create(&thread_cache_key, destroy_thread_cache) == 0;
+}
+#endif
+
+/*
+ * Returns the cache of the calling thread. Creates it and registers it for destruction on thread exit
+ * if necessary. Returns NULL on error.
+ */
+static struct thread_cache* thread_cache(void) {
+
+    if (current_thread_cache != NULL) {
+        return current_thread_cache;
+    }
+
+#ifdef SAIL_WIN32
+    InitOnceExecuteOnce(&thread_cache_key_once, create_thread_cache_key, NULL, NULL);
+
+    if (thread_cache_key == FLS_OUT_OF_INDEXES) {
+        return NULL;
+    }
+#else
+    pthread_once(&thread_cache_key_once, create_thread_cache_key);
+
+    if (!thread_cache_key_created) {
+        return NULL;
+    }
+#endif
+
+    struct thread_cache *cache = allocator_malloc(sizeof(struct thread_cache));
+
+    if (cache == NULL) {
+        return NULL;
+    }
+
+    cache->count      = 0;
+    cache->generation = load_counter(&pool.generation);
+
+#ifdef SAIL_WIN32
+    if (!FlsSetValue(thread_cache_key, cache)) {
+#else
+    if (pthread_setspecific(thread_cache_key, cache) != 0) {
+#endif
+        allocator_free(cache);
+        return NULL;
+    }
+
+    current_thread_cache = cache;
+
+    return cache;
+}
+
+/*
+ * Must be called with the pool lock held. Frees the shared buffers of the size class
+ * until the pool fits the memory limit. Pass 0 as the limit to free all of them.
+ */
+static void free_shared_buffers(size_t index, size_t memory_limit) {
+
+    const size_t capacity = class_capacity(index);
+
+    while (pool.free_buffers[index] != NULL && load_counter(&pool.cached_bytes) > memory_limit) {
+        struct free_buffer *free_buffer = pool.free_buffers[index];
+        pool.free_buffers[index] = free_buffer->next;
+
+        allocator_free(free_buffer);
+        add_counter(&pool.cached_bytes, (uint64_t)0 - capacity);
+    }
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t sail_enable_pixel_pool(size_t memory_limit) {
+
+    if (memory_limit == 0) {
+        SAIL_LOG_ERROR("Pixel pool memory limit must be positive");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    lock_pool();
+
+    store_counter(&pool.memory_limit, memory_limit);
+    store_counter(&pool.enabled,      1);
+
+    store_counter(&pool.hits,      0);
+    store_counter(&pool.misses,    0);
+    store_counter(&pool.releases,  0);
+    store_counter(&pool.evictions, 0);
+
+    /* Fit the new memory limit starting with the biggest buffers. */
+    for (size_t index = POOL_CLASSES; index > 0; index--) {
+        free_shared_buffers(index - 1, memory_limit);
+    }
+
+    unlock_pool();
+
+    return SAIL_OK;
+}
+
+void sail_disable_pixel_pool(void) {
+
+    lock_pool();
+
+    store_counter(&pool.enabled, 0);
+
+    /* Caches of other threads are freed when these threads see the new generation. */
+    const uint64_t generation = add_counter(&pool.generation, 1);
+
+    for (size_t index = 0; index < POOL_CLASSES; index++) {
+        free_shared_buffers(index, 0);
+    }
+
+    unlock_pool();
+
+    if (current_thread_cache != NULL) {
+        drain_thread_cache(current_thread_cache, generation);
+    }
+}
+
+sail_status_t sail_acquire_pooled_pixels(size_t size, void **pixels, size_t *capacity) {
+
+    SAIL_CHECK_PTR(pixels);
+    SAIL_CHECK_PTR(capacity);
+
+    struct thread_cache *cache = current_thread_cache;
+
+    /* Free the buffers cached before the pool was disabled. */
+    if (cache != NULL) {
+        const uint64_t generation = load_counter(&pool.generation);
+
+        if (cache->generation != generation) {
+            drain_thread_cache(cache, generation);
+        }
+    }
+
+    size_t index;
+    size_t buffer_capacity;
+
+    if (!load_counter(&pool.enabled) || !size_class(size, &index, &buffer_capacity) ||
+            buffer_capacity > load_counter(&pool.memory_limit)) {
+        SAIL_TRY(sail_malloc(size, pixels));
+        *capacity = 0;
+
+        return SAIL_OK;
+    }
+
+    void *buffer = NULL;
+
+    /* Prefer the most recently released buffer of the calling thread. */
+    if (cache != NULL) {
+        for (unsigned i = cache->count; i > 0; i--) {
+            if (cache->capacities[i-1] == buffer_capacity) {
+                buffer = cache->buffers[i-1];
+
+                memmove(cache->buffers + i - 1,    cache->buffers + i,    (cache->count - i) * sizeof(cache->buffers[0]));
+                memmove(cache->capacities + i - 1, cache->capacities + i, (cache->count - i) * sizeof(cache->capacities[0]));
+                cache->count--;
+                break;
+            }
+        }
+    }
+
+    if (buffer == NULL) {
+        lock_pool();
+
+        if (pool.free_buffers[index] != NULL) {
+            struct free_buffer *free_buffer = pool.free_buffers[index];
+            pool.free_buffers[index] = free_buffer->next;
+
+            buffer = free_buffer;
+        }
+
+        unlock_pool();
+    }
+
+    if (buffer != NULL) {
+        add_counter(&pool.hits, 1);
+        add_counter(&pool.cached_bytes, (uint64_t)0 - buffer_capacity);
+
+        *pixels   = buffer;
+        *capacity = buffer_capacity;
+
+        return SAIL_OK;
+    }
+
+    add_counter(&pool.misses, 1);
+
+    buffer = allocator_malloc(buffer_capacity);
+
+    if (buffer == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
+    }
+
+    *pixels   = buffer;
+    *capacity = buffer_capacity;
+
+    return SAIL_OK;
+}
+
+void sail_release_pooled_pixels(void *pixels, size_t capacity) {
+
+    if (pixels == NULL) {
+        return;
+    }
+
+    /* Not a pooled buffer. */
+    if (capacity == 0) {
+        sail_free(pixels);
+        return;
+    }
+
+    struct thread_cache *cache = thread_cache();
+    const uint64_t generation = load_counter(&pool.generation);
+
+    if (cache != NULL && cache->generation != generation) {
+        drain_thread_cache(cache, generation);
+    }
+
+    if (!load_counter(&pool.enabled)) {
+        allocator_free(pixels);
+        return;
+    }
+
+    /* Reserve the room for the buffer, and give it back if it doesn't fit the memory limit. */
+    if (add_counter(&pool.cached_bytes, capacity) > load_counter(&pool.memory_limit)) {
+        add_counter(&pool.cached_bytes, (uint64_t)0 - capacity);
+        add_counter(&pool.evictions, 1);
+
+        allocator_free(pixels);
+        return;
+    }
+
+    add_counter(&pool.releases, 1);
+
+    if (cache == NULL) {
+        lock_pool();
+        share_buffer(pixels, capacity);
+        unlock_pool();
+        return;
+    }
+
+    /* Move the oldest buffer to the shared pool. */
+    if (cache->count == THREAD_CACHE_SIZE) {
+        lock_pool();
+        share_buffer(cache->buffers[0], cache->capacities[0]);
+        unlock_pool();
+
+        memmove(cache->buffers,    cache->buffers + 1,    (THREAD_CACHE_SIZE - 1) * sizeof(cache->buffers[0]));
+        memmove(cache->capacities, cache->capacities + 1, (THREAD_CACHE_SIZE - 1) * sizeof(cache->capacities[0]));
+        cache->count--;
+    }
+
+    cache->buffers[cache->count]    = pixels;
+    cache->capacities[cache->count] = capacity;
+    cache->count++;
+}
+
+sail_status_t sail_pixel_pool_statistics(struct sail_pixel_pool_statistics *statistics) {
+
+    SAIL_CHECK_PTR(statistics);
+
+    statistics->hits         = load_counter(&pool.hits);
+    statistics->misses       = load_counter(&pool.misses);
+    statistics->releases     = load_counter(&pool.releases);
+    statistics->evictions    = load_counter(&pool.evictions);
+    statistics->cached_bytes = (size_t)load_counter(&pool.cached_bytes);
+
+    return SAIL_OK;
+}
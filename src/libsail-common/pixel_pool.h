@@ -0,0 +1,123 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_PIXEL_POOL_H
+#define SAIL_PIXEL_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Pixel pool recycles pixel buffers of decoded frames instead of allocating them
+ * for every frame. Buffers are grouped into size classes spaced by 25% of a power of two,
+ * so frames of slightly different sizes share buffers.
+ *
+ * Released buffers are kept in the cache of the releasing thread first, so every thread reuses
+ * its own recently touched memory without locking. Older buffers move to the pool shared between threads.
+ * Thread caches are moved to the shared pool automatically when threads exit.
+ *
+ * When the pool is enabled, sail_read_next_frame() and brothers acquire frame pixels
+ * from the pool, and sail_destroy_image() returns them back.
+ */
+
+/*
+ * Pixel pool counters.
+ */
+struct sail_pixel_pool_statistics {
+
+    /* Number of buffers acquired from the pool. */
+    uint64_t hits;
+
+    /* Number of buffers allocated because the pool had no buffer of the requested size class. */
+    uint64_t misses;
+
+    /* Number of buffers returned to the pool. */
+    uint64_t releases;
+
+    /* Number of buffers freed instead of returning to the pool because of the memory limit. */
+    uint64_t evictions;
+
+    /* Number of bytes held by the pool right now. */
+    size_t cached_bytes;
+};
+
+typedef struct sail_pixel_pool_statistics sail_pixel_pool_statistics_t;
+
+/*
+ * Enables the pixel pool. The pool holds up to memory_limit bytes of unused buffers.
+ * Could be called again to change the memory limit. Statistics are reset.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_enable_pixel_pool(size_t memory_limit);
+
+/*
+ * Disables the pixel pool and frees the unused buffers of the shared pool and the calling thread.
+ * Unused buffers cached by other threads are freed when these threads use the pool
+ * next time or exit. Buffers still in use are freed by sail_destroy_image() as usual.
+ */
+SAIL_EXPORT void sail_disable_pixel_pool(void);
+
+/*
+ * Acquires a pixel buffer of at least the specified size. Assigns the actual buffer capacity
+ * that must be passed to sail_release_pooled_pixels() later. When the pool is disabled, allocates
+ * the buffer with sail_malloc() and assigns 0 capacity.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_acquire_pooled_pixels(size_t size, void **pixels, size_t *capacity);
+
+/*
+ * Returns the pixel buffer acquired with sail_acquire_pooled_pixels() to the pool.
+ * Frees the buffer if the capacity is 0, the pool is disabled, or the memory limit is reached.
+ * Does nothing if the buffer is NULL.
+ */
+SAIL_EXPORT void sail_release_pooled_pixels(void *pixels, size_t capacity);
+
+/*
+ * Assigns the pixel pool counters.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_pixel_pool_statistics(struct sail_pixel_pool_statistics *statistics);
+
+/* extern "C" */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
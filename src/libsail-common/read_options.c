@@ -39,6 +39,12 @@ sail_status_t sail_alloc_read_options(struct sail_read_options **read_options) {
 
     (*read_options)->output_pixel_format = SAIL_PIXEL_FORMAT_UNKNOWN;
     (*read_options)->io_options          = 0;
+    (*read_options)->roi_x               = 0;
+    (*read_options)->roi_y               = 0;
+    (*read_options)->roi_width           = 0;
+    (*read_options)->roi_height          = 0;
+    (*read_options)->scale_denominator   = 1;
+    (*read_options)->target_size         = 0;
 
     return SAIL_OK;
 }
@@ -73,6 +79,16 @@ sail_status_t sail_read_options_from_features(const struct sail_read_features *r
         read_options->io_options |= SAIL_IO_OPTION_ICCP;
     }
 
+    /* Decode whole frames. */
+    read_options->roi_x      = 0;
+    read_options->roi_y      = 0;
+    read_options->roi_width  = 0;
+    read_options->roi_height = 0;
+
+    /* Decode full-size frames. */
+    read_options->scale_denominator = 1;
+    read_options->target_size       = 0;
+
     return SAIL_OK;
 }
 
@@ -87,6 +103,38 @@ sail_status_t sail_alloc_read_options_from_features(const struct sail_read_featu
     return SAIL_OK;
 }
 
+sail_status_t sail_read_options_scale_denominator(const struct sail_read_options *read_options,
+                                                    unsigned width, unsigned height, unsigned *scale_denominator) {
+
+    SAIL_CHECK_READ_OPTIONS_PTR(read_options);
+    SAIL_CHECK_RESULT_PTR(scale_denominator);
+
+    if (read_options->target_size > 0) {
+        const unsigned longest_side = (width > height) ? width : height;
+
+        *scale_denominator = 8;
+
+        /* Reduced dimensions are rounded up. */
+        while (*scale_denominator > 1 && (longest_side + *scale_denominator - 1) / *scale_denominator < read_options->target_size) {
+            *scale_denominator /= 2;
+        }
+
+        return SAIL_OK;
+    }
+
+    switch (read_options->scale_denominator) {
+        case 0:
+        case 1: *scale_denominator = 1; return SAIL_OK;
+
+        case 2:
+        case 4:
+        case 8: *scale_denominator = read_options->scale_denominator; return SAIL_OK;
+    }
+
+    SAIL_LOG_ERROR("Scale denominator %u is not supported. Possible values are 1, 2, 4, and 8", read_options->scale_denominator);
+    SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+}
+
 sail_status_t sail_copy_read_options(const struct sail_read_options *source, struct sail_read_options **target) {
 
     SAIL_CHECK_READ_OPTIONS_PTR(source);
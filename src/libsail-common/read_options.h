@@ -53,6 +53,32 @@ struct sail_read_options {
 
     /* Or-ed IO manipulation options. See SailIoOption. */
     int io_options;
+
+    /*
+     * Region of interest in the (possibly reduced) frames. When set, output images contain only this rectangle
+     * clipped to the frame dimensions, and codecs skip decoding scan lines outside of it where possible.
+     * The region is not applied when its width or height is 0. This is the default.
+     */
+    unsigned roi_x;
+    unsigned roi_y;
+    unsigned roi_width;
+    unsigned roi_height;
+
+    /*
+     * Reduce frames by this denominator. Possible values are 1 (no reduction), 2, 4, and 8.
+     * Reduced dimensions are rounded up. Codecs with SAIL_CODEC_FEATURE_SCALING reduce frames natively,
+     * e.g. JPEG with DCT scaling. Frames of other codecs are reduced with a box filter while
+     * their scan lines are read. The box filter weights colors by alpha. The region of interest
+     * is applied to reduced frames. Default is 1.
+     */
+    unsigned scale_denominator;
+
+    /*
+     * Reduce frames to the specified size instead of using scale_denominator. Picks the biggest possible
+     * denominator that keeps the longest frame side greater than or equal to this size. Useful to read
+     * previews quickly. The size is not applied when it's 0. This is the default.
+     */
+    unsigned target_size;
 };
 
 typedef struct sail_read_options sail_read_options_t;
@@ -86,6 +112,15 @@ SAIL_EXPORT sail_status_t sail_read_options_from_features(const struct sail_read
  */
 SAIL_EXPORT sail_status_t sail_alloc_read_options_from_features(const struct sail_read_features *read_features, struct sail_read_options **read_options);
 
+/*
+ * Calculates the denominator to reduce a frame of the specified dimensions with according to
+ * scale_denominator and target_size in the read options. The result is 1, 2, 4, or 8.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_read_options_scale_denominator(const struct sail_read_options *read_options,
+                                                                unsigned width, unsigned height, unsigned *scale_denominator);
+
 /*
  * Makes a deep copy of the specified read options object. The assigned read options MUST be destroyed later
  * with sail_destroy_read_options().
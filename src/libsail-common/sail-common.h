@@ -31,6 +31,7 @@
 #ifdef SAIL_BUILD
     #include "config.h"
 
+    #include "arena.h"
     #include "common.h"
     #include "error.h"
     #include "export.h"
@@ -40,6 +41,7 @@
     #include "log.h"
     #include "meta_data_node.h"
     #include "palette.h"
+    #include "pixel_pool.h"
     #include "pixel_formats_mapping_node.h"
     #include "read_features.h"
     #include "read_options.h"
@@ -51,6 +53,7 @@
 #else
     #include <sail-common/config.h>
 
+    #include <sail-common/arena.h>
     #include <sail-common/common.h>
     #include <sail-common/error.h>
     #include <sail-common/export.h>
@@ -60,6 +63,7 @@
     #include <sail-common/log.h>
     #include <sail-common/meta_data_node.h>
     #include <sail-common/palette.h>
+    #include <sail-common/pixel_pool.h>
     #include <sail-common/pixel_formats_mapping_node.h>
     #include <sail-common/read_features.h>
     #include <sail-common/read_options.h>
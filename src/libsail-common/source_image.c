@@ -40,6 +40,7 @@ sail_status_t sail_alloc_source_image(struct sail_source_image **source_image) {
     (*source_image)->pixel_format = SAIL_PIXEL_FORMAT_UNKNOWN;
     (*source_image)->properties   = 0;
     (*source_image)->compression  = SAIL_COMPRESSION_UNSUPPORTED;
+    (*source_image)->frames       = 0;
 
     return SAIL_OK;
 }
@@ -63,6 +64,7 @@ sail_status_t sail_copy_source_image(const struct sail_source_image *source, str
     (*target)->pixel_format = source->pixel_format;
     (*target)->properties   = source->properties;
     (*target)->compression  = source->compression;
+    (*target)->frames       = source->frames;
 
     return SAIL_OK;
 }
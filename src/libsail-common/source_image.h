@@ -73,6 +73,15 @@ struct sail_source_image {
      * WRITE: Ignored.
      */
     enum SailCompression compression;
+
+    /*
+     * Number of frames in the image file as stored in its headers like APNG or multi-page TIFF.
+     * It's only a hint as the actual number of frames could differ for broken files.
+     *
+     * READ:  Set by SAIL to the number of frames or to 0 if the image format doesn't store it in headers.
+     * WRITE: Ignored.
+     */
+    unsigned frames;
 };
 
 typedef struct sail_source_image sail_source_image_t;
@@ -27,7 +27,9 @@
 
 #include <ctype.h>
 #include <errno.h>
+#include <limits.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -45,6 +47,47 @@
 
 #include "sail-common.h"
 
+#include "allocator_private.h"
+
+/*
+ * Private functions.
+ */
+
+/* Custom allocator. NULL callbacks mean the system allocator. */
+static struct sail_allocator custom_allocator = { NULL, NULL, NULL, NULL };
+
+void* allocator_malloc(size_t size) {
+
+    if (custom_allocator.malloc_func != NULL) {
+        return custom_allocator.malloc_func(custom_allocator.user_data, size);
+    }
+
+    return malloc(size);
+}
+
+void* allocator_realloc(void *ptr, size_t size) {
+
+    if (custom_allocator.realloc_func != NULL) {
+        return custom_allocator.realloc_func(custom_allocator.user_data, ptr, size);
+    }
+
+    return realloc(ptr, size);
+}
+
+void allocator_free(void *ptr) {
+
+    if (custom_allocator.free_func != NULL) {
+        custom_allocator.free_func(custom_allocator.user_data, ptr);
+        return;
+    }
+
+    free(ptr);
+}
+
+/*
+ * Public functions.
+ */
+
 sail_status_t sail_memdup(const void *input, size_t input_size, void **output) {
 
     if (input == NULL) {
@@ -604,6 +647,9 @@ sail_status_t sail_codec_feature_to_string(enum SailCodecFeature codec_feature,
         case SAIL_CODEC_FEATURE_EXIF:        *result = "EXIF";        return SAIL_OK;
         case SAIL_CODEC_FEATURE_INTERLACED:  *result = "INTERLACED";  return SAIL_OK;
         case SAIL_CODEC_FEATURE_ICCP:        *result = "ICCP";        return SAIL_OK;
+        case SAIL_CODEC_FEATURE_STREAMING:   *result = "STREAMING";   return SAIL_OK;
+        case SAIL_CODEC_FEATURE_SCAN_LINES:  *result = "SCAN-LINES";  return SAIL_OK;
+        case SAIL_CODEC_FEATURE_SCALING:     *result = "SCALING";     return SAIL_OK;
     }
 
     SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_CODEC_FEATURE);
@@ -629,6 +675,9 @@ sail_status_t sail_codec_feature_from_string(const char *str, enum SailCodecFeat
         case UINT64_C(6384018865):           *result = SAIL_CODEC_FEATURE_EXIF;        return SAIL_OK;
         case UINT64_C(8244927930303708800):  *result = SAIL_CODEC_FEATURE_INTERLACED;  return SAIL_OK;
         case UINT64_C(6384139556):           *result = SAIL_CODEC_FEATURE_ICCP;        return SAIL_OK;
+        case UINT64_C(249860618112082895):   *result = SAIL_CODEC_FEATURE_STREAMING;   return SAIL_OK;
+        case UINT64_C(8245375775078012786):  *result = SAIL_CODEC_FEATURE_SCAN_LINES;  return SAIL_OK;
+        case UINT64_C(229439735470214):      *result = SAIL_CODEC_FEATURE_SCALING;     return SAIL_OK;
     }
 
     SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_CODEC_FEATURE);
@@ -718,6 +767,23 @@ sail_status_t sail_bits_per_pixel(enum SailPixelFormat pixel_format, unsigned *r
 
 sail_status_t sail_bytes_per_line(unsigned width, enum SailPixelFormat pixel_format, unsigned *result) {
 
+    SAIL_CHECK_RESULT_PTR(result);
+
+    uint64_t bytes_per_line;
+    SAIL_TRY(sail_bytes_per_line64(width, pixel_format, &bytes_per_line));
+
+    if (bytes_per_line > UINT_MAX) {
+        SAIL_LOG_ERROR("The scan line of %u pixels doesn't fit into 32 bits. Use sail_bytes_per_line64()", width);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INCORRECT_IMAGE_DIMENSIONS);
+    }
+
+    *result = (unsigned)bytes_per_line;
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_bytes_per_line64(unsigned width, enum SailPixelFormat pixel_format, uint64_t *result) {
+
     if (width == 0) {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
     }
@@ -729,18 +795,41 @@ sail_status_t sail_bytes_per_line(unsigned width, enum SailPixelFormat pixel_for
 
     const int add = bits_per_pixel % 8 == 0 ? 0 : 1;
 
-    *result = (unsigned)(((double)width * bits_per_pixel / 8) + add);
+    /* Cannot overflow as both the width and the bits per pixel are 32-bit. */
+    *result = (uint64_t)width * bits_per_pixel / 8 + add;
 
     return SAIL_OK;
 }
 
 sail_status_t sail_bytes_per_image(const struct sail_image *image, unsigned *result) {
 
+    SAIL_CHECK_RESULT_PTR(result);
+
+    uint64_t bytes_per_image;
+    SAIL_TRY(sail_bytes_per_image64(image, &bytes_per_image));
+
+    if (bytes_per_image > UINT_MAX) {
+        SAIL_LOG_ERROR("The image of %ux%u pixels doesn't fit into 32 bits. Use sail_bytes_per_image64()",
+                        image->width, image->height);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INCORRECT_IMAGE_DIMENSIONS);
+    }
+
+    *result = (unsigned)bytes_per_image;
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_bytes_per_image64(const struct sail_image *image, uint64_t *result) {
+
     SAIL_CHECK_IMAGE_PTR(image);
     SAIL_CHECK_RESULT_PTR(result);
 
-    unsigned bytes_per_line;
-    SAIL_TRY(sail_bytes_per_line(image->width, image->pixel_format, &bytes_per_line));
+    uint64_t bytes_per_line;
+    SAIL_TRY(sail_bytes_per_line64(image->width, image->pixel_format, &bytes_per_line));
+
+    if (image->height != 0 && bytes_per_line > UINT64_MAX / image->height) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INCORRECT_IMAGE_DIMENSIONS);
+    }
 
     *result = bytes_per_line * image->height;
 
@@ -766,11 +855,39 @@ sail_status_t sail_print_errno(const char *format) {
     return SAIL_OK;
 }
 
+sail_status_t sail_set_allocator(const struct sail_allocator *allocator) {
+
+    if (allocator == NULL) {
+        custom_allocator.malloc_func  = NULL;
+        custom_allocator.realloc_func = NULL;
+        custom_allocator.free_func    = NULL;
+        custom_allocator.user_data    = NULL;
+
+        return SAIL_OK;
+    }
+
+    if (allocator->malloc_func == NULL || allocator->realloc_func == NULL || allocator->free_func == NULL) {
+        SAIL_LOG_ERROR("All the allocator callbacks must be set");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    custom_allocator = *allocator;
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_malloc(size_t size, void **ptr) {
 
     SAIL_CHECK_PTR(ptr);
 
-    *ptr = malloc(size);
+    struct sail_arena *arena = sail_thread_arena();
+
+    if (arena != NULL) {
+        SAIL_TRY(sail_arena_malloc(arena, size, ptr));
+        return SAIL_OK;
+    }
+
+    *ptr = allocator_malloc(size);
 
     if (*ptr == NULL) {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
@@ -783,7 +900,14 @@ sail_status_t sail_realloc(size_t size, void **ptr) {
 
     SAIL_CHECK_PTR(ptr);
 
-    *ptr = realloc(*ptr, size);
+    struct sail_arena *arena = sail_thread_arena();
+
+    if (sail_arena_owns(arena, *ptr)) {
+        SAIL_TRY(sail_arena_realloc(arena, size, ptr));
+        return SAIL_OK;
+    }
+
+    *ptr = allocator_realloc(*ptr, size);
 
     if (*ptr == NULL) {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
@@ -796,18 +920,36 @@ sail_status_t sail_calloc(size_t nmemb, size_t size, void **ptr) {
 
     SAIL_CHECK_PTR(ptr);
 
-    *ptr = calloc(nmemb, size);
+    struct sail_arena *arena = sail_thread_arena();
 
-    if (*ptr == NULL) {
+    if (arena == NULL && custom_allocator.malloc_func == NULL) {
+        *ptr = calloc(nmemb, size);
+
+        if (*ptr == NULL) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
+        }
+
+        return SAIL_OK;
+    }
+
+    if (size != 0 && nmemb > SIZE_MAX / size) {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
     }
 
+    SAIL_TRY(sail_malloc(nmemb * size, ptr));
+    memset(*ptr, 0, nmemb * size);
+
     return SAIL_OK;
 }
 
 void sail_free(void *ptr) {
 
-    free(ptr);
+    /* Arena blocks are freed all at once with the arena. */
+    if (sail_arena_owns(sail_thread_arena(), ptr)) {
+        return;
+    }
+
+    allocator_free(ptr);
 }
 
 uint64_t sail_now(void) {
@@ -203,14 +203,34 @@ SAIL_EXPORT sail_status_t sail_bits_per_pixel(enum SailPixelFormat pixel_format,
  */
 SAIL_EXPORT sail_status_t sail_bytes_per_line(unsigned width, enum SailPixelFormat pixel_format, unsigned *result);
 
+/*
+ * Calculates the number of bytes per line needed to hold a scan line without padding
+ * like sail_bytes_per_line(). The result is 64-bit and never overflows.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_bytes_per_line64(unsigned width, enum SailPixelFormat pixel_format, uint64_t *result);
+
 /*
  * Calculates the number of bytes needed to hold an entire image in memory without padding.
  * It is effectively bytes per line * image height.
  *
+ * Images bigger than 4 GB don't fit into the result. Use sail_bytes_per_image64() for them.
+ *
  * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_INCORRECT_IMAGE_DIMENSIONS if the result doesn't fit into unsigned.
  */
 SAIL_EXPORT sail_status_t sail_bytes_per_image(const struct sail_image *image, unsigned *result);
 
+/*
+ * Calculates the number of bytes needed to hold an entire image in memory without padding
+ * like sail_bytes_per_image(). The result is 64-bit. Callers MUST check that it fits into size_t
+ * before allocating memory on 32-bit platforms.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_bytes_per_image64(const struct sail_image *image, uint64_t *result);
+
 /*
  * Prints the recent errno value with SAIL_LOG_ERROR(). The specified format must include '%s'.
  *
@@ -219,28 +239,58 @@ SAIL_EXPORT sail_status_t sail_bytes_per_image(const struct sail_image *image, u
 SAIL_EXPORT sail_status_t sail_print_errno(const char *format);
 
 /*
- * Interface to malloc().
+ * Custom memory allocation callbacks. user_data is passed to every callback as is.
+ */
+typedef void* (*sail_malloc_t)(void *user_data, size_t size);
+typedef void* (*sail_realloc_t)(void *user_data, void *ptr, size_t size);
+typedef void (*sail_free_t)(void *user_data, void *ptr);
+
+struct sail_allocator {
+
+    sail_malloc_t malloc_func;
+    sail_realloc_t realloc_func;
+    sail_free_t free_func;
+
+    void *user_data;
+};
+
+typedef struct sail_allocator sail_allocator_t;
+
+/*
+ * Installs custom memory allocation callbacks used by sail_malloc(), sail_realloc(), sail_calloc(),
+ * sail_free(), and arenas. Pass NULL to restore the system allocator. All the callbacks must be set.
+ *
+ * The allocator is global. It MUST be installed before any other SAIL function is called, and it MUST NOT
+ * be changed while memory allocated with the previous allocator is still in use.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_set_allocator(const struct sail_allocator *allocator);
+
+/*
+ * Interface to malloc(). Allocates from the current thread arena if it's set. See sail_set_thread_arena().
  *
  * Returns SAIL_OK on success.
  */
 SAIL_EXPORT sail_status_t sail_malloc(size_t size, void **ptr);
 
 /*
- * Interface to realloc().
+ * Interface to realloc(). Memory blocks allocated from the current thread arena are resized
+ * within the arena. Other memory blocks, including NULL, are always resized with the allocator.
  *
  * Returns SAIL_OK on success.
  */
 SAIL_EXPORT sail_status_t sail_realloc(size_t size, void **ptr);
 
 /*
- * Interface to calloc().
+ * Interface to calloc(). Allocates from the current thread arena if it's set.
  *
  * Returns SAIL_OK on success.
  */
 SAIL_EXPORT sail_status_t sail_calloc(size_t nmemb, size_t size, void **ptr);
 
 /*
- * Interface to free().
+ * Interface to free(). Does nothing for memory blocks allocated from the current thread arena.
  *
  * Returns SAIL_OK on success.
  */
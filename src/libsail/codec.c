@@ -38,6 +38,36 @@
 #include "sail-common.h"
 #include "sail.h"
 
+#ifdef SAIL_COMBINE_CODECS
+/* Externs from sail-codecs generated at build time. */
+#ifdef SAIL_STATIC
+extern const struct sail_codec_info * const sail_enabled_codecs_info[];
+extern const struct sail_codec_layout_v4 * const sail_enabled_codecs_layouts[];
+#else
+SAIL_IMPORT extern const struct sail_codec_info * const sail_enabled_codecs_info[];
+SAIL_IMPORT extern const struct sail_codec_layout_v4 * const sail_enabled_codecs_layouts[];
+#endif
+
+/*
+ * Private functions.
+ */
+
+static const struct sail_codec_layout_v4 *builtin_codec_layout(const struct sail_codec_info *codec_info) {
+
+    for (size_t i = 0; sail_enabled_codecs_info[i] != NULL; i++) {
+        if (sail_enabled_codecs_info[i] == codec_info) {
+            return sail_enabled_codecs_layouts[i];
+        }
+    }
+
+    return NULL;
+}
+#endif
+
+/*
+ * Public functions.
+ */
+
 sail_status_t alloc_and_load_codec(const struct sail_codec_info *codec_info, struct sail_codec **codec) {
 
     SAIL_CHECK_CODEC_INFO_PTR(codec_info);
@@ -54,7 +84,16 @@ sail_status_t alloc_and_load_codec(const struct sail_codec_info *codec_info, str
     codec_local->handle = NULL;
     codec_local->v4     = NULL;
 
-#ifndef SAIL_COMBINE_CODECS
+#ifdef SAIL_COMBINE_CODECS
+    /* Built-in codecs are linked in. Use their constant interfaces directly. */
+    const struct sail_codec_layout_v4 *builtin_layout = builtin_codec_layout(codec_info);
+
+    if (builtin_layout != NULL) {
+        codec_local->v4 = builtin_layout;
+        *codec = codec_local;
+        return SAIL_OK;
+    }
+#else
     SAIL_LOG_DEBUG("Loading codec '%s'", codec_info->path);
 #endif
 
@@ -120,7 +159,7 @@ sail_status_t alloc_and_load_codec(const struct sail_codec_info *codec_info, str
     #endif
 #endif
 
-#define SAIL_RESOLVE(target, handle, symbol, name)                                 \
+#define SAIL_RESOLVE_SYMBOL(target, handle, symbol, name, optional)                \
     {                                                                              \
         char *full_symbol_name;                                                    \
         SAIL_TRY_OR_CLEANUP(sail_concat(&full_symbol_name, 3, #symbol, "_", name), \
@@ -131,7 +170,7 @@ sail_status_t alloc_and_load_codec(const struct sail_codec_info *codec_info, str
                                                                                    \
         target = (symbol##_t)SAIL_RESOLVE_FUNC(handle, full_symbol_name);          \
                                                                                    \
-        if (target == NULL) {                                                      \
+        if (target == NULL && !(optional)) {                                       \
             SAIL_RESOLVE_LOG_ERROR(full_symbol_name);                              \
             sail_free(full_symbol_name);                                           \
             destroy_codec(codec_local);                                            \
@@ -141,22 +180,31 @@ sail_status_t alloc_and_load_codec(const struct sail_codec_info *codec_info, str
         sail_free(full_symbol_name);                                               \
     } do{} while(0)
 
+#define SAIL_RESOLVE(target, handle, symbol, name) \
+    SAIL_RESOLVE_SYMBOL(target, handle, symbol, name, false)
+
+/* Same as SAIL_RESOLVE, but leaves the target NULL if the symbol is not exported. */
+#define SAIL_RESOLVE_OPTIONAL(target, handle, symbol, name) \
+    SAIL_RESOLVE_SYMBOL(target, handle, symbol, name, true)
+
     if (codec_local->layout == SAIL_CODEC_LAYOUT_V4) {
         SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(struct sail_codec_layout_v4), &ptr),
                             /* cleanup */ destroy_codec(codec_local));
-        codec_local->v4 = ptr;
-
-        SAIL_RESOLVE(codec_local->v4->read_init,            handle, sail_codec_read_init_v4,            codec_info->name);
-        SAIL_RESOLVE(codec_local->v4->read_seek_next_frame, handle, sail_codec_read_seek_next_frame_v4, codec_info->name);
-        SAIL_RESOLVE(codec_local->v4->read_seek_next_pass,  handle, sail_codec_read_seek_next_pass_v4,  codec_info->name);
-        SAIL_RESOLVE(codec_local->v4->read_frame,           handle, sail_codec_read_frame_v4,           codec_info->name);
-        SAIL_RESOLVE(codec_local->v4->read_finish,          handle, sail_codec_read_finish_v4,          codec_info->name);
-
-        SAIL_RESOLVE(codec_local->v4->write_init,            handle, sail_codec_write_init_v4,            codec_info->name);
-        SAIL_RESOLVE(codec_local->v4->write_seek_next_frame, handle, sail_codec_write_seek_next_frame_v4, codec_info->name);
-        SAIL_RESOLVE(codec_local->v4->write_seek_next_pass,  handle, sail_codec_write_seek_next_pass_v4,  codec_info->name);
-        SAIL_RESOLVE(codec_local->v4->write_frame,           handle, sail_codec_write_frame_v4,           codec_info->name);
-        SAIL_RESOLVE(codec_local->v4->write_finish,          handle, sail_codec_write_finish_v4,          codec_info->name);
+        struct sail_codec_layout_v4 *v4 = ptr;
+        codec_local->v4 = v4;
+
+        SAIL_RESOLVE(v4->read_init,            handle, sail_codec_read_init_v4,            codec_info->name);
+        SAIL_RESOLVE(v4->read_seek_next_frame, handle, sail_codec_read_seek_next_frame_v4, codec_info->name);
+        SAIL_RESOLVE(v4->read_seek_next_pass,  handle, sail_codec_read_seek_next_pass_v4,  codec_info->name);
+        SAIL_RESOLVE(v4->read_frame,           handle, sail_codec_read_frame_v4,           codec_info->name);
+        SAIL_RESOLVE_OPTIONAL(v4->read_scan_lines, handle, sail_codec_read_scan_lines_v4, codec_info->name);
+        SAIL_RESOLVE(v4->read_finish,          handle, sail_codec_read_finish_v4,          codec_info->name);
+
+        SAIL_RESOLVE(v4->write_init,            handle, sail_codec_write_init_v4,            codec_info->name);
+        SAIL_RESOLVE(v4->write_seek_next_frame, handle, sail_codec_write_seek_next_frame_v4, codec_info->name);
+        SAIL_RESOLVE(v4->write_seek_next_pass,  handle, sail_codec_write_seek_next_pass_v4,  codec_info->name);
+        SAIL_RESOLVE(v4->write_frame,           handle, sail_codec_write_frame_v4,           codec_info->name);
+        SAIL_RESOLVE(v4->write_finish,          handle, sail_codec_write_finish_v4,          codec_info->name);
     } else {
         destroy_codec(codec_local);
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_CODEC_LAYOUT);
@@ -182,8 +230,22 @@ void destroy_codec(struct sail_codec *codec) {
 #else
         dlclose(codec->handle);
 #endif
+
+        /* Only interfaces resolved from a library are allocated. */
+        sail_free((void *)codec->v4);
     }
 
-    sail_free(codec->v4);
     sail_free(codec);
 }
+
+#ifdef SAIL_COMBINE_CODECS
+const struct sail_codec_info * const *builtin_codec_infos(void) {
+
+    return sail_enabled_codecs_info;
+}
+
+bool is_builtin_codec_info(const struct sail_codec_info *codec_info) {
+
+    return builtin_codec_layout(codec_info) != NULL;
+}
+#endif
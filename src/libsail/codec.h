@@ -26,6 +26,8 @@
 #ifndef SAIL_CODEC_H
 #define SAIL_CODEC_H
 
+#include <stdbool.h>
+
 #ifdef SAIL_BUILD
     #include "error.h"
     #include "export.h"
@@ -53,6 +55,8 @@ typedef sail_status_t (*sail_codec_read_init_v4_t)           (struct sail_io *io
 typedef sail_status_t (*sail_codec_read_seek_next_frame_v4_t)(void *state, struct sail_io *io, struct sail_image **image);
 typedef sail_status_t (*sail_codec_read_seek_next_pass_v4_t) (void *state, struct sail_io *io, struct sail_image *image);
 typedef sail_status_t (*sail_codec_read_frame_v4_t)          (void *state, struct sail_io *io, const struct sail_image *image);
+typedef sail_status_t (*sail_codec_read_scan_lines_v4_t)     (void *state, struct sail_io *io, const struct sail_image *image,
+                                                              void *scan_lines, unsigned scan_lines_count);
 typedef sail_status_t (*sail_codec_read_finish_v4_t)         (void **state, struct sail_io *io);
 
 typedef sail_status_t (*sail_codec_write_init_v4_t)           (struct sail_io *io, const struct sail_write_options *write_options, void **state);
@@ -66,6 +70,8 @@ struct sail_codec_layout_v4 {
     sail_codec_read_seek_next_frame_v4_t read_seek_next_frame;
     sail_codec_read_seek_next_pass_v4_t  read_seek_next_pass;
     sail_codec_read_frame_v4_t           read_frame;
+    /* Optional. NULL when the codec doesn't support SAIL_CODEC_FEATURE_SCAN_LINES. */
+    sail_codec_read_scan_lines_v4_t      read_scan_lines;
     sail_codec_read_finish_v4_t          read_finish;
 
     sail_codec_write_init_v4_t            write_init;
@@ -86,8 +92,8 @@ struct sail_codec {
     /* System-specific library handle. */
     void *handle;
 
-    /* Codec interface. */
-    struct sail_codec_layout_v4 *v4;
+    /* Codec interface. Points to a constant interface for the built-in codecs in "combine codecs" mode. */
+    const struct sail_codec_layout_v4 *v4;
 };
 
 typedef struct sail_codec sail_codec_t;
@@ -107,4 +113,17 @@ SAIL_HIDDEN sail_status_t alloc_and_load_codec(const struct sail_codec_info *cod
  */
 SAIL_HIDDEN void destroy_codec(struct sail_codec *codec);
 
+#ifdef SAIL_COMBINE_CODECS
+/*
+ * Returns a NULL-terminated list of constant codec info objects of the built-in codecs
+ * generated at build time. The objects must not be destroyed.
+ */
+SAIL_HIDDEN const struct sail_codec_info * const *builtin_codec_infos(void);
+
+/*
+ * Returns true if the specified codec info is a constant built-in codec info.
+ */
+SAIL_HIDDEN bool is_builtin_codec_info(const struct sail_codec_info *codec_info);
+#endif
+
 #endif
@@ -32,6 +32,50 @@
 #include "sail-common.h"
 #include "sail.h"
 
+/*
+ * Private functions.
+ */
+
+enum LookupKey {
+    LOOKUP_EXTENSION,
+    LOOKUP_MIME_TYPE,
+    LOOKUP_NAME,
+};
+
+static sail_status_t lookup_codec_info_in_context(const struct sail_context *context, enum LookupKey lookup_key,
+                                                    const char *key, const struct sail_codec_info **codec_info) {
+
+    const struct codec_info_index *codec_info_index = context->codec_info_index;
+
+    /* No index if the context failed to initialize. */
+    if (codec_info_index == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
+    }
+
+    const struct codec_info_hash_table *hash_table;
+
+    switch (lookup_key) {
+        case LOOKUP_EXTENSION: hash_table = &codec_info_index->extensions; break;
+        case LOOKUP_MIME_TYPE: hash_table = &codec_info_index->mime_types; break;
+        default:               hash_table = &codec_info_index->names;      break;
+    }
+
+    const struct sail_codec_info *found_codec_info = lookup_codec_info(hash_table, key);
+
+    if (found_codec_info == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
+    }
+
+    *codec_info = found_codec_info;
+    SAIL_LOG_DEBUG("Found codec info: '%s'", (*codec_info)->name);
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
 sail_status_t sail_codec_info_from_path(const char *path, const struct sail_codec_info **codec_info) {
 
     SAIL_CHECK_PATH_PTR(path);
@@ -68,16 +112,7 @@ sail_status_t sail_codec_info_by_magic_number_from_path(const char *path, const
 
 sail_status_t sail_codec_info_by_magic_number_from_mem(const void *buffer, size_t buffer_length, const struct sail_codec_info **codec_info) {
 
-    SAIL_CHECK_BUFFER_PTR(buffer);
-    SAIL_CHECK_CODEC_INFO_PTR(codec_info);
-
-    struct sail_io *io;
-    SAIL_TRY(alloc_io_read_mem(buffer, buffer_length, &io));
-
-    SAIL_TRY_OR_CLEANUP(sail_codec_info_by_magic_number_from_io(io, codec_info),
-                        /* cleanup */ sail_destroy_io(io));
-
-    sail_destroy_io(io);
+    SAIL_TRY(sail_codec_info_by_magic_number_from_bytes(buffer, buffer_length, codec_info));
 
     return SAIL_OK;
 }
@@ -87,59 +122,61 @@ sail_status_t sail_codec_info_by_magic_number_from_io(struct sail_io *io, const
     SAIL_CHECK_IO_PTR(io);
     SAIL_CHECK_CODEC_INFO_PTR(codec_info);
 
-    struct sail_context *context;
-    SAIL_TRY(current_tls_context(&context));
+    if ((io->features & SAIL_IO_FEATURE_NON_SEEKABLE) && io->read_at == NULL) {
+        SAIL_LOG_ERROR("Cannot rewind a non-seekable I/O source after reading its magic number. "
+                       "Pass NULL codec info to sail_start_reading_io() to detect the image format instead");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
 
     size_t nbytes;
     unsigned char buffer[SAIL_MAGIC_BUFFER_SIZE];
 
-    SAIL_TRY(io->read(io->stream, buffer, 1, SAIL_MAGIC_BUFFER_SIZE, &nbytes));
+    /* Positioned reads don't touch the I/O position, so there is no need to seek back. */
+    if (io->read_at == NULL) {
+        SAIL_TRY(io->read(io->stream, buffer, 1, SAIL_MAGIC_BUFFER_SIZE, &nbytes));
+    } else {
+        SAIL_TRY(io->read_at(io->stream, 0, buffer, SAIL_MAGIC_BUFFER_SIZE, &nbytes));
+    }
 
     if (nbytes != SAIL_MAGIC_BUFFER_SIZE) {
         SAIL_LOG_ERROR("Failed to read %d bytes from the I/O source", SAIL_MAGIC_BUFFER_SIZE);
         SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
     }
 
-    /* Seek back. */
-    SAIL_TRY(io->seek(io->stream, 0, SEEK_SET));
-
-    /* \xFF\xDD => "FF DD" + string terminator. */
-    char hex_numbers[SAIL_MAGIC_BUFFER_SIZE * 3 + 1];
-    char *hex_numbers_ptr = hex_numbers;
-
-    for (size_t i = 0; i < nbytes; i++, hex_numbers_ptr += 3) {
-#ifdef SAIL_WIN32
-        sprintf_s(hex_numbers_ptr, 4, "%02x ", buffer[i]);
-#else
-        sprintf(hex_numbers_ptr, "%02x ", buffer[i]);
-#endif
+    if (io->read_at == NULL) {
+        /* Seek back. */
+        SAIL_TRY(io->seek(io->stream, 0, SEEK_SET));
     }
 
-    hex_numbers_ptr--;
-    *hex_numbers_ptr = '\0';
+    SAIL_TRY(sail_codec_info_by_magic_number_from_bytes(buffer, nbytes, codec_info));
 
-    SAIL_LOG_DEBUG("Read magic number: '%s'", hex_numbers);
+    return SAIL_OK;
+}
+
+sail_status_t sail_codec_info_by_magic_number_from_bytes(const void *buffer, size_t buffer_length, const struct sail_codec_info **codec_info) {
 
-    /* Find the codec info. */
-    struct sail_codec_info_node *node = context->codec_info_node;
+    SAIL_CHECK_BUFFER_PTR(buffer);
+    SAIL_CHECK_CODEC_INFO_PTR(codec_info);
 
-    while (node != NULL) {
-        struct sail_string_node *string_node = node->codec_info->magic_number_node;
+    struct sail_context *context;
+    SAIL_TRY(current_tls_context(&context));
 
-        while (string_node != NULL) {
-            if (strncmp(hex_numbers, string_node->value, strlen(string_node->value)) == 0) {
-                *codec_info = node->codec_info;
-                SAIL_LOG_DEBUG("Found codec info: '%s'", (*codec_info)->name);
-                return SAIL_OK;
-            }
+    /* No index if the context failed to initialize. */
+    if (context->codec_info_index == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
+    }
 
-            string_node = string_node->next;
-        }
+    const struct sail_codec_info *found_codec_info =
+        lookup_codec_info_by_magic_number(&context->codec_info_index->magic_numbers, buffer, buffer_length);
 
-        node = node->next;
+    if (found_codec_info == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
     }
 
-    SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
+    *codec_info = found_codec_info;
+    SAIL_LOG_DEBUG("Found codec info: '%s'", (*codec_info)->name);
+
+    return SAIL_OK;
 }
 
 sail_status_t sail_codec_info_from_extension(const char *extension, const struct sail_codec_info **codec_info) {
@@ -152,33 +189,9 @@ sail_status_t sail_codec_info_from_extension(const char *extension, const struct
     struct sail_context *context;
     SAIL_TRY(current_tls_context(&context));
 
-    char *extension_copy;
-    SAIL_TRY(sail_strdup(extension, &extension_copy));
-
-    /* Will compare in lower case. */
-    sail_to_lower(extension_copy);
+    SAIL_TRY(lookup_codec_info_in_context(context, LOOKUP_EXTENSION, extension, codec_info));
 
-    struct sail_codec_info_node *node = context->codec_info_node;
-
-    while (node != NULL) {
-        struct sail_string_node *string_node = node->codec_info->extension_node;
-
-        while (string_node != NULL) {
-            if (strcmp(string_node->value, extension_copy) == 0) {
-                sail_free(extension_copy);
-                *codec_info = node->codec_info;
-                SAIL_LOG_DEBUG("Found codec info: '%s'", (*codec_info)->name);
-                return SAIL_OK;
-            }
-
-            string_node = string_node->next;
-        }
-
-        node = node->next;
-    }
-
-    sail_free(extension_copy);
-    SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
+    return SAIL_OK;
 }
 
 sail_status_t sail_codec_info_from_mime_type(const char *mime_type, const struct sail_codec_info **codec_info) {
@@ -191,31 +204,22 @@ sail_status_t sail_codec_info_from_mime_type(const char *mime_type, const struct
     struct sail_context *context;
     SAIL_TRY(current_tls_context(&context));
 
-    char *mime_type_copy;
-    SAIL_TRY(sail_strdup(mime_type, &mime_type_copy));
+    SAIL_TRY(lookup_codec_info_in_context(context, LOOKUP_MIME_TYPE, mime_type, codec_info));
 
-    /* Will compare in lower case. */
-    sail_to_lower(mime_type_copy);
+    return SAIL_OK;
+}
 
-    struct sail_codec_info_node *node = context->codec_info_node;
+sail_status_t sail_codec_info_from_name(const char *name, const struct sail_codec_info **codec_info) {
 
-    while (node != NULL) {
-        struct sail_string_node *string_node = node->codec_info->mime_type_node;
+    SAIL_CHECK_STRING_PTR(name);
+    SAIL_CHECK_CODEC_INFO_PTR(codec_info);
 
-        while (string_node != NULL) {
-            if (strcmp(string_node->value, mime_type_copy) == 0) {
-                sail_free(mime_type_copy);
-                *codec_info = node->codec_info;
-                SAIL_LOG_DEBUG("Found codec info: '%s'", (*codec_info)->name);
-                return SAIL_OK;
-            }
+    SAIL_LOG_DEBUG("Finding codec info for name '%s'", name);
 
-            string_node = string_node->next;
-        }
+    struct sail_context *context;
+    SAIL_TRY(current_tls_context(&context));
 
-        node = node->next;
-    }
+    SAIL_TRY(lookup_codec_info_in_context(context, LOOKUP_NAME, name, codec_info));
 
-    sail_free(mime_type_copy);
-    SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
+    return SAIL_OK;
 }
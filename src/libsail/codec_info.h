@@ -134,8 +134,10 @@ SAIL_EXPORT sail_status_t sail_codec_info_by_magic_number_from_mem(const void *b
 
 /*
  * Finds a first codec info object that supports the magic number read from the specified I/O data source.
- * The comparison algorithm is case insensitive. After reading a magic number, this function rewinds the I/O
- * cursor position back to the beginning. That's why the I/O source must be seekable.
+ * The comparison algorithm is case insensitive. If the I/O source supports positioned reads (sail_io.read_at),
+ * the magic number is read from the beginning without touching the I/O cursor position. Otherwise, this function
+ * rewinds the I/O cursor position back to the beginning after reading a magic number. That's why the I/O source
+ * must be seekable in this case. Use sail_start_reading_io() with NULL codec info to read non-seekable sources.
  *
  * The assigned codec info MUST NOT be destroyed. It is a pointer to an internal data structure.
  *
@@ -148,6 +150,24 @@ SAIL_EXPORT sail_status_t sail_codec_info_by_magic_number_from_mem(const void *b
  */
 SAIL_EXPORT sail_status_t sail_codec_info_by_magic_number_from_io(struct sail_io *io, const struct sail_codec_info **codec_info);
 
+/*
+ * Finds a first codec info object that supports the magic number in the specified bytes.
+ * Doesn't perform any I/O, so it's suitable for sniffing formats from already received data.
+ * Magic numbers are compiled into binary tables when the context is initialized and are matched
+ * against the raw bytes directly. Only the first SAIL_MAGIC_BUFFER_SIZE bytes are meaningful.
+ *
+ * The assigned codec info MUST NOT be destroyed. It is a pointer to an internal data structure.
+ *
+ * Typical usage: sail_codec_info_by_magic_number_from_bytes() ->
+ *                sail_start_reading_mem()                     ->
+ *                sail_read_next_frame()                       ->
+ *                sail_stop_reading().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_codec_info_by_magic_number_from_bytes(const void *buffer, size_t buffer_length,
+                                                                     const struct sail_codec_info **codec_info);
+
 /*
  * Finds a first codec info object that supports the specified file extension.
  * The comparison algorithm is case insensitive. For example: "jpg".
@@ -188,6 +208,26 @@ SAIL_EXPORT sail_status_t sail_codec_info_from_extension(const char *extension,
  */
 SAIL_EXPORT sail_status_t sail_codec_info_from_mime_type(const char *mime_type, const struct sail_codec_info **codec_info);
 
+/*
+ * Finds a codec info object by the specified codec name.
+ * The comparison algorithm is case insensitive. For example: "jpeg".
+ *
+ * The assigned codec info MUST NOT be destroyed. It is a pointer to an internal data structure.
+ *
+ * Typical usage: sail_codec_info_from_name() ->
+ *                sail_start_reading_file()   ->
+ *                sail_read_next_frame()      ->
+ *                sail_stop_reading().
+ *
+ * Or:            sail_codec_info_from_name() ->
+ *                sail_start_writing()        ->
+ *                sail_read_next_frame()      ->
+ *                sail_stop_writing().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_codec_info_from_name(const char *name, const struct sail_codec_info **codec_info);
+
 /* extern "C" */
 #ifdef __cplusplus
 }
@@ -0,0 +1,345 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "sail-common.h"
+#include "sail.h"
+
+/*
+ * Private functions.
+ */
+
+/* Case-insensitive FNV-1a hash. */
+static size_t hash_key(const char *key) {
+
+    size_t hash = 2166136261u;
+
+    for (; *key != '\0'; key++) {
+        hash ^= (size_t)tolower((unsigned char)*key);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static bool keys_equal(const char *key1, const char *key2) {
+
+    for (; *key1 != '\0' && *key2 != '\0'; key1++, key2++) {
+        if (tolower((unsigned char)*key1) != tolower((unsigned char)*key2)) {
+            return false;
+        }
+    }
+
+    return *key1 == *key2;
+}
+
+static size_t string_node_chain_length(const struct sail_string_node *string_node) {
+
+    size_t length = 0;
+
+    for (; string_node != NULL; string_node = string_node->next) {
+        length++;
+    }
+
+    return length;
+}
+
+static sail_status_t alloc_hash_table(size_t keys, struct codec_info_hash_table *hash_table) {
+
+    hash_table->entries  = NULL;
+    hash_table->capacity = 0;
+
+    if (keys == 0) {
+        return SAIL_OK;
+    }
+
+    /* Keep the load factor under 0.5 to have short probe sequences. */
+    size_t capacity = 8;
+
+    while (capacity < keys * 2) {
+        capacity *= 2;
+    }
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(capacity * sizeof(struct codec_info_index_entry), &ptr));
+    hash_table->entries  = ptr;
+    hash_table->capacity = capacity;
+
+    for (size_t i = 0; i < capacity; i++) {
+        hash_table->entries[i].key        = NULL;
+        hash_table->entries[i].codec_info = NULL;
+    }
+
+    return SAIL_OK;
+}
+
+static void insert_into_hash_table(struct codec_info_hash_table *hash_table, const char *key, const struct sail_codec_info *codec_info) {
+
+    if (key == NULL) {
+        return;
+    }
+
+    const size_t mask = hash_table->capacity - 1;
+
+    for (size_t i = hash_key(key) & mask; ; i = (i + 1) & mask) {
+        struct codec_info_index_entry *entry = &hash_table->entries[i];
+
+        if (entry->key == NULL) {
+            entry->key        = key;
+            entry->codec_info = codec_info;
+            return;
+        }
+
+        /* The first codec wins. */
+        if (keys_equal(entry->key, key)) {
+            return;
+        }
+    }
+}
+
+static void insert_string_node_chain(struct codec_info_hash_table *hash_table, const struct sail_string_node *string_node,
+                                        const struct sail_codec_info *codec_info) {
+
+    for (; string_node != NULL; string_node = string_node->next) {
+        insert_into_hash_table(hash_table, string_node->value, codec_info);
+    }
+}
+
+static int hex_digit(char c) {
+
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    } else {
+        return -1;
+    }
+}
+
+/* "ff d8" => \xFF\xD8. */
+static sail_status_t parse_magic_number(const char *str, struct codec_info_magic_number *magic_number) {
+
+    magic_number->length = 0;
+
+    while (*str != '\0') {
+        if (*str == ' ') {
+            str++;
+            continue;
+        }
+
+        const int high = hex_digit(str[0]);
+        const int low  = high < 0 ? -1 : hex_digit(str[1]);
+
+        if (low < 0 || (str[2] != ' ' && str[2] != '\0') || magic_number->length == SAIL_MAGIC_BUFFER_SIZE) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+        }
+
+        magic_number->bytes[magic_number->length++] = (unsigned char)(high << 4 | low);
+        str += 2;
+    }
+
+    if (magic_number->length == 0) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t alloc_magic_table(const struct sail_codec_info_node *codec_info_node, struct codec_info_magic_table *magic_table) {
+
+    magic_table->magic_numbers = NULL;
+
+    for (size_t i = 0; i <= 256; i++) {
+        magic_table->buckets[i] = 0;
+    }
+
+    size_t magic_numbers = 0;
+
+    for (const struct sail_codec_info_node *node = codec_info_node; node != NULL; node = node->next) {
+        magic_numbers += string_node_chain_length(node->codec_info->magic_number_node);
+    }
+
+    if (magic_numbers == 0) {
+        return SAIL_OK;
+    }
+
+    /* Parse magic numbers in the codecs order. */
+    void *ptr;
+    SAIL_TRY(sail_malloc(magic_numbers * sizeof(struct codec_info_magic_number), &ptr));
+    struct codec_info_magic_number *parsed = ptr;
+    size_t parsed_length = 0;
+
+    for (const struct sail_codec_info_node *node = codec_info_node; node != NULL; node = node->next) {
+        for (const struct sail_string_node *string_node = node->codec_info->magic_number_node; string_node != NULL; string_node = string_node->next) {
+            struct codec_info_magic_number *magic_number = &parsed[parsed_length];
+
+            if (parse_magic_number(string_node->value, magic_number) != SAIL_OK) {
+                SAIL_LOG_ERROR("Failed to parse magic number '%s' of the '%s' codec. Skipping it",
+                                string_node->value, node->codec_info->name);
+                continue;
+            }
+
+            magic_number->codec_info = node->codec_info;
+            magic_table->buckets[magic_number->bytes[0] + 1]++;
+            parsed_length++;
+        }
+    }
+
+    /* Stable counting sort by the first byte. */
+    SAIL_TRY_OR_CLEANUP(sail_malloc(magic_numbers * sizeof(struct codec_info_magic_number), &ptr),
+                        /* cleanup */ sail_free(parsed));
+    magic_table->magic_numbers = ptr;
+
+    for (size_t i = 1; i <= 256; i++) {
+        magic_table->buckets[i] += magic_table->buckets[i - 1];
+    }
+
+    size_t positions[256];
+
+    for (size_t i = 0; i < 256; i++) {
+        positions[i] = magic_table->buckets[i];
+    }
+
+    for (size_t i = 0; i < parsed_length; i++) {
+        magic_table->magic_numbers[positions[parsed[i].bytes[0]]++] = parsed[i];
+    }
+
+    sail_free(parsed);
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t alloc_codec_info_index(const struct sail_codec_info_node *codec_info_node, struct codec_info_index **codec_info_index) {
+
+    SAIL_CHECK_PTR(codec_info_index);
+
+    size_t extensions = 0;
+    size_t mime_types = 0;
+    size_t names      = 0;
+
+    for (const struct sail_codec_info_node *node = codec_info_node; node != NULL; node = node->next) {
+        extensions += string_node_chain_length(node->codec_info->extension_node);
+        mime_types += string_node_chain_length(node->codec_info->mime_type_node);
+        names++;
+    }
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct codec_info_index), &ptr));
+    struct codec_info_index *codec_info_index_local = ptr;
+
+    codec_info_index_local->extensions.entries = NULL;
+    codec_info_index_local->mime_types.entries = NULL;
+    codec_info_index_local->names.entries      = NULL;
+
+    codec_info_index_local->magic_numbers.magic_numbers = NULL;
+
+    SAIL_TRY_OR_CLEANUP(alloc_hash_table(extensions, &codec_info_index_local->extensions),
+                        /* cleanup */ destroy_codec_info_index(codec_info_index_local));
+    SAIL_TRY_OR_CLEANUP(alloc_hash_table(mime_types, &codec_info_index_local->mime_types),
+                        /* cleanup */ destroy_codec_info_index(codec_info_index_local));
+    SAIL_TRY_OR_CLEANUP(alloc_hash_table(names, &codec_info_index_local->names),
+                        /* cleanup */ destroy_codec_info_index(codec_info_index_local));
+    SAIL_TRY_OR_CLEANUP(alloc_magic_table(codec_info_node, &codec_info_index_local->magic_numbers),
+                        /* cleanup */ destroy_codec_info_index(codec_info_index_local));
+
+    for (const struct sail_codec_info_node *node = codec_info_node; node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+
+        insert_string_node_chain(&codec_info_index_local->extensions, codec_info->extension_node, codec_info);
+        insert_string_node_chain(&codec_info_index_local->mime_types, codec_info->mime_type_node, codec_info);
+        insert_into_hash_table(&codec_info_index_local->names, codec_info->name, codec_info);
+    }
+
+    *codec_info_index = codec_info_index_local;
+
+    return SAIL_OK;
+}
+
+void destroy_codec_info_index(struct codec_info_index *codec_info_index) {
+
+    if (codec_info_index == NULL) {
+        return;
+    }
+
+    sail_free(codec_info_index->extensions.entries);
+    sail_free(codec_info_index->mime_types.entries);
+    sail_free(codec_info_index->names.entries);
+    sail_free(codec_info_index->magic_numbers.magic_numbers);
+
+    sail_free(codec_info_index);
+}
+
+const struct sail_codec_info *lookup_codec_info(const struct codec_info_hash_table *hash_table, const char *key) {
+
+    if (hash_table->capacity == 0) {
+        return NULL;
+    }
+
+    const size_t mask = hash_table->capacity - 1;
+
+    for (size_t i = hash_key(key) & mask; ; i = (i + 1) & mask) {
+        const struct codec_info_index_entry *entry = &hash_table->entries[i];
+
+        if (entry->key == NULL) {
+            return NULL;
+        }
+
+        if (keys_equal(entry->key, key)) {
+            return entry->codec_info;
+        }
+    }
+}
+
+const struct sail_codec_info *lookup_codec_info_by_magic_number(const struct codec_info_magic_table *magic_table,
+                                                                const void *buffer, size_t buffer_length) {
+
+    if (buffer_length == 0) {
+        return NULL;
+    }
+
+    const unsigned char *bytes = buffer;
+
+    for (size_t i = magic_table->buckets[bytes[0]]; i < magic_table->buckets[bytes[0] + 1]; i++) {
+        const struct codec_info_magic_number *magic_number = &magic_table->magic_numbers[i];
+
+        if (magic_number->length <= buffer_length && memcmp(magic_number->bytes, bytes, magic_number->length) == 0) {
+            return magic_number->codec_info;
+        }
+    }
+
+    return NULL;
+}
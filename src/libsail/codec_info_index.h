@@ -0,0 +1,129 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_CODEC_INFO_INDEX_H
+#define SAIL_CODEC_INFO_INDEX_H
+
+#include <stddef.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+struct sail_codec_info;
+struct sail_codec_info_node;
+
+/*
+ * Hash table entry. The key points to a string inside the codec info.
+ */
+struct codec_info_index_entry {
+
+    const char *key;
+
+    const struct sail_codec_info *codec_info;
+};
+
+/*
+ * Open-addressing hash table with linear probing. Keys are hashed and compared case-insensitively.
+ */
+struct codec_info_hash_table {
+
+    /* NULL if the table is empty. */
+    struct codec_info_index_entry *entries;
+
+    /* The number of entries. Always a power of two. */
+    size_t capacity;
+};
+
+/*
+ * Binary magic number of a codec.
+ */
+struct codec_info_magic_number {
+
+    unsigned char bytes[SAIL_MAGIC_BUFFER_SIZE];
+
+    /* The number of meaningful bytes. */
+    size_t length;
+
+    const struct sail_codec_info *codec_info;
+};
+
+/*
+ * Binary magic numbers bucketed by their first byte.
+ */
+struct codec_info_magic_table {
+
+    /* Magic numbers sorted by the first byte. Codecs keep their order within a bucket. NULL if the table is empty. */
+    struct codec_info_magic_number *magic_numbers;
+
+    /* Magic numbers starting with byte B are in [buckets[B], buckets[B+1]). */
+    size_t buckets[256 + 1];
+};
+
+/*
+ * Lookup indexes of the codec info objects in a context. Built once when the context is initialized,
+ * so lookups need no memory allocations.
+ */
+struct codec_info_index {
+
+    struct codec_info_hash_table extensions;
+    struct codec_info_hash_table mime_types;
+    struct codec_info_hash_table names;
+
+    struct codec_info_magic_table magic_numbers;
+};
+
+/*
+ * Builds lookup indexes of the specified codec info list. When multiple codecs share a key,
+ * the first one in the list wins. The codec info objects must outlive the index.
+ * The assigned index MUST be destroyed later with destroy_codec_info_index().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t alloc_codec_info_index(const struct sail_codec_info_node *codec_info_node,
+                                                    struct codec_info_index **codec_info_index);
+
+/*
+ * Destroys the specified codec info index. Does nothing if the index is NULL.
+ */
+SAIL_HIDDEN void destroy_codec_info_index(struct codec_info_index *codec_info_index);
+
+/*
+ * Finds the codec info by the specified key case-insensitively. Returns NULL if the key is not found.
+ */
+SAIL_HIDDEN const struct sail_codec_info *lookup_codec_info(const struct codec_info_hash_table *hash_table, const char *key);
+
+/*
+ * Finds the first codec info which magic number is a prefix of the specified bytes. Returns NULL
+ * if no magic number matches.
+ */
+SAIL_HIDDEN const struct sail_codec_info *lookup_codec_info_by_magic_number(const struct codec_info_magic_table *magic_table,
+                                                                            const void *buffer, size_t buffer_length);
+
+#endif
@@ -305,7 +305,11 @@ static sail_status_t check_codec_info(const struct sail_codec_info *codec_info)
     return SAIL_OK;
 }
 
-static sail_status_t alloc_codec_info(struct sail_codec_info **codec_info) {
+/*
+ * Public functions.
+ */
+
+sail_status_t alloc_codec_info(struct sail_codec_info **codec_info) {
 
     SAIL_CHECK_CODEC_INFO_PTR(codec_info);
 
@@ -327,7 +331,7 @@ static sail_status_t alloc_codec_info(struct sail_codec_info **codec_info) {
     return SAIL_OK;
 }
 
-static void destroy_codec_info(struct sail_codec_info *codec_info) {
+void destroy_codec_info(struct sail_codec_info *codec_info) {
 
     if (codec_info == NULL) {
         return;
@@ -348,10 +352,6 @@ static void destroy_codec_info(struct sail_codec_info *codec_info) {
     sail_free(codec_info);
 }
 
-/*
- * Public functions.
- */
-
 sail_status_t alloc_codec_info_node(struct sail_codec_info_node **codec_info_node) {
 
     SAIL_CHECK_CODEC_INFO_NODE_PTR(codec_info_node);
@@ -373,7 +373,14 @@ void destroy_codec_info_node(struct sail_codec_info_node *codec_info_node) {
         return;
     }
 
+#ifdef SAIL_COMBINE_CODECS
+    /* Built-in codec info objects are constant. */
+    if (!is_builtin_codec_info(codec_info_node->codec_info)) {
+        destroy_codec_info(codec_info_node->codec_info);
+    }
+#else
     destroy_codec_info(codec_info_node->codec_info);
+#endif
     destroy_codec(codec_info_node->codec);
 
     sail_free(codec_info_node);
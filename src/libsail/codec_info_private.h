@@ -41,6 +41,19 @@ struct sail_codec_info;
  * Private codec info functions.
  */
 
+/*
+ * Allocates a new empty codec info. Read and write features are not allocated. The assigned codec info
+ * MUST be destroyed later with destroy_codec_info().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t alloc_codec_info(struct sail_codec_info **codec_info);
+
+/*
+ * Destroys the specified codec info and all its internal allocated memory buffers.
+ */
+SAIL_HIDDEN void destroy_codec_info(struct sail_codec_info *codec_info);
+
 /*
  * Allocates a new codec info node. The assigned node MUST be destroyed later
  * with destroy_codec_info_node().
@@ -0,0 +1,874 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef SAIL_WIN32
+    #include <windows.h> /* MoveFileEx */
+    #include <share.h>   /* _fsopen */
+#endif
+
+#include "sail-common.h"
+#include "sail.h"
+
+/*
+ * Cache layout. All values are stored in the native byte order as the cache is never shared between machines.
+ *
+ *   Header:
+ *     char[8]  magic
+ *     uint32   cache format version
+ *     uint32   SAIL version
+ *     int64    codecs directory modification time in nanoseconds
+ *     uint32   number of entries
+ *
+ *   Entry:
+ *     string   codec info file name
+ *     uint64   codec info file size
+ *     int64    codec info file modification time in nanoseconds
+ *     uint64   codec info file hash
+ *     string   codec file name
+ *     ...      codec info fields in the order they're declared in sail_codec_info
+ *
+ * Strings are stored as uint32 length followed by the characters without the terminating '\0'.
+ * Arrays and lists are stored as uint32 length followed by the elements.
+ *
+ * Modification times are only as precise as the platform reports them. Without sub-second
+ * precision, they're whole seconds converted into nanoseconds.
+ */
+#define SAIL_CODECS_CACHE_FILE_NAME "sail-codecs.cache"
+
+/* Increase every time the cache layout changes. */
+#define SAIL_CODECS_CACHE_FORMAT 2
+
+static const char SAIL_CODECS_CACHE_MAGIC[8] = "SAILCCH";
+
+/* The directory modification time and the number of entries are patched after the entries are written. */
+#define SAIL_CODECS_CACHE_DIR_MTIME_OFFSET 16
+#define SAIL_CODECS_CACHE_COUNT_OFFSET     24
+
+#define SAIL_NANOSECONDS_PER_SECOND INT64_C(1000000000)
+
+/* The length used to store NULL strings. */
+#define SAIL_CODECS_CACHE_NULL_STRING UINT32_MAX
+
+/*
+ * Private functions.
+ */
+
+struct cache_reader {
+
+    const unsigned char *data;
+    size_t size;
+    size_t pos;
+};
+
+static sail_status_t stat_path(const char *path, uint64_t *size, int64_t *mtime) {
+
+#ifdef SAIL_WIN32
+    struct __stat64 attrs;
+
+    if (_stat64(path, &attrs) != 0) {
+        SAIL_LOG_DEBUG("Failed to get the attributes of '%s'", path);
+        return SAIL_ERROR_OPEN_FILE;
+    }
+#else
+    struct stat attrs;
+
+    if (stat(path, &attrs) != 0) {
+        SAIL_LOG_DEBUG("Failed to get the attributes of '%s'", path);
+        return SAIL_ERROR_OPEN_FILE;
+    }
+#endif
+
+    *size  = (uint64_t)attrs.st_size;
+    *mtime = (int64_t)attrs.st_mtime * SAIL_NANOSECONDS_PER_SECOND;
+
+#if defined(SAIL_HAVE_STAT_ST_MTIM)
+    *mtime += attrs.st_mtim.tv_nsec;
+#elif defined(SAIL_HAVE_STAT_ST_MTIMESPEC)
+    *mtime += attrs.st_mtimespec.tv_nsec;
+#endif
+
+    return SAIL_OK;
+}
+
+/* 64-bit FNV-1a. */
+static uint64_t hash_bytes(const void *data, size_t size) {
+
+    const unsigned char *bytes = data;
+    uint64_t hash = UINT64_C(14695981039346656037);
+
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= UINT64_C(1099511628211);
+    }
+
+    return hash;
+}
+
+static sail_status_t hash_file(const char *path, uint64_t *hash) {
+
+    struct file_mapping *file_mapping;
+    SAIL_TRY(map_file(path, &file_mapping));
+
+    *hash = hash_bytes(file_mapping->data, file_mapping->size);
+
+    unmap_file(file_mapping);
+
+    return SAIL_OK;
+}
+
+static sail_status_t open_file(const char *path, const char *mode, FILE **fptr) {
+
+#ifdef SAIL_WIN32
+    *fptr = _fsopen(path, mode, _SH_DENYWR);
+#else
+    *fptr = fopen(path, mode);
+#endif
+
+    if (*fptr == NULL) {
+        sail_print_errno("Failed to open the codecs cache: %s");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_OPEN_FILE);
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t replace_file(const char *source, const char *target) {
+
+#ifdef SAIL_WIN32
+    if (!MoveFileExA(source, target, MOVEFILE_REPLACE_EXISTING)) {
+        SAIL_LOG_ERROR("Failed to move '%s' to '%s'. Error: %d", source, target, GetLastError());
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_WRITE_IO);
+    }
+#else
+    if (rename(source, target) != 0) {
+        sail_print_errno("Failed to rename the codecs cache: %s");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_WRITE_IO);
+    }
+#endif
+
+    return SAIL_OK;
+}
+
+/*
+ * Writing.
+ */
+
+static sail_status_t write_bytes(FILE *fptr, const void *data, size_t size) {
+
+    if (size > 0 && fwrite(data, size, 1, fptr) != 1) {
+        sail_print_errno("Failed to write the codecs cache: %s");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_WRITE_IO);
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t write_u32(FILE *fptr, uint32_t value) {
+
+    SAIL_TRY(write_bytes(fptr, &value, sizeof(value)));
+
+    return SAIL_OK;
+}
+
+static sail_status_t write_i32(FILE *fptr, int value) {
+
+    const int32_t value32 = value;
+    SAIL_TRY(write_bytes(fptr, &value32, sizeof(value32)));
+
+    return SAIL_OK;
+}
+
+static sail_status_t write_u64(FILE *fptr, uint64_t value) {
+
+    SAIL_TRY(write_bytes(fptr, &value, sizeof(value)));
+
+    return SAIL_OK;
+}
+
+static sail_status_t write_i64(FILE *fptr, int64_t value) {
+
+    SAIL_TRY(write_bytes(fptr, &value, sizeof(value)));
+
+    return SAIL_OK;
+}
+
+static sail_status_t write_f64(FILE *fptr, double value) {
+
+    SAIL_TRY(write_bytes(fptr, &value, sizeof(value)));
+
+    return SAIL_OK;
+}
+
+static sail_status_t write_string(FILE *fptr, const char *str) {
+
+    if (str == NULL) {
+        SAIL_TRY(write_u32(fptr, SAIL_CODECS_CACHE_NULL_STRING));
+        return SAIL_OK;
+    }
+
+    const size_t length = strlen(str);
+
+    SAIL_TRY(write_u32(fptr, (uint32_t)length));
+    SAIL_TRY(write_bytes(fptr, str, length));
+
+    return SAIL_OK;
+}
+
+static sail_status_t write_ints(FILE *fptr, const int *values, unsigned length) {
+
+    SAIL_TRY(write_u32(fptr, length));
+
+    for (unsigned i = 0; i < length; i++) {
+        SAIL_TRY(write_i32(fptr, values[i]));
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t write_string_list(FILE *fptr, const struct sail_string_node *string_node) {
+
+    uint32_t length = 0;
+
+    for (const struct sail_string_node *node = string_node; node != NULL; node = node->next) {
+        length++;
+    }
+
+    SAIL_TRY(write_u32(fptr, length));
+
+    for (const struct sail_string_node *node = string_node; node != NULL; node = node->next) {
+        SAIL_TRY(write_string(fptr, node->value));
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t write_read_features(FILE *fptr, const struct sail_read_features *read_features) {
+
+    SAIL_TRY(write_ints(fptr, (const int *)read_features->output_pixel_formats, read_features->output_pixel_formats_length));
+    SAIL_TRY(write_i32(fptr, read_features->default_output_pixel_format));
+    SAIL_TRY(write_i32(fptr, read_features->features));
+
+    return SAIL_OK;
+}
+
+static sail_status_t write_write_features(FILE *fptr, const struct sail_write_features *write_features) {
+
+    uint32_t length = 0;
+
+    for (const struct sail_pixel_formats_mapping_node *node = write_features->pixel_formats_mapping_node; node != NULL; node = node->next) {
+        length++;
+    }
+
+    SAIL_TRY(write_u32(fptr, length));
+
+    for (const struct sail_pixel_formats_mapping_node *node = write_features->pixel_formats_mapping_node; node != NULL; node = node->next) {
+        SAIL_TRY(write_i32(fptr, node->input_pixel_format));
+        SAIL_TRY(write_ints(fptr, (const int *)node->output_pixel_formats, node->output_pixel_formats_length));
+    }
+
+    SAIL_TRY(write_i32(fptr, write_features->features));
+    SAIL_TRY(write_i32(fptr, write_features->properties));
+    SAIL_TRY(write_i32(fptr, write_features->interlaced_passes));
+    SAIL_TRY(write_ints(fptr, (const int *)write_features->compressions, write_features->compressions_length));
+    SAIL_TRY(write_i32(fptr, write_features->default_compression));
+    SAIL_TRY(write_f64(fptr, write_features->compression_level_min));
+    SAIL_TRY(write_f64(fptr, write_features->compression_level_max));
+    SAIL_TRY(write_f64(fptr, write_features->compression_level_default));
+    SAIL_TRY(write_f64(fptr, write_features->compression_level_step));
+
+    return SAIL_OK;
+}
+
+static sail_status_t write_entry(FILE *fptr, const char *codec_info_file_name, const char *codec_info_full_path,
+                                    const struct sail_codec_info *codec_info) {
+
+    uint64_t size;
+    int64_t mtime;
+    uint64_t hash;
+
+    SAIL_TRY(stat_path(codec_info_full_path, &size, &mtime));
+    SAIL_TRY(hash_file(codec_info_full_path, &hash));
+
+    /* "/path/jpeg.so" -> "jpeg.so". */
+#ifdef SAIL_WIN32
+    const char *codec_file_name = strrchr(codec_info->path, '\\');
+#else
+    const char *codec_file_name = strrchr(codec_info->path, '/');
+#endif
+    codec_file_name = (codec_file_name == NULL) ? codec_info->path : codec_file_name + 1;
+
+    SAIL_TRY(write_string(fptr, codec_info_file_name));
+    SAIL_TRY(write_u64(fptr, size));
+    SAIL_TRY(write_i64(fptr, mtime));
+    SAIL_TRY(write_u64(fptr, hash));
+    SAIL_TRY(write_string(fptr, codec_file_name));
+
+    SAIL_TRY(write_i32(fptr, codec_info->layout));
+    SAIL_TRY(write_string(fptr, codec_info->version));
+    SAIL_TRY(write_string(fptr, codec_info->name));
+    SAIL_TRY(write_string(fptr, codec_info->description));
+    SAIL_TRY(write_string_list(fptr, codec_info->magic_number_node));
+    SAIL_TRY(write_string_list(fptr, codec_info->extension_node));
+    SAIL_TRY(write_string_list(fptr, codec_info->mime_type_node));
+    SAIL_TRY(write_read_features(fptr, codec_info->read_features));
+    SAIL_TRY(write_write_features(fptr, codec_info->write_features));
+
+    return SAIL_OK;
+}
+
+static sail_status_t write_cache(FILE *fptr, const char *codecs_path, const struct sail_string_node *codec_info_file_node) {
+
+    SAIL_TRY(write_bytes(fptr, SAIL_CODECS_CACHE_MAGIC, sizeof(SAIL_CODECS_CACHE_MAGIC)));
+    SAIL_TRY(write_u32(fptr, SAIL_CODECS_CACHE_FORMAT));
+    SAIL_TRY(write_u32(fptr, SAIL_VERSION));
+    SAIL_TRY(write_i64(fptr, /* patched later */ 0));
+    SAIL_TRY(write_u32(fptr, /* patched later */ 0));
+
+    uint32_t count = 0;
+
+    for (const struct sail_string_node *node = codec_info_file_node; node != NULL; node = node->next) {
+        char *full_path;
+        SAIL_TRY(build_full_path(codecs_path, node->value, &full_path));
+
+        /* Skip broken codec info files just like the regular enumeration does. */
+        struct sail_codec_info_node *codec_info_node;
+
+        if (build_codec_from_codec_info(full_path, &codec_info_node) != SAIL_OK) {
+            SAIL_LOG_ERROR("Skipping the broken codec info '%s'", full_path);
+            sail_free(full_path);
+            continue;
+        }
+
+        SAIL_TRY_OR_CLEANUP(write_entry(fptr, node->value, full_path, codec_info_node->codec_info),
+                            /* cleanup */ destroy_codec_info_node(codec_info_node),
+                                          sail_free(full_path));
+
+        SAIL_LOG_DEBUG("Cached codec info '%s'", node->value);
+
+        destroy_codec_info_node(codec_info_node);
+        sail_free(full_path);
+        count++;
+    }
+
+    if (fseek(fptr, SAIL_CODECS_CACHE_COUNT_OFFSET, SEEK_SET) != 0) {
+        sail_print_errno("Failed to seek the codecs cache: %s");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    SAIL_TRY(write_u32(fptr, count));
+
+    return SAIL_OK;
+}
+
+/*
+ * Writing the cache into the codecs directory updates the directory modification time,
+ * so it's saved into the already renamed cache file. Rewriting a file in place doesn't
+ * touch the directory modification time.
+ */
+static sail_status_t patch_dir_mtime(const char *cache_path, const char *codecs_path) {
+
+    uint64_t size;
+    int64_t mtime;
+    SAIL_TRY(stat_path(codecs_path, &size, &mtime));
+
+    FILE *fptr;
+    SAIL_TRY(open_file(cache_path, "r+b", &fptr));
+
+    if (fseek(fptr, SAIL_CODECS_CACHE_DIR_MTIME_OFFSET, SEEK_SET) != 0) {
+        sail_print_errno("Failed to seek the codecs cache: %s");
+        fclose(fptr);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    SAIL_TRY_OR_CLEANUP(write_i64(fptr, mtime),
+                        /* cleanup */ fclose(fptr));
+
+    if (fclose(fptr) != 0) {
+        sail_print_errno("Failed to close the codecs cache: %s");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CLOSE_IO);
+    }
+
+    return SAIL_OK;
+}
+
+/*
+ * Reading.
+ */
+
+static sail_status_t read_bytes(struct cache_reader *reader, void *data, size_t size) {
+
+    if (reader->size - reader->pos < size) {
+        SAIL_LOG_ERROR("The codecs cache is truncated");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+    }
+
+    memcpy(data, reader->data + reader->pos, size);
+    reader->pos += size;
+
+    return SAIL_OK;
+}
+
+static sail_status_t read_u32(struct cache_reader *reader, uint32_t *value) {
+
+    SAIL_TRY(read_bytes(reader, value, sizeof(*value)));
+
+    return SAIL_OK;
+}
+
+static sail_status_t read_i32(struct cache_reader *reader, int *value) {
+
+    int32_t value32;
+    SAIL_TRY(read_bytes(reader, &value32, sizeof(value32)));
+
+    *value = value32;
+
+    return SAIL_OK;
+}
+
+static sail_status_t read_u64(struct cache_reader *reader, uint64_t *value) {
+
+    SAIL_TRY(read_bytes(reader, value, sizeof(*value)));
+
+    return SAIL_OK;
+}
+
+static sail_status_t read_i64(struct cache_reader *reader, int64_t *value) {
+
+    SAIL_TRY(read_bytes(reader, value, sizeof(*value)));
+
+    return SAIL_OK;
+}
+
+static sail_status_t read_f64(struct cache_reader *reader, double *value) {
+
+    SAIL_TRY(read_bytes(reader, value, sizeof(*value)));
+
+    return SAIL_OK;
+}
+
+/*
+ * Strings are copied out of the cache as it's unmapped right after loading, and the codec info
+ * objects built from it are destroyed with destroy_codec_info() just like the parsed ones.
+ */
+static sail_status_t read_string(struct cache_reader *reader, char **str) {
+
+    uint32_t length;
+    SAIL_TRY(read_u32(reader, &length));
+
+    if (length == SAIL_CODECS_CACHE_NULL_STRING) {
+        *str = NULL;
+        return SAIL_OK;
+    }
+
+    if (reader->size - reader->pos < length) {
+        SAIL_LOG_ERROR("The codecs cache is truncated");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+    }
+
+    if (length == 0) {
+        SAIL_TRY(sail_strdup("", str));
+    } else {
+        SAIL_TRY(sail_strdup_length((const char *)reader->data + reader->pos, length, str));
+    }
+
+    reader->pos += length;
+
+    return SAIL_OK;
+}
+
+static sail_status_t read_ints(struct cache_reader *reader, int **values, unsigned *length) {
+
+    uint32_t length32;
+    SAIL_TRY(read_u32(reader, &length32));
+
+    if ((reader->size - reader->pos) / sizeof(int32_t) < length32) {
+        SAIL_LOG_ERROR("The codecs cache is truncated");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+    }
+
+    *values = NULL;
+    *length = 0;
+
+    if (length32 == 0) {
+        return SAIL_OK;
+    }
+
+    void *ptr;
+    SAIL_TRY(sail_malloc((size_t)length32 * sizeof(int), &ptr));
+    *values = ptr;
+    *length = length32;
+
+    for (uint32_t i = 0; i < length32; i++) {
+        SAIL_TRY(read_i32(reader, *values + i));
+    }
+
+    return SAIL_OK;
+}
+
+/* The chain is always assigned, even partially read. Its owner must destroy it on error. */
+static sail_status_t read_string_list(struct cache_reader *reader, struct sail_string_node **string_node) {
+
+    uint32_t length;
+    SAIL_TRY(read_u32(reader, &length));
+
+    struct sail_string_node **last_string_node = string_node;
+
+    for (uint32_t i = 0; i < length; i++) {
+        struct sail_string_node *node;
+        SAIL_TRY(alloc_string_node(&node));
+
+        *last_string_node = node;
+        last_string_node = &node->next;
+
+        SAIL_TRY(read_string(reader, &node->value));
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t read_read_features(struct cache_reader *reader, struct sail_read_features *read_features) {
+
+    SAIL_TRY(read_ints(reader, (int **)&read_features->output_pixel_formats, &read_features->output_pixel_formats_length));
+    SAIL_TRY(read_i32(reader, (int *)&read_features->default_output_pixel_format));
+    SAIL_TRY(read_i32(reader, &read_features->features));
+
+    return SAIL_OK;
+}
+
+static sail_status_t read_write_features(struct cache_reader *reader, struct sail_write_features *write_features) {
+
+    uint32_t length;
+    SAIL_TRY(read_u32(reader, &length));
+
+    struct sail_pixel_formats_mapping_node **last_mapping_node = &write_features->pixel_formats_mapping_node;
+
+    for (uint32_t i = 0; i < length; i++) {
+        struct sail_pixel_formats_mapping_node *node;
+        SAIL_TRY(sail_alloc_pixel_formats_mapping_node(&node));
+
+        *last_mapping_node = node;
+        last_mapping_node = &node->next;
+
+        SAIL_TRY(read_i32(reader, (int *)&node->input_pixel_format));
+        SAIL_TRY(read_ints(reader, (int **)&node->output_pixel_formats, &node->output_pixel_formats_length));
+    }
+
+    SAIL_TRY(read_i32(reader, &write_features->features));
+    SAIL_TRY(read_i32(reader, &write_features->properties));
+    SAIL_TRY(read_i32(reader, &write_features->interlaced_passes));
+    SAIL_TRY(read_ints(reader, (int **)&write_features->compressions, &write_features->compressions_length));
+    SAIL_TRY(read_i32(reader, (int *)&write_features->default_compression));
+    SAIL_TRY(read_f64(reader, &write_features->compression_level_min));
+    SAIL_TRY(read_f64(reader, &write_features->compression_level_max));
+    SAIL_TRY(read_f64(reader, &write_features->compression_level_default));
+    SAIL_TRY(read_f64(reader, &write_features->compression_level_step));
+
+    return SAIL_OK;
+}
+
+/* Partially read fields are destroyed by the caller with destroy_codec_info(). */
+static sail_status_t read_codec_info_fields(struct cache_reader *reader, struct sail_codec_info *codec_info) {
+
+    SAIL_TRY(read_i32(reader, &codec_info->layout));
+    SAIL_TRY(read_string(reader, &codec_info->version));
+    SAIL_TRY(read_string(reader, &codec_info->name));
+    SAIL_TRY(read_string(reader, &codec_info->description));
+    SAIL_TRY(read_string_list(reader, &codec_info->magic_number_node));
+    SAIL_TRY(read_string_list(reader, &codec_info->extension_node));
+    SAIL_TRY(read_string_list(reader, &codec_info->mime_type_node));
+
+    SAIL_TRY(sail_alloc_read_features(&codec_info->read_features));
+    SAIL_TRY(read_read_features(reader, codec_info->read_features));
+
+    SAIL_TRY(sail_alloc_write_features(&codec_info->write_features));
+    SAIL_TRY(read_write_features(reader, codec_info->write_features));
+
+    if (codec_info->layout != SAIL_CODEC_LAYOUT_V4) {
+        SAIL_LOG_ERROR("Unsupported codec layout version %d in the codecs cache", codec_info->layout);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_CODEC_LAYOUT);
+    }
+
+    return SAIL_OK;
+}
+
+/*
+ * Checks the cached codec info file attributes against the file on disk. cache_mtime is the time
+ * the cache was written.
+ */
+static sail_status_t check_codec_info_file(const char *codecs_path, const char *codec_info_file_name,
+                                            uint64_t cached_size, int64_t cached_mtime, uint64_t cached_hash,
+                                            int64_t cache_mtime) {
+
+    char *full_path;
+    SAIL_TRY(build_full_path(codecs_path, codec_info_file_name, &full_path));
+
+    uint64_t size;
+    int64_t mtime;
+    SAIL_TRY_OR_CLEANUP(stat_path(full_path, &size, &mtime),
+                        /* cleanup */ sail_free(full_path));
+
+    if (size != cached_size) {
+        SAIL_LOG_DEBUG("Codec info '%s' has been changed since the codecs cache was built", full_path);
+        sail_free(full_path);
+        return SAIL_ERROR_OUTDATED_CODECS_CACHE;
+    }
+
+    /*
+     * The file has been touched, or it could have been changed within the same second the cache
+     * was written and the modification time is not precise enough to tell. Compare the contents.
+     */
+    if (mtime != cached_mtime || mtime / SAIL_NANOSECONDS_PER_SECOND >= cache_mtime / SAIL_NANOSECONDS_PER_SECOND) {
+        uint64_t hash;
+        SAIL_TRY_OR_CLEANUP(hash_file(full_path, &hash),
+                            /* cleanup */ sail_free(full_path));
+
+        if (hash != cached_hash) {
+            SAIL_LOG_DEBUG("Codec info '%s' has been changed since the codecs cache was built", full_path);
+            sail_free(full_path);
+            return SAIL_ERROR_OUTDATED_CODECS_CACHE;
+        }
+    }
+
+    sail_free(full_path);
+
+    return SAIL_OK;
+}
+
+static sail_status_t read_entry(struct cache_reader *reader, const char *codecs_path, int64_t cache_mtime,
+                                struct sail_codec_info_node **codec_info_node) {
+
+    char *codec_info_file_name;
+    uint64_t size;
+    int64_t mtime;
+    uint64_t hash;
+
+    SAIL_TRY(read_string(reader, &codec_info_file_name));
+
+    if (codec_info_file_name == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+    }
+
+    SAIL_TRY_OR_CLEANUP(read_u64(reader, &size),
+                        /* cleanup */ sail_free(codec_info_file_name));
+    SAIL_TRY_OR_CLEANUP(read_i64(reader, &mtime),
+                        /* cleanup */ sail_free(codec_info_file_name));
+    SAIL_TRY_OR_CLEANUP(read_u64(reader, &hash),
+                        /* cleanup */ sail_free(codec_info_file_name));
+    SAIL_TRY_OR_CLEANUP(check_codec_info_file(codecs_path, codec_info_file_name, size, mtime, hash, cache_mtime),
+                        /* cleanup */ sail_free(codec_info_file_name));
+
+    sail_free(codec_info_file_name);
+
+    char *codec_file_name;
+    SAIL_TRY(read_string(reader, &codec_file_name));
+
+    if (codec_file_name == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+    }
+
+    struct sail_codec_info *codec_info;
+    SAIL_TRY_OR_CLEANUP(alloc_codec_info(&codec_info),
+                        /* cleanup */ sail_free(codec_file_name));
+
+    SAIL_TRY_OR_CLEANUP(build_full_path(codecs_path, codec_file_name, &codec_info->path),
+                        /* cleanup */ destroy_codec_info(codec_info),
+                                      sail_free(codec_file_name));
+
+    sail_free(codec_file_name);
+
+    SAIL_TRY_OR_CLEANUP(read_codec_info_fields(reader, codec_info),
+                        /* cleanup */ destroy_codec_info(codec_info));
+
+    SAIL_TRY_OR_CLEANUP(alloc_codec_info_node(codec_info_node),
+                        /* cleanup */ destroy_codec_info(codec_info));
+
+    (*codec_info_node)->codec_info = codec_info;
+
+    return SAIL_OK;
+}
+
+static sail_status_t read_cache(struct cache_reader *reader, const char *codecs_path, struct sail_codec_info_node **codec_info_node) {
+
+    char magic[sizeof(SAIL_CODECS_CACHE_MAGIC)];
+    uint32_t format;
+    uint32_t version;
+    int64_t dir_mtime;
+    uint32_t count;
+
+    SAIL_TRY(read_bytes(reader, magic, sizeof(magic)));
+    SAIL_TRY(read_u32(reader, &format));
+    SAIL_TRY(read_u32(reader, &version));
+    SAIL_TRY(read_i64(reader, &dir_mtime));
+    SAIL_TRY(read_u32(reader, &count));
+
+    if (memcmp(magic, SAIL_CODECS_CACHE_MAGIC, sizeof(magic)) != 0 || format != SAIL_CODECS_CACHE_FORMAT) {
+        SAIL_LOG_ERROR("Unsupported codecs cache format");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+    }
+
+    if (version != SAIL_VERSION) {
+        SAIL_LOG_DEBUG("The codecs cache was built by another SAIL version");
+        return SAIL_ERROR_OUTDATED_CODECS_CACHE;
+    }
+
+    /* Codec info files have been added, removed, or renamed. */
+    uint64_t size;
+    int64_t current_dir_mtime;
+    SAIL_TRY(stat_path(codecs_path, &size, &current_dir_mtime));
+
+    if (current_dir_mtime != dir_mtime) {
+        SAIL_LOG_DEBUG("Codecs directory '%s' has been changed since the codecs cache was built", codecs_path);
+        return SAIL_ERROR_OUTDATED_CODECS_CACHE;
+    }
+
+    *codec_info_node = NULL;
+    struct sail_codec_info_node **last_codec_info_node = codec_info_node;
+
+    for (uint32_t i = 0; i < count; i++) {
+        struct sail_codec_info_node *node;
+        SAIL_TRY_OR_CLEANUP(read_entry(reader, codecs_path, dir_mtime, &node),
+                            /* cleanup */ destroy_codec_info_node_chain(*codec_info_node),
+                                          *codec_info_node = NULL);
+
+        *last_codec_info_node = node;
+        last_codec_info_node = &node->next;
+    }
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t load_codecs_cache(const char *codecs_path, struct sail_codec_info_node ***last_codec_info_node) {
+
+    SAIL_CHECK_PATH_PTR(codecs_path);
+    SAIL_CHECK_CODEC_INFO_NODE_PTR(last_codec_info_node);
+
+    char *cache_path;
+    SAIL_TRY(build_full_path(codecs_path, SAIL_CODECS_CACHE_FILE_NAME, &cache_path));
+
+    if (!sail_is_file(cache_path)) {
+        SAIL_LOG_DEBUG("Codecs cache '%s' doesn't exist", cache_path);
+        sail_free(cache_path);
+        return SAIL_ERROR_OPEN_FILE;
+    }
+
+    struct file_mapping *file_mapping;
+    SAIL_TRY_OR_CLEANUP(map_file(cache_path, &file_mapping),
+                        /* cleanup */ sail_free(cache_path));
+
+    struct cache_reader reader = { file_mapping->data, file_mapping->size, 0 };
+    struct sail_codec_info_node *codec_info_node;
+
+    const sail_status_t status = read_cache(&reader, codecs_path, &codec_info_node);
+
+    unmap_file(file_mapping);
+
+    if (status != SAIL_OK) {
+        SAIL_LOG_DEBUG("Codecs cache '%s' is outdated or invalid. Run sail-codecs-cache to update it", cache_path);
+        sail_free(cache_path);
+        return status;
+    }
+
+    SAIL_LOG_DEBUG("Loaded codecs from the cache '%s'", cache_path);
+    sail_free(cache_path);
+
+    /* Append the loaded codec info objects. */
+    **last_codec_info_node = codec_info_node;
+
+    while (**last_codec_info_node != NULL) {
+        *last_codec_info_node = &(**last_codec_info_node)->next;
+    }
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_update_codecs_cache(const char *codecs_path) {
+
+    SAIL_CHECK_PATH_PTR(codecs_path);
+
+    char *cache_path;
+    SAIL_TRY(build_full_path(codecs_path, SAIL_CODECS_CACHE_FILE_NAME, &cache_path));
+
+    char *temp_cache_path;
+    SAIL_TRY_OR_CLEANUP(sail_concat(&temp_cache_path, 2, cache_path, ".tmp"),
+                        /* cleanup */ sail_free(cache_path));
+
+    struct sail_string_node *codec_info_file_node;
+    SAIL_TRY_OR_CLEANUP(enumerate_codec_info_files(codecs_path, &codec_info_file_node),
+                        /* cleanup */ sail_free(temp_cache_path),
+                                      sail_free(cache_path));
+
+    /* Write into a temporary file first so readers never see a partially written cache. */
+    FILE *fptr;
+    SAIL_TRY_OR_CLEANUP(open_file(temp_cache_path, "wb", &fptr),
+                        /* cleanup */ destroy_string_node_chain(codec_info_file_node),
+                                      sail_free(temp_cache_path),
+                                      sail_free(cache_path));
+
+    SAIL_TRY_OR_CLEANUP(write_cache(fptr, codecs_path, codec_info_file_node),
+                        /* cleanup */ fclose(fptr),
+                                      remove(temp_cache_path),
+                                      destroy_string_node_chain(codec_info_file_node),
+                                      sail_free(temp_cache_path),
+                                      sail_free(cache_path));
+
+    destroy_string_node_chain(codec_info_file_node);
+
+    if (fclose(fptr) != 0) {
+        sail_print_errno("Failed to close the codecs cache: %s");
+        remove(temp_cache_path);
+        sail_free(temp_cache_path);
+        sail_free(cache_path);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CLOSE_IO);
+    }
+
+    SAIL_TRY_OR_CLEANUP(replace_file(temp_cache_path, cache_path),
+                        /* cleanup */ remove(temp_cache_path),
+                                      sail_free(temp_cache_path),
+                                      sail_free(cache_path));
+
+    sail_free(temp_cache_path);
+
+    SAIL_TRY_OR_CLEANUP(patch_dir_mtime(cache_path, codecs_path),
+                        /* cleanup */ remove(cache_path),
+                                      sail_free(cache_path));
+
+    SAIL_LOG_INFO("Updated the codecs cache '%s'", cache_path);
+    sail_free(cache_path);
+
+    return SAIL_OK;
+}
@@ -0,0 +1,69 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_CODECS_CACHE_H
+#define SAIL_CODECS_CACHE_H
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Codecs cache.
+ *
+ * Enumerating codecs requires listing the codecs directory and parsing every codec info file in it.
+ * To speed up the initialization, SAIL could load a binary cache of the parsed codec info files
+ * from the codecs directory instead. The cache is named "sail-codecs.cache" and it's memory-mapped
+ * when loaded.
+ *
+ * The cache is validated against the modification time of the codecs directory, the SAIL version,
+ * and the size, modification time, and hash of every cached codec info file. If the cache is missing
+ * or outdated, SAIL silently falls back to parsing codec info files. SAIL never updates the cache
+ * implicitly. Use sail_update_codecs_cache() or the sail-codecs-cache tool after installing or
+ * updating codecs.
+ */
+
+/*
+ * Parses all codec info files in the specified directory and writes the codecs cache into it.
+ * The directory must be writable.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_update_codecs_cache(const char *codecs_path);
+
+/* extern "C" */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
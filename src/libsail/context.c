@@ -54,20 +54,10 @@ sail_status_t sail_unload_codecs(void) {
     struct sail_context *context;
     SAIL_TRY(current_tls_context(&context));
 
-    struct sail_codec_info_node *node = context->codec_info_node;
-    int counter = 0;
+    unsigned counter;
+    SAIL_TRY(unload_context_codecs(context, &counter));
 
-    while (node != NULL) {
-        if (node->codec != NULL) {
-            destroy_codec(node->codec);
-            node->codec = NULL;
-            counter++;
-        }
-
-        node = node->next;
-    }
-
-    SAIL_LOG_DEBUG("Unloaded codecs: %d", counter);
+    SAIL_LOG_DEBUG("Unloaded codecs: %u", counter);
 
     return SAIL_OK;
 }
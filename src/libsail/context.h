@@ -46,6 +46,11 @@ extern "C" {
  *
  * If you call SAIL functions from three different threads, three different contexts are allocated.
  * You MUST destroy them with calling sail_finish() in each thread.
+ *
+ * Alternatively, threads could share a single process-wide context. Call sail_init_with_flags(SAIL_FLAG_SHARED_CONTEXT)
+ * once, and all the threads that don't have a context yet attach to the shared context instead of enumerating
+ * codecs again. The shared context is reference-counted. Every thread still MUST call sail_finish() to detach from it.
+ * The shared context is destroyed when the last thread detaches from it.
  */
 
 /*
@@ -57,6 +62,20 @@ enum SailInitFlags {
      * Preload all codecs in sail_init_with_flags(). Codecs are lazy-loaded by default.
      */
     SAIL_FLAG_PRELOAD_CODECS = 1 << 0,
+
+    /*
+     * Attach the current thread to the process-wide shared context instead of allocating a thread-local one.
+     * The shared context is allocated and initialized with the rest of the flags if it doesn't exist yet.
+     * Once it exists, other threads attach to it implicitly.
+     */
+    SAIL_FLAG_SHARED_CONTEXT = 1 << 1,
+
+    /*
+     * Preload all codecs in background threads. sail_init_with_flags() returns right away. Reading or writing
+     * functions that need a codec which is still being loaded wait for that codec only. Takes precedence
+     * over SAIL_FLAG_PRELOAD_CODECS.
+     */
+    SAIL_FLAG_PRELOAD_CODECS_ASYNC = 1 << 2,
 };
 
 /*
@@ -92,6 +111,9 @@ SAIL_EXPORT sail_status_t sail_init_with_flags(int flags);
  * Unloads all codecs. All pointers to codec info objects, read and write features get invalidated. 
  * Using them after calling sail_finish() will lead to a crash.
  *
+ * If the current thread is attached to the shared context, detaches it. The shared context is destroyed
+ * when the last thread detaches from it.
+ *
  * It's possible to initialize a new SAIL thread-local static context afterwards, implicitly or explicitly.
  */
 SAIL_EXPORT void sail_finish(void);
@@ -103,6 +125,8 @@ SAIL_EXPORT void sail_finish(void);
  *
  * Typical usage: This is a standalone function that can be called at any time.
  *
+ * Does nothing if the current thread is attached to the shared context which is used by other threads.
+ *
  * Returns SAIL_OK on success.
  */
 SAIL_EXPORT sail_status_t sail_unload_codecs(void);
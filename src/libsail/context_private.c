@@ -34,7 +34,6 @@
 #ifdef SAIL_WIN32
     #include <windows.h> /* FindFirstFile */
 #else
-    #include <dlfcn.h> /* dlsym */
     #include <dirent.h> /* opendir */
     #include <sys/types.h>
 #endif
@@ -239,6 +238,24 @@ static sail_status_t update_lib_path(const char *codecs_path) {
     return SAIL_OK;
 }
 
+/* Appends a new string node with a copy of the value to the end of the chain. */
+static sail_status_t append_string_node(const char *value, struct sail_string_node ***last_string_node) {
+
+    SAIL_CHECK_STRING_PTR(value);
+    SAIL_CHECK_STRING_NODE_PTR(last_string_node);
+
+    struct sail_string_node *string_node;
+    SAIL_TRY(alloc_string_node(&string_node));
+
+    SAIL_TRY_OR_CLEANUP(sail_strdup(value, &string_node->value),
+                        /* cleanup */ destroy_string_node(string_node));
+
+    **last_string_node = string_node;
+    *last_string_node = &string_node->next;
+
+    return SAIL_OK;
+}
+
 static sail_status_t alloc_context(struct sail_context **context) {
 
     SAIL_CHECK_CONTEXT_PTR(context);
@@ -246,83 +263,190 @@ static sail_status_t alloc_context(struct sail_context **context) {
     void *ptr;
     SAIL_TRY(sail_malloc(sizeof(struct sail_context), &ptr));
 
-    *context = ptr;
+    struct sail_context *new_context = ptr;
+
+    SAIL_TRY_OR_CLEANUP(init_mutex(&new_context->codecs_mutex),
+                        /* cleanup */ sail_free(new_context));
+    SAIL_TRY_OR_CLEANUP(init_cond(&new_context->codecs_cond),
+                        /* cleanup */ destroy_mutex(&new_context->codecs_mutex),
+                                      sail_free(new_context));
+
+    new_context->initialized           = false;
+    new_context->shared                = false;
+    new_context->references            = 0;
+    new_context->codecs_loading        = NULL;
+    new_context->preload_threads       = NULL;
+    new_context->preload_threads_count = 0;
+    new_context->preload_next_node     = NULL;
+    new_context->preload_next_index    = 0;
+    new_context->codec_info_node       = NULL;
+    new_context->codec_info_index      = NULL;
 
-    (*context)->initialized      = false;
-    (*context)->codec_info_node = NULL;
+    *context = new_context;
 
     return SAIL_OK;
 }
 
-static sail_status_t build_full_path(const char *sail_codecs_path, const char *name, char **full_path) {
+/*
+ * Loads the codec of the specified node if it's not loaded yet. The index is the node position in the list.
+ * Optionally returns the loaded codec.
+ */
+static sail_status_t load_codec_of_node(struct sail_context *context, struct sail_codec_info_node *codec_info_node, size_t index,
+                                        const struct sail_codec **codec) {
 
-#ifdef SAIL_WIN32
-    SAIL_TRY(sail_concat(full_path, 3, sail_codecs_path, "\\", name));
-#else
-    SAIL_TRY(sail_concat(full_path, 3, sail_codecs_path, "/", name));
-#endif
+    lock_mutex(&context->codecs_mutex);
 
-    return SAIL_OK;
+    /* Another thread is loading this codec. Wait for it. */
+    while (context->codecs_loading[index]) {
+        wait_cond(&context->codecs_cond, &context->codecs_mutex);
+    }
+
+    if (codec_info_node->codec != NULL) {
+        if (codec != NULL) {
+            *codec = codec_info_node->codec;
+        }
+
+        unlock_mutex(&context->codecs_mutex);
+        return SAIL_OK;
+    }
+
+    /* Load the codec without holding the lock, so other codecs could be loaded in parallel. */
+    context->codecs_loading[index] = true;
+    unlock_mutex(&context->codecs_mutex);
+
+    struct sail_codec *loaded_codec = NULL;
+    const sail_status_t status = alloc_and_load_codec(codec_info_node->codec_info, &loaded_codec);
+
+    lock_mutex(&context->codecs_mutex);
+
+    codec_info_node->codec = loaded_codec;
+    context->codecs_loading[index] = false;
+
+    if (codec != NULL && loaded_codec != NULL) {
+        *codec = loaded_codec;
+    }
+
+    broadcast_cond(&context->codecs_cond);
+    unlock_mutex(&context->codecs_mutex);
+
+    return status;
 }
 
-static sail_status_t build_codec_from_codec_info(const char *codec_info_full_path,
-                                                    struct sail_codec_info_node **codec_info_node) {
+/* Background preloading thread. Loads codecs one by one until no codecs left. */
+static void preload_codecs_thread(void *arg) {
 
-    SAIL_CHECK_PATH_PTR(codec_info_full_path);
-    SAIL_CHECK_CODEC_INFO_PTR(codec_info_node);
+    struct sail_context *context = arg;
 
-    /* Build "/path/jpeg.so" from "/path/jpeg.codec.info". */
-    char *codec_info_part = strstr(codec_info_full_path, ".codec.info");
+    while (true) {
+        lock_mutex(&context->codecs_mutex);
 
-    if (codec_info_part == NULL) {
-        SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
+        struct sail_codec_info_node *codec_info_node = context->preload_next_node;
+        const size_t index = context->preload_next_index;
+
+        if (codec_info_node != NULL) {
+            context->preload_next_node = codec_info_node->next;
+            context->preload_next_index++;
+        }
+
+        unlock_mutex(&context->codecs_mutex);
+
+        if (codec_info_node == NULL) {
+            break;
+        }
+
+        /* Ignore loading errors on purpose. */
+        load_codec_of_node(context, codec_info_node, index, NULL);
     }
+}
 
-    /* The length of "/path/jpeg". */
-    size_t codec_full_path_length = strlen(codec_info_full_path) - strlen(codec_info_part);
-    char *codec_full_path;
+/* Starts preloading all codecs in background threads. */
+static sail_status_t start_preloading_codecs(struct sail_context *context) {
 
-#ifdef SAIL_WIN32
-    static const char * const LIB_SUFFIX = "dll";
-#else
-    static const char * const LIB_SUFFIX = "so";
-#endif
+    unsigned codecs = 0;
 
-    /* The resulting string will be "/path/jpeg.plu" (on Windows) or "/path/jpeg.pl". */
-    SAIL_TRY(sail_strdup_length(codec_info_full_path,
-                                codec_full_path_length + strlen(LIB_SUFFIX) + 1, &codec_full_path));
+    for (struct sail_codec_info_node *node = context->codec_info_node; node != NULL; node = node->next) {
+        codecs++;
+    }
 
-#ifdef SAIL_WIN32
-    /* Overwrite the end of the path with "dll". */
-    strcpy_s(codec_full_path + codec_full_path_length + 1, strlen(LIB_SUFFIX) + 1, LIB_SUFFIX);
-#else
-    /* Overwrite the end of the path with "so". */
-    strcpy(codec_full_path + codec_full_path_length + 1, LIB_SUFFIX);
-#endif
+    /* Loading codecs is mostly I/O bound, so a few threads are enough. */
+    unsigned threads = cpu_count();
 
-    /* Parse codec info. */
-    SAIL_TRY_OR_CLEANUP(alloc_codec_info_node(codec_info_node),
-                        sail_free(codec_full_path));
+    if (threads > 4) {
+        threads = 4;
+    }
+    if (threads > codecs) {
+        threads = codecs;
+    }
 
-    struct sail_codec_info *codec_info;
-    SAIL_TRY_OR_CLEANUP(codec_read_info_from_file(codec_info_full_path, &codec_info),
-                        destroy_codec_info_node(*codec_info_node),
-                        sail_free(codec_full_path));
+    if (threads == 0) {
+        return SAIL_OK;
+    }
 
-    /* Save the parsed codec info into the SAIL context. */
-    (*codec_info_node)->codec_info = codec_info;
-    codec_info->path = codec_full_path;
+    SAIL_LOG_DEBUG("Preloading codecs in %u background threads", threads);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(threads * sizeof(sail_thread_t), &ptr));
+    context->preload_threads = ptr;
+
+    context->preload_next_node  = context->codec_info_node;
+    context->preload_next_index = 0;
+
+    for (unsigned i = 0; i < threads; i++) {
+        if (create_thread(&context->preload_threads[i], preload_codecs_thread, context) != SAIL_OK) {
+            /* The started threads still preload all codecs. Lazy loading covers the rest anyway. */
+            break;
+        }
+
+        context->preload_threads_count++;
+    }
 
     return SAIL_OK;
 }
 
+/* Cancels preloading codecs in background threads and waits for them to finish. */
+static void stop_preloading_codecs(struct sail_context *context) {
+
+    if (context->preload_threads == NULL) {
+        return;
+    }
+
+    lock_mutex(&context->codecs_mutex);
+    context->preload_next_node = NULL;
+    unlock_mutex(&context->codecs_mutex);
+
+    for (unsigned i = 0; i < context->preload_threads_count; i++) {
+        join_thread(context->preload_threads[i]);
+    }
+
+    sail_free(context->preload_threads);
+    context->preload_threads       = NULL;
+    context->preload_threads_count = 0;
+}
+
+/* Destroys the codec info list and everything built from it. The context becomes uninitialized. */
+static void destroy_context_codec_info(struct sail_context *context) {
+
+    stop_preloading_codecs(context);
+
+    destroy_codec_info_index(context->codec_info_index);
+    destroy_codec_info_node_chain(context->codec_info_node);
+    sail_free(context->codecs_loading);
+
+    context->initialized      = false;
+    context->codecs_loading   = NULL;
+    context->codec_info_node  = NULL;
+    context->codec_info_index = NULL;
+}
+
 static sail_status_t destroy_context(struct sail_context *context) {
 
     if (context == NULL) {
         return SAIL_OK;
     }
 
-    destroy_codec_info_node_chain(context->codec_info_node);
+    destroy_context_codec_info(context);
+    destroy_cond(&context->codecs_cond);
+    destroy_mutex(&context->codecs_mutex);
     sail_free(context);
 
     return SAIL_OK;
@@ -335,21 +459,16 @@ static sail_status_t preload_codecs(struct sail_context *context) {
 
     SAIL_LOG_DEBUG("Preloading codecs");
 
-    struct sail_codec_info_node *codec_info_node = context->codec_info_node;
-
-    while (codec_info_node != NULL) {
-        const struct sail_codec *codec;
+    size_t index = 0;
 
+    for (struct sail_codec_info_node *node = context->codec_info_node; node != NULL; node = node->next, index++) {
         /* Ignore loading errors on purpose. */
-        load_codec_by_codec_info(codec_info_node->codec_info, &codec);
-
-        codec_info_node = codec_info_node->next;
+        load_codec_of_node(context, node, index, NULL);
     }
 
     return SAIL_OK;
 }
 
-/* Preload all codecs. */
 static sail_status_t print_enumerated_codecs(struct sail_context *context) {
 
     SAIL_CHECK_CONTEXT_PTR(context);
@@ -385,38 +504,28 @@ static sail_status_t enumerate_codecs_in_paths(struct sail_context *context, con
 
         SAIL_TRY(update_lib_path(codecs_path));
 
-        SAIL_LOG_DEBUG("Enumerating codecs in '%s'", codecs_path);
-
-#ifdef SAIL_WIN32
-        const char *plugs_info_mask = "\\*.codec.info";
-
-        size_t codecs_path_with_mask_length = strlen(codecs_path) + strlen(plugs_info_mask) + 1;
-
-        void *ptr;
-        SAIL_TRY(sail_malloc(codecs_path_with_mask_length, &ptr));
-        char *codecs_path_with_mask = ptr;
+        /* Try the codecs cache first. It's much faster than parsing codec info files. */
+        if (load_codecs_cache(codecs_path, &last_codec_info_node) == SAIL_OK) {
+            continue;
+        }
 
-        strcpy_s(codecs_path_with_mask, codecs_path_with_mask_length, codecs_path);
-        strcat_s(codecs_path_with_mask, codecs_path_with_mask_length, plugs_info_mask);
+        SAIL_LOG_DEBUG("Enumerating codecs in '%s'", codecs_path);
 
-        WIN32_FIND_DATA data;
-        HANDLE hFind = FindFirstFile(codecs_path_with_mask, &data);
+        struct sail_string_node *codec_info_file_node;
 
-        if (hFind == INVALID_HANDLE_VALUE) {
-            SAIL_LOG_ERROR("Failed to list files in '%s'. Error: %d. No codecs loaded from it", codecs_path, GetLastError());
-            sail_free(codecs_path_with_mask);
-            continue;
-        }
+        /* Ignore errors and try to load as much as possible. */
+        SAIL_TRY_OR_EXECUTE(enumerate_codec_info_files(codecs_path, &codec_info_file_node),
+                            /* on error */ continue);
 
-        do {
+        for (struct sail_string_node *node = codec_info_file_node; node != NULL; node = node->next) {
             /* Build a full path. */
             char *full_path;
 
             /* Ignore errors and try to load as much as possible. */
-            SAIL_TRY_OR_EXECUTE(build_full_path(codecs_path, data.cFileName, &full_path),
+            SAIL_TRY_OR_EXECUTE(build_full_path(codecs_path, node->value, &full_path),
                                 /* on error */ continue);
 
-            SAIL_LOG_DEBUG("Found codec info '%s'", data.cFileName);
+            SAIL_LOG_DEBUG("Found codec info '%s'", node->value);
 
             if (build_codec_from_codec_info(full_path, &codec_info_node) == SAIL_OK) {
                 *last_codec_info_node = codec_info_node;
@@ -424,51 +533,9 @@ static sail_status_t enumerate_codecs_in_paths(struct sail_context *context, con
             }
 
             sail_free(full_path);
-        } while (FindNextFile(hFind, &data));
-
-        if (GetLastError() != ERROR_NO_MORE_FILES) {
-            SAIL_LOG_ERROR("Failed to list files in '%s'. Error: %d. Some codecs may not be loaded from it", codecs_path, GetLastError());
-        }
-
-        sail_free(codecs_path_with_mask);
-        FindClose(hFind);
-#else
-        DIR *d = opendir(codecs_path);
-
-        if (d == NULL) {
-            SAIL_LOG_ERROR("Failed to list files in '%s': %s", codecs_path, strerror(errno));
-            continue;
         }
 
-        struct dirent *dir;
-
-        while ((dir = readdir(d)) != NULL) {
-            /* Build a full path. */
-            char *full_path;
-
-            /* Ignore errors and try to load as much as possible. */
-            SAIL_TRY_OR_EXECUTE(build_full_path(codecs_path, dir->d_name, &full_path),
-                                /* on error */ continue);
-
-            /* Handle files only. */
-            if (sail_is_file(full_path)) {
-                bool is_codec_info = strstr(full_path, ".codec.info") != NULL;
-
-                if (is_codec_info) {
-                    SAIL_LOG_DEBUG("Found codec info '%s'", dir->d_name);
-
-                    if (build_codec_from_codec_info(full_path, &codec_info_node) == SAIL_OK) {
-                        *last_codec_info_node = codec_info_node;
-                        last_codec_info_node = &codec_info_node->next;
-                    }
-                }
-            }
-
-            sail_free(full_path);
-        }
-
-        closedir(d);
-#endif
+        destroy_string_node_chain(codec_info_file_node);
     }
 
     return SAIL_OK;
@@ -480,103 +547,20 @@ static sail_status_t init_context_impl(struct sail_context *context) {
 
     SAIL_CHECK_CONTEXT_PTR(context);
 
-#ifdef SAIL_WIN32
-#ifdef SAIL_STATIC
-    HMODULE handle = GetModuleHandle(NULL);
-#else
-    HMODULE handle = GetModuleHandle("sail-codecs");
-#endif
-
-    if (handle == NULL) {
-        SAIL_LOG_ERROR("Failed to get module handle. Error: %d", GetLastError());
-        SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_SYMBOL_RESOLVE);
-    }
-#else
-    void *handle = dlopen(NULL, RTLD_LAZY | RTLD_LOCAL);
-
-    if (handle == NULL) {
-        SAIL_LOG_ERROR("Failed to open the current executable: %s", dlerror());
-        SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_SYMBOL_RESOLVE);
-    }
-#endif
-
-    /* Extern from sail-codecs. For example: "gif;jpeg;png". */
-#ifdef SAIL_STATIC
-    extern const char *sail_enabled_codecs;
-#else
-    SAIL_IMPORT extern const char *sail_enabled_codecs;
-#endif
-
-    /* Load codec info objects. */
+    /* Built-in codec info objects are generated at build time. Nothing to parse or resolve. */
     struct sail_codec_info_node **last_codec_info_node = &context->codec_info_node;
 
-    struct sail_string_node *string_node = NULL;
-
-    /* Split "gif;jpeg;png" into "gif", "jpeg", "png". */
-    SAIL_TRY_OR_CLEANUP(split_into_string_node_chain(sail_enabled_codecs, &string_node),
-                        /* cleanup */ destroy_string_node_chain(string_node));
-
-    struct sail_string_node *node = string_node;
-
-    while (node != NULL) {
-        /* Construct "sail_codec_info_gif". */
-        char *sail_codec_info_var_name;
-        SAIL_TRY_OR_CLEANUP(sail_concat(&sail_codec_info_var_name, 2, "sail_codec_info_", node->value),
-                            /* cleanup */ destroy_string_node_chain(string_node));
-
-    /* Resolve sail_codec_info_gif. */
-#ifdef SAIL_WIN32
-        FARPROC sail_codec_info_sym = GetProcAddress(handle, sail_codec_info_var_name);
-
-        if (sail_codec_info_sym == NULL) {
-            SAIL_LOG_ERROR("Failed to resolve '%s'. Error: %d", sail_codec_info_var_name, GetLastError());
-        }
-#else
-        void *sail_codec_info_sym = dlsym(handle, sail_codec_info_var_name);
-
-        if (sail_codec_info_sym == NULL) {
-            SAIL_LOG_ERROR("Failed to resolve '%s'. Error: %s", sail_codec_info_var_name, dlerror());
-        }
-#endif
-
-        sail_free(sail_codec_info_var_name);
-
-        if (sail_codec_info_sym == NULL) {
-            node = node->next;
-            continue;
-        }
-
-        const char **sail_codec_info_var = (const char **)sail_codec_info_sym;
-
-        /* Parse codec info. */
+    for (const struct sail_codec_info * const *codec_info = builtin_codec_infos(); *codec_info != NULL; codec_info++) {
         struct sail_codec_info_node *codec_info_node;
-        if (alloc_codec_info_node(&codec_info_node) != SAIL_OK) {
-            node = node->next;
-            continue;
-        }
-
-        struct sail_codec_info *codec_info;
-        if (codec_read_info_from_string(*sail_codec_info_var, &codec_info) != SAIL_OK) {
-            destroy_codec_info_node(codec_info_node);
-            node = node->next;
-            continue;
-        };
+        SAIL_TRY(alloc_codec_info_node(&codec_info_node));
 
-        /* Save the parsed codec info into the SAIL context. */
-        codec_info_node->codec_info = codec_info;
+        /* The object is never modified or destroyed. See destroy_codec_info_node(). */
+        codec_info_node->codec_info = (struct sail_codec_info *)*codec_info;
 
         *last_codec_info_node = codec_info_node;
         last_codec_info_node = &codec_info_node->next;
-
-        node = node->next;
     }
 
-#ifndef SAIL_WIN32
-    dlclose(handle);
-#endif
-
-    destroy_string_node_chain(string_node);
-
     /* Add our lib path in standalone mode. */
 #ifndef SAIL_VCPKG
     SAIL_TRY(update_lib_path(sail_codecs_path()));
@@ -610,29 +594,35 @@ static sail_status_t init_context_impl(struct sail_context *context) {
 }
 #endif
 
-static void print_no_codecs_found(void) {
+/* Allocates the per-codec loading flags. */
+static sail_status_t alloc_codecs_loading(struct sail_context *context) {
 
-    const char *message = "\n\n*** No codecs were found. Please check the installation directory. ***"
-#if defined SAIL_UNIX && defined SAIL_COMBINE_CODECS
-        "\n*** Additionally, please make sure the application is compiled with -rdynamic ***"
-        "\n*** or an equivalent. If you use CMake, this could be achieved by setting     ***"
-        "\n*** CMAKE_ENABLE_EXPORTS to ON. ***"
-#endif
-        "\n";
+    size_t codecs = 0;
 
-    SAIL_LOG_ERROR("%s", message);
+    for (struct sail_codec_info_node *node = context->codec_info_node; node != NULL; node = node->next) {
+        codecs++;
+    }
+
+    void *ptr;
+    SAIL_TRY(sail_malloc((codecs > 0 ? codecs : 1) * sizeof(bool), &ptr));
+    context->codecs_loading = ptr;
+
+    for (size_t i = 0; i < codecs; i++) {
+        context->codecs_loading[i] = false;
+    }
+
+    return SAIL_OK;
 }
 
-/* Initializes the context and loads all the codec info files if the context is not initialized. */
-static sail_status_t init_context(struct sail_context *context, int flags) {
+static void print_no_codecs_found(void) {
 
-    SAIL_CHECK_CONTEXT_PTR(context);
+    const char *message = "\n\n*** No codecs were found. Please check the installation directory. ***\n";
 
-    if (context->initialized) {
-        return SAIL_OK;
-    }
+    SAIL_LOG_ERROR("%s", message);
+}
 
-    context->initialized = true;
+/* Loads all the codec info files into the context. */
+static sail_status_t load_context_codec_info(struct sail_context *context, int flags) {
 
     /* Time counter. */
     uint64_t start_time = sail_now();
@@ -655,7 +645,12 @@ static sail_status_t init_context(struct sail_context *context, int flags) {
 
     SAIL_TRY(print_enumerated_codecs(context));
 
-    if (flags & SAIL_FLAG_PRELOAD_CODECS) {
+    SAIL_TRY(alloc_codec_info_index(context->codec_info_node, &context->codec_info_index));
+    SAIL_TRY(alloc_codecs_loading(context));
+
+    if (flags & SAIL_FLAG_PRELOAD_CODECS_ASYNC) {
+        SAIL_TRY(start_preloading_codecs(context));
+    } else if (flags & SAIL_FLAG_PRELOAD_CODECS) {
         SAIL_TRY(preload_codecs(context));
     }
 
@@ -664,18 +659,245 @@ static sail_status_t init_context(struct sail_context *context, int flags) {
     return SAIL_OK;
 }
 
+/* Initializes the context and loads all the codec info files if the context is not initialized. */
+static sail_status_t init_context(struct sail_context *context, int flags) {
+
+    SAIL_CHECK_CONTEXT_PTR(context);
+
+    if (context->initialized) {
+        return SAIL_OK;
+    }
+
+    /* Leave the context uninitialized on error so the next call starts over. */
+    SAIL_TRY_OR_CLEANUP(load_context_codec_info(context, flags),
+                        /* cleanup */ destroy_context_codec_info(context));
+
+    context->initialized = true;
+
+    return SAIL_OK;
+}
+
+/*
+ * Process-wide context shared between the threads that opted in with SAIL_FLAG_SHARED_CONTEXT.
+ * The codec info list is built once and never modified afterwards, so it's safe to read it
+ * from multiple threads without locking.
+ */
+static struct sail_context *shared_context = NULL;
+static sail_mutex_t shared_context_mutex = SAIL_MUTEX_INITIALIZER;
+
+/* Context used by the current thread. Either a thread-local one or the shared one. */
+SAIL_THREAD_LOCAL static struct sail_context *tls_context = NULL;
+
+/* The current thread uses the context of another thread. See borrow_tls_context(). */
+SAIL_THREAD_LOCAL static bool tls_context_borrowed = false;
+
+/*
+ * Returns the shared context with the incremented reference counter. If the shared context doesn't exist
+ * and allocate is true, allocates and initializes it with the specified flags. Sets *context to NULL otherwise.
+ */
+static sail_status_t acquire_shared_context(struct sail_context **context, bool allocate, int flags) {
+
+    SAIL_CHECK_CONTEXT_PTR(context);
+
+    lock_mutex(&shared_context_mutex);
+
+    if (shared_context == NULL && allocate) {
+        struct sail_context *new_context;
+        SAIL_TRY_OR_CLEANUP(alloc_context(&new_context),
+                            /* cleanup */ unlock_mutex(&shared_context_mutex));
+
+        new_context->shared = true;
+
+        /* Initialize under the lock so other threads never see a partially built codec info list. */
+        SAIL_TRY_OR_CLEANUP(init_context(new_context, flags),
+                            /* cleanup */ destroy_context(new_context),
+                                          unlock_mutex(&shared_context_mutex));
+
+        shared_context = new_context;
+        SAIL_LOG_DEBUG("Allocated a new shared context %p", shared_context);
+    }
+
+    if (shared_context != NULL) {
+        shared_context->references++;
+        SAIL_LOG_DEBUG("Attached to the shared context %p. References: %u", shared_context, shared_context->references);
+    }
+
+    *context = shared_context;
+
+    unlock_mutex(&shared_context_mutex);
+
+    return SAIL_OK;
+}
+
+/* Decrements the reference counter of the shared context and destroys it when it drops to zero. */
+static void release_shared_context(void) {
+
+    lock_mutex(&shared_context_mutex);
+
+    if (shared_context != NULL && --shared_context->references == 0) {
+        SAIL_LOG_DEBUG("Destroyed the shared context %p", shared_context);
+        destroy_context(shared_context);
+        shared_context = NULL;
+    }
+
+    unlock_mutex(&shared_context_mutex);
+}
+
 /*
  * Public functions.
  */
 
-sail_status_t control_tls_context(struct sail_context **context, enum SailContextAction action) {
+sail_status_t build_full_path(const char *sail_codecs_path, const char *name, char **full_path) {
+
+#ifdef SAIL_WIN32
+    SAIL_TRY(sail_concat(full_path, 3, sail_codecs_path, "\\", name));
+#else
+    SAIL_TRY(sail_concat(full_path, 3, sail_codecs_path, "/", name));
+#endif
+
+    return SAIL_OK;
+}
+
+sail_status_t build_codec_from_codec_info(const char *codec_info_full_path,
+                                            struct sail_codec_info_node **codec_info_node) {
+
+    SAIL_CHECK_PATH_PTR(codec_info_full_path);
+    SAIL_CHECK_CODEC_INFO_PTR(codec_info_node);
+
+    /* Build "/path/jpeg.so" from "/path/jpeg.codec.info". */
+    char *codec_info_part = strstr(codec_info_full_path, ".codec.info");
+
+    if (codec_info_part == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
+    }
+
+    /* The length of "/path/jpeg". */
+    size_t codec_full_path_length = strlen(codec_info_full_path) - strlen(codec_info_part);
+    char *codec_full_path;
+
+#ifdef SAIL_WIN32
+    static const char * const LIB_SUFFIX = "dll";
+#else
+    static const char * const LIB_SUFFIX = "so";
+#endif
+
+    /* The resulting string will be "/path/jpeg.plu" (on Windows) or "/path/jpeg.pl". */
+    SAIL_TRY(sail_strdup_length(codec_info_full_path,
+                                codec_full_path_length + strlen(LIB_SUFFIX) + 1, &codec_full_path));
+
+#ifdef SAIL_WIN32
+    /* Overwrite the end of the path with "dll". */
+    strcpy_s(codec_full_path + codec_full_path_length + 1, strlen(LIB_SUFFIX) + 1, LIB_SUFFIX);
+#else
+    /* Overwrite the end of the path with "so". */
+    strcpy(codec_full_path + codec_full_path_length + 1, LIB_SUFFIX);
+#endif
+
+    /* Parse codec info. */
+    SAIL_TRY_OR_CLEANUP(alloc_codec_info_node(codec_info_node),
+                        sail_free(codec_full_path));
+
+    struct sail_codec_info *codec_info;
+    SAIL_TRY_OR_CLEANUP(codec_read_info_from_file(codec_info_full_path, &codec_info),
+                        destroy_codec_info_node(*codec_info_node),
+                        sail_free(codec_full_path));
+
+    /* Save the parsed codec info into the SAIL context. */
+    (*codec_info_node)->codec_info = codec_info;
+    codec_info->path = codec_full_path;
+
+    return SAIL_OK;
+}
+
+sail_status_t enumerate_codec_info_files(const char *codecs_path, struct sail_string_node **codec_info_file_node) {
+
+    SAIL_CHECK_PATH_PTR(codecs_path);
+    SAIL_CHECK_STRING_NODE_PTR(codec_info_file_node);
+
+    *codec_info_file_node = NULL;
+    struct sail_string_node **last_string_node = codec_info_file_node;
+
+#ifdef SAIL_WIN32
+    const char *plugs_info_mask = "\\*.codec.info";
+
+    size_t codecs_path_with_mask_length = strlen(codecs_path) + strlen(plugs_info_mask) + 1;
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(codecs_path_with_mask_length, &ptr));
+    char *codecs_path_with_mask = ptr;
+
+    strcpy_s(codecs_path_with_mask, codecs_path_with_mask_length, codecs_path);
+    strcat_s(codecs_path_with_mask, codecs_path_with_mask_length, plugs_info_mask);
+
+    WIN32_FIND_DATA data;
+    HANDLE hFind = FindFirstFile(codecs_path_with_mask, &data);
+
+    if (hFind == INVALID_HANDLE_VALUE) {
+        SAIL_LOG_ERROR("Failed to list files in '%s'. Error: %d. No codecs loaded from it", codecs_path, GetLastError());
+        sail_free(codecs_path_with_mask);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_LIST_DIR);
+    }
+
+    do {
+        /* Ignore errors and try to load as much as possible. */
+        SAIL_TRY_OR_SUPPRESS(append_string_node(data.cFileName, &last_string_node));
+    } while (FindNextFile(hFind, &data));
+
+    if (GetLastError() != ERROR_NO_MORE_FILES) {
+        SAIL_LOG_ERROR("Failed to list files in '%s'. Error: %d. Some codecs may not be loaded from it", codecs_path, GetLastError());
+    }
+
+    sail_free(codecs_path_with_mask);
+    FindClose(hFind);
+#else
+    DIR *d = opendir(codecs_path);
+
+    if (d == NULL) {
+        SAIL_LOG_ERROR("Failed to list files in '%s': %s", codecs_path, strerror(errno));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_LIST_DIR);
+    }
+
+    struct dirent *dir;
+
+    while ((dir = readdir(d)) != NULL) {
+        if (strstr(dir->d_name, ".codec.info") == NULL) {
+            continue;
+        }
 
-    SAIL_THREAD_LOCAL static struct sail_context *tls_context = NULL;
+        /* Build a full path. */
+        char *full_path;
+
+        /* Ignore errors and try to load as much as possible. */
+        SAIL_TRY_OR_EXECUTE(build_full_path(codecs_path, dir->d_name, &full_path),
+                            /* on error */ continue);
+
+        /* Handle files only. */
+        bool is_file = sail_is_file(full_path);
+        sail_free(full_path);
+
+        if (!is_file) {
+            continue;
+        }
+
+        SAIL_TRY_OR_SUPPRESS(append_string_node(dir->d_name, &last_string_node));
+    }
+
+    closedir(d);
+#endif
+
+    return SAIL_OK;
+}
+
+sail_status_t control_tls_context(struct sail_context **context, enum SailContextAction action) {
 
     switch (action) {
         case SAIL_CONTEXT_ALLOCATE: {
             SAIL_CHECK_CONTEXT_PTR(context);
 
+            if (tls_context == NULL) {
+                SAIL_TRY(acquire_shared_context(&tls_context, /* allocate */ false, /* flags */ 0));
+            }
+
             if (tls_context == NULL) {
                 SAIL_TRY(alloc_context(&tls_context));
                 SAIL_LOG_DEBUG("Allocated a new thread-local context %p", tls_context);
@@ -689,8 +911,31 @@ sail_status_t control_tls_context(struct sail_context **context, enum SailContex
             break;
         }
         case SAIL_CONTEXT_DESTROY: {
-            SAIL_LOG_DEBUG("Destroyed the thread-local context %p", tls_context);
-            destroy_context(tls_context);
+            if (tls_context_borrowed) {
+                SAIL_LOG_DEBUG("The context %p is borrowed from another thread. Not destroying it", tls_context);
+                break;
+            }
+
+            if (tls_context != NULL && !tls_context->shared) {
+                lock_mutex(&shared_context_mutex);
+                const unsigned references = tls_context->references;
+                unlock_mutex(&shared_context_mutex);
+
+                if (references > 0) {
+                    SAIL_LOG_DEBUG("The thread-local context %p is used by %u parallel batches. Not destroying it",
+                                    tls_context, references);
+                    break;
+                }
+            }
+
+            if (tls_context != NULL && tls_context->shared) {
+                SAIL_LOG_DEBUG("Detached from the shared context %p", tls_context);
+                release_shared_context();
+            } else {
+                SAIL_LOG_DEBUG("Destroyed the thread-local context %p", tls_context);
+                destroy_context(tls_context);
+            }
+
             tls_context = NULL;
             break;
         }
@@ -699,6 +944,34 @@ sail_status_t control_tls_context(struct sail_context **context, enum SailContex
     return SAIL_OK;
 }
 
+void borrow_tls_context(struct sail_context *context) {
+
+    tls_context          = context;
+    tls_context_borrowed = context != NULL;
+}
+
+sail_status_t acquire_tls_context(struct sail_context **context) {
+
+    SAIL_TRY(current_tls_context(context));
+
+    lock_mutex(&shared_context_mutex);
+    (*context)->references++;
+    unlock_mutex(&shared_context_mutex);
+
+    return SAIL_OK;
+}
+
+void release_context(struct sail_context *context) {
+
+    if (context->shared) {
+        release_shared_context();
+    } else {
+        lock_mutex(&shared_context_mutex);
+        context->references--;
+        unlock_mutex(&shared_context_mutex);
+    }
+}
+
 sail_status_t current_tls_context(struct sail_context **context) {
 
     SAIL_TRY(current_tls_context_with_flags(context, /* flags */ 0));
@@ -710,8 +983,94 @@ sail_status_t current_tls_context_with_flags(struct sail_context **context, int
 
     SAIL_CHECK_CONTEXT_PTR(context);
 
-    SAIL_TRY(control_tls_context(context, SAIL_CONTEXT_ALLOCATE));
+    if (flags & SAIL_FLAG_SHARED_CONTEXT) {
+        if (tls_context == NULL) {
+            SAIL_TRY(acquire_shared_context(&tls_context, /* allocate */ true, flags));
+        } else if (!tls_context->shared) {
+            SAIL_LOG_DEBUG("The current thread already uses a thread-local context. Call sail_finish() first to switch to the shared context");
+        }
+
+        *context = tls_context;
+    } else {
+        SAIL_TRY(control_tls_context(context, SAIL_CONTEXT_ALLOCATE));
+    }
+
     SAIL_TRY(init_context(*context, flags));
 
     return SAIL_OK;
 }
+
+sail_status_t load_context_codec(struct sail_context *context, const struct sail_codec_info *codec_info,
+                                    const struct sail_codec **codec) {
+
+    SAIL_CHECK_CONTEXT_PTR(context);
+    SAIL_CHECK_CODEC_INFO_PTR(codec_info);
+    SAIL_CHECK_CODEC_PTR(codec);
+
+    /* The context failed to initialize. */
+    if (context->codecs_loading == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
+    }
+
+    /* Find the codec in the cache. */
+    struct sail_codec_info_node *node = context->codec_info_node;
+    size_t index = 0;
+
+    while (node != NULL && node->codec_info != codec_info) {
+        node = node->next;
+        index++;
+    }
+
+    /* Something weird. The pointer to the codec info is not found the cache. */
+    if (node == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
+    }
+
+    SAIL_TRY(load_codec_of_node(context, node, index, codec));
+
+    return SAIL_OK;
+}
+
+sail_status_t unload_context_codecs(struct sail_context *context, unsigned *counter) {
+
+    SAIL_CHECK_CONTEXT_PTR(context);
+    SAIL_CHECK_RESULT_PTR(counter);
+
+    *counter = 0;
+
+    /* Keep the same lock order as in acquire_shared_context(). */
+    lock_mutex(&shared_context_mutex);
+
+    /*
+     * Other threads could be reading or writing images with the cached codecs right now.
+     * The calling thread holds one reference to the shared context itself.
+     */
+    const unsigned own_references = context->shared ? 1 : 0;
+
+    if (context->references > own_references) {
+        const unsigned references = context->references;
+        unlock_mutex(&shared_context_mutex);
+        SAIL_LOG_DEBUG("The context is used by %u other threads or parallel batches. Not unloading codecs",
+                        references - own_references);
+        return SAIL_OK;
+    }
+
+    lock_mutex(&context->codecs_mutex);
+
+    struct sail_codec_info_node *node = context->codec_info_node;
+
+    while (node != NULL) {
+        if (node->codec != NULL) {
+            destroy_codec(node->codec);
+            node->codec = NULL;
+            (*counter)++;
+        }
+
+        node = node->next;
+    }
+
+    unlock_mutex(&context->codecs_mutex);
+    unlock_mutex(&shared_context_mutex);
+
+    return SAIL_OK;
+}
@@ -28,15 +28,46 @@
 
 #include <stdbool.h>
 
+#include "threading.h"
+
 #ifdef SAIL_BUILD
     #include "error.h"
     #include "export.h"
 #else
     #include <sail-common/error.h>
     #include <sail-common/export.h>
+/*
+ * Builds a full path to the file in the specified directory. The assigned path MUST be freed
+ * later with sail_free().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t build_full_path(const char *directory, const char *name, char **full_path);
+
+/*
+ * Builds a new codec info node from the specified codec info file. The codec path is built
+ * from the codec info path. The assigned node MUST be destroyed later with destroy_codec_info_node().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t build_codec_from_codec_info(const char *codec_info_full_path,
+                                                        struct sail_codec_info_node **codec_info_node);
+
+/*
+ * Lists the codec info file names (without paths) in the specified directory. The assigned chain MUST be
+ * destroyed later with destroy_string_node_chain().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t enumerate_codec_info_files(const char *codecs_path, struct sail_string_node **codec_info_file_node);
+
 #endif
 
+struct codec_info_index;
+struct sail_codec;
+struct sail_codec_info;
 struct sail_codec_info_node;
+struct sail_string_node;
 
 /*
  * Context is a main entry point to start working with SAIL. It enumerates codec info objects which could be
@@ -47,20 +78,59 @@ struct sail_context {
     /* Context is already initialized. */
     bool initialized;
 
+    /*
+     * Context is shared between threads. Shared contexts are reference-counted and their codec info
+     * list is never modified after initialization.
+     */
+    bool shared;
+
+    /*
+     * Number of threads using the shared context plus the number of parallel batches running with
+     * the context. Thread-local contexts are referenced by the batches only. Guarded by the shared context mutex.
+     */
+    unsigned references;
+
+    /* Guards lazy loading and unloading of codecs. Not held while a codec is being loaded. */
+    sail_mutex_t codecs_mutex;
+
+    /* Signaled when a codec finishes loading. */
+    sail_cond_t codecs_cond;
+
+    /* Per-codec flags in the codec info list order. A flag is set while its codec is being loaded. */
+    bool *codecs_loading;
+
+    /* Background threads preloading codecs. See SAIL_FLAG_PRELOAD_CODECS_ASYNC. */
+    sail_thread_t *preload_threads;
+    unsigned preload_threads_count;
+
+    /* The next codec to preload by the background threads and its index. */
+    struct sail_codec_info_node *preload_next_node;
+    size_t preload_next_index;
+
     /* Linked list of found codec info objects. */
     struct sail_codec_info_node *codec_info_node;
+
+    /* Lookup indexes of the found codec info objects. */
+    struct codec_info_index *codec_info_index;
 };
 
 typedef struct sail_context sail_context_t;
 
 enum SailContextAction {
-    /* Allocates a new TLS context if it's not allocated yet. */
+    /*
+     * Allocates a new TLS context if it's not allocated yet. Attaches the current thread
+     * to the shared context instead if it exists.
+     */
     SAIL_CONTEXT_ALLOCATE,
 
     /* fetches the current TLS context or NULL if it's not allocated yet. */
     SAIL_CONTEXT_FETCH,
 
-    /* Destroys the currently existing TLS context. */
+    /*
+     * Destroys the currently existing TLS context. If the current thread is attached to the shared
+     * context, detaches it and destroys the shared context when no threads use it anymore.
+     * Does nothing if the context is borrowed or a thread-local context is referenced by parallel batches.
+     */
     SAIL_CONTEXT_DESTROY,
 };
 
@@ -70,13 +140,79 @@ enum SailContextAction {
  */
 SAIL_HIDDEN sail_status_t control_tls_context(struct sail_context **context, enum SailContextAction action);
 
+/*
+ * Makes the current thread use the specified context until it's called again with NULL. The context
+ * is borrowed: sail_finish() called in the current thread doesn't destroy it. Used by worker threads
+ * to share the context of the thread that started them. That context MUST be referenced with
+ * acquire_tls_context() while the workers run. The current thread MUST NOT have its own context.
+ */
+SAIL_HIDDEN void borrow_tls_context(struct sail_context *context);
+
+/*
+ * Returns the allocated and initialized TLS context with the incremented reference counter.
+ * While the context is referenced, its codecs are not unloaded, and a thread-local context
+ * is not destroyed by sail_finish(). The context MUST be released with release_context().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t acquire_tls_context(struct sail_context **context);
+
+/*
+ * Decrements the reference counter of the context acquired with acquire_tls_context().
+ * Destroys the shared context when no threads use it anymore.
+ */
+SAIL_HIDDEN void release_context(struct sail_context *context);
+
 /* Returns the allocated and initialized TLS context. */
 SAIL_HIDDEN sail_status_t current_tls_context(struct sail_context **context);
 
 /*
  * Returns the allocated and initialized TLS context. The specified flags are used to initialize it.
- * See SailInitFlags.
+ * If SAIL_FLAG_SHARED_CONTEXT is specified, the current thread is attached to the process-wide
+ * shared context which is allocated if necessary. See SailInitFlags.
  */
 SAIL_HIDDEN sail_status_t current_tls_context_with_flags(struct sail_context **context, int flags);
 
+/*
+ * Loads the codec of the specified codec info in the context if it's not loaded yet. If another thread
+ * is loading the same codec right now, waits for that codec only. Other codecs could be loaded in parallel.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t load_context_codec(struct sail_context *context, const struct sail_codec_info *codec_info,
+                                                const struct sail_codec **codec);
+
+/*
+ * Unloads all the cached codecs in the context and stores the number of unloaded codecs in the counter.
+ * Does nothing if the context is used by other threads or parallel batches.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t unload_context_codecs(struct sail_context *context, unsigned *counter);
+
+/*
+ * Builds a full path to the file in the specified directory. The assigned path MUST be freed
+ * later with sail_free().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t build_full_path(const char *directory, const char *name, char **full_path);
+
+/*
+ * Builds a new codec info node from the specified codec info file. The codec path is built
+ * from the codec info path. The assigned node MUST be destroyed later with destroy_codec_info_node().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t build_codec_from_codec_info(const char *codec_info_full_path,
+                                                        struct sail_codec_info_node **codec_info_node);
+
+/*
+ * Lists the codec info file names (without paths) in the specified directory. The assigned chain MUST be
+ * destroyed later with destroy_string_node_chain().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t enumerate_codec_info_files(const char *codecs_path, struct sail_string_node **codec_info_file_node);
+
 #endif
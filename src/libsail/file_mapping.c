@@ -0,0 +1,166 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef SAIL_WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "sail-common.h"
+#include "sail.h"
+
+/*
+ * Private functions.
+ */
+
+static sail_status_t alloc_file_mapping(struct file_mapping **file_mapping) {
+
+    SAIL_CHECK_PTR(file_mapping);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct file_mapping), &ptr));
+    *file_mapping = ptr;
+
+    (*file_mapping)->data           = NULL;
+    (*file_mapping)->size           = 0;
+    (*file_mapping)->file_handle    = NULL;
+    (*file_mapping)->mapping_handle = NULL;
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t map_file(const char *path, struct file_mapping **file_mapping) {
+
+    SAIL_CHECK_PATH_PTR(path);
+    SAIL_CHECK_PTR(file_mapping);
+
+#ifdef SAIL_WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        SAIL_LOG_ERROR("Failed to open '%s'. Error: %d", path, GetLastError());
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_OPEN_FILE);
+    }
+
+    LARGE_INTEGER file_size;
+
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0 || (uint64_t)file_size.QuadPart > SIZE_MAX) {
+        SAIL_LOG_ERROR("Failed to get the size of '%s' or the file is empty", path);
+        CloseHandle(file);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+    }
+
+    HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    if (mapping == NULL) {
+        SAIL_LOG_ERROR("Failed to map '%s'. Error: %d", path, GetLastError());
+        CloseHandle(file);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+    }
+
+    const void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (data == NULL) {
+        SAIL_LOG_ERROR("Failed to map '%s'. Error: %d", path, GetLastError());
+        CloseHandle(mapping);
+        CloseHandle(file);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+    }
+
+    SAIL_TRY_OR_CLEANUP(alloc_file_mapping(file_mapping),
+                        /* cleanup */ UnmapViewOfFile(data),
+                                      CloseHandle(mapping),
+                                      CloseHandle(file));
+
+    (*file_mapping)->data           = data;
+    (*file_mapping)->size           = (size_t)file_size.QuadPart;
+    (*file_mapping)->file_handle    = file;
+    (*file_mapping)->mapping_handle = mapping;
+#else
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        SAIL_LOG_ERROR("Failed to open '%s': %s", path, strerror(errno));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_OPEN_FILE);
+    }
+
+    struct stat attrs;
+
+    if (fstat(fd, &attrs) != 0 || attrs.st_size <= 0 || (uint64_t)attrs.st_size > SIZE_MAX) {
+        SAIL_LOG_ERROR("Failed to get the size of '%s' or the file is empty", path);
+        close(fd);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+    }
+
+    void *data = mmap(NULL, (size_t)attrs.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    /* The mapping keeps its own reference to the file. */
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        SAIL_LOG_ERROR("Failed to map '%s': %s", path, strerror(errno));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+    }
+
+    SAIL_TRY_OR_CLEANUP(alloc_file_mapping(file_mapping),
+                        /* cleanup */ munmap(data, (size_t)attrs.st_size));
+
+    (*file_mapping)->data = data;
+    (*file_mapping)->size = (size_t)attrs.st_size;
+#endif
+
+    return SAIL_OK;
+}
+
+void unmap_file(struct file_mapping *file_mapping) {
+
+    if (file_mapping == NULL) {
+        return;
+    }
+
+#ifdef SAIL_WIN32
+    UnmapViewOfFile(file_mapping->data);
+    CloseHandle(file_mapping->mapping_handle);
+    CloseHandle(file_mapping->file_handle);
+#else
+    munmap((void *)file_mapping->data, file_mapping->size);
+#endif
+
+    sail_free(file_mapping);
+}
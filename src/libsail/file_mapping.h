@@ -0,0 +1,68 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_FILE_MAPPING_H
+#define SAIL_FILE_MAPPING_H
+
+#include <stddef.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+/*
+ * Read-only memory mapping of a whole file.
+ */
+struct file_mapping {
+
+    /* Mapped file contents. */
+    const void *data;
+
+    /* The length of data. */
+    size_t size;
+
+    /* Platform-specific handles. */
+    void *file_handle;
+    void *mapping_handle;
+};
+
+/*
+ * Maps the specified file into memory for reading. Empty files are not supported.
+ * The assigned mapping MUST be destroyed later with unmap_file().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t map_file(const char *path, struct file_mapping **file_mapping);
+
+/*
+ * Unmaps the file and destroys the mapping. Does nothing if the mapping is NULL.
+ */
+SAIL_HIDDEN void unmap_file(struct file_mapping *file_mapping);
+
+#endif
@@ -0,0 +1,178 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "sail-common.h"
+#include "sail.h"
+
+struct counting_io_stream {
+    struct sail_io *sink;
+    bool own_sink;
+
+    /* The number of bytes written so far. */
+    uint64_t written;
+};
+
+/*
+ * Private functions.
+ */
+
+static sail_status_t io_counting_seek64(void *stream, int64_t offset, int whence) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+
+    const struct counting_io_stream *counting_io_stream = stream;
+
+    bool noop;
+
+    switch (whence) {
+        case SEEK_SET: noop = offset >= 0 && (uint64_t)offset == counting_io_stream->written; break;
+        case SEEK_CUR: noop = offset == 0;                                                 break;
+        case SEEK_END: noop = offset == 0;                                                 break;
+
+        default: {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_SEEK_WHENCE);
+        }
+    }
+
+    if (!noop) {
+        SAIL_LOG_ERROR("Failed to seek a non-seekable I/O sink");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_counting_seek(void *stream, long offset, int whence) {
+
+    SAIL_TRY(io_counting_seek64(stream, offset, whence));
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_counting_tell64(void *stream, uint64_t *offset) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_PTR(offset);
+
+    const struct counting_io_stream *counting_io_stream = stream;
+
+    *offset = counting_io_stream->written;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_counting_tell(void *stream, size_t *offset) {
+
+    uint64_t offset64;
+    SAIL_TRY(io_counting_tell64(stream, &offset64));
+
+    SAIL_TRY(offset64_to_size(offset64, offset));
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_counting_write(void *stream, const void *buf, size_t object_size, size_t objects_count, size_t *written_objects_count) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_BUFFER_PTR(buf);
+    SAIL_CHECK_RESULT_PTR(written_objects_count);
+
+    struct counting_io_stream *counting_io_stream = stream;
+    struct sail_io *sink = counting_io_stream->sink;
+
+    SAIL_TRY(sink->write(sink->stream, buf, object_size, objects_count, written_objects_count));
+
+    counting_io_stream->written += *written_objects_count * object_size;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_counting_flush(void *stream) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+
+    struct counting_io_stream *counting_io_stream = stream;
+    struct sail_io *sink = counting_io_stream->sink;
+
+    SAIL_TRY(sink->flush(sink->stream));
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_counting_close(void *stream) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+
+    struct counting_io_stream *counting_io_stream = stream;
+
+    if (counting_io_stream->own_sink) {
+        sail_destroy_io(counting_io_stream->sink);
+    }
+
+    sail_free(counting_io_stream);
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t alloc_io_write_counting(struct sail_io *sink, bool own_sink, struct sail_io **io) {
+
+    SAIL_CHECK_IO(sink);
+    SAIL_CHECK_IO_PTR(io);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct counting_io_stream), &ptr));
+    struct counting_io_stream *counting_io_stream = ptr;
+
+    counting_io_stream->sink     = sink;
+    counting_io_stream->own_sink = own_sink;
+    counting_io_stream->written  = 0;
+
+    SAIL_TRY_OR_CLEANUP(sail_alloc_io(io),
+                        /* cleanup */ sail_free(counting_io_stream));
+
+    (*io)->id       = SAIL_COUNTING_IO_ID;
+    (*io)->stream   = counting_io_stream;
+    (*io)->read     = io_noop_read;
+    (*io)->seek     = io_counting_seek;
+    (*io)->tell     = io_counting_tell;
+    (*io)->seek64   = io_counting_seek64;
+    (*io)->tell64   = io_counting_tell64;
+    (*io)->write    = io_counting_write;
+    (*io)->flush    = io_counting_flush;
+    (*io)->close    = io_counting_close;
+    (*io)->eof      = io_noop_eof;
+    (*io)->features = SAIL_IO_FEATURE_NON_SEEKABLE;
+
+    return SAIL_OK;
+}
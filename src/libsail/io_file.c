@@ -27,6 +27,7 @@
 
 #include <errno.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -34,6 +35,13 @@
 #ifdef SAIL_WIN32
     /* _fsopen() */
     #include <share.h>
+#else
+    /* posix_fadvise() */
+    #include <fcntl.h>
+    /* off_t */
+    #include <sys/types.h>
+    /* pread() */
+    #include <unistd.h>
 #endif
 
 #include "sail-common.h"
@@ -56,13 +64,23 @@ static sail_status_t io_file_read(void *stream, void *buf, size_t object_size, s
     return SAIL_OK;
 }
 
-static sail_status_t io_file_seek(void *stream, long offset, int whence) {
+static sail_status_t io_file_seek64(void *stream, int64_t offset, int whence) {
 
     SAIL_CHECK_STREAM_PTR(stream);
 
     FILE *fptr = (FILE *)stream;
 
-    if (fseek(fptr, offset, whence) != 0) {
+    /* fseek() takes long which is 32-bit on Windows and 32-bit UNIX platforms. */
+#ifdef SAIL_WIN32
+    if (_fseeki64(fptr, offset, whence) != 0) {
+#else
+    if ((int64_t)(off_t)offset != offset) {
+        SAIL_LOG_ERROR("Seek offset %lld is out of range", (long long)offset);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    if (fseeko(fptr, (off_t)offset, whence) != 0) {
+#endif
         sail_print_errno("Failed to seek: %s");
         SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
     }
@@ -70,21 +88,42 @@ static sail_status_t io_file_seek(void *stream, long offset, int whence) {
     return SAIL_OK;
 }
 
-static sail_status_t io_file_tell(void *stream, size_t *offset) {
+static sail_status_t io_file_seek(void *stream, long offset, int whence) {
+
+    SAIL_TRY(io_file_seek64(stream, offset, whence));
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_file_tell64(void *stream, uint64_t *offset) {
 
     SAIL_CHECK_STREAM_PTR(stream);
     SAIL_CHECK_PTR(offset);
 
     FILE *fptr = (FILE *)stream;
 
-    long offset_local = ftell(fptr);
+#ifdef SAIL_WIN32
+    const int64_t offset_local = _ftelli64(fptr);
+#else
+    const int64_t offset_local = ftello(fptr);
+#endif
 
     if (offset_local < 0) {
         sail_print_errno("Failed to get the current I/O position: %s");
         SAIL_LOG_AND_RETURN(SAIL_ERROR_TELL_IO);
     }
 
-    *offset = offset_local;
+    *offset = (uint64_t)offset_local;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_file_tell(void *stream, size_t *offset) {
+
+    uint64_t offset64;
+    SAIL_TRY(io_file_tell64(stream, &offset64));
+
+    SAIL_TRY(offset64_to_size(offset64, offset));
 
     return SAIL_OK;
 }
@@ -142,6 +181,71 @@ static sail_status_t io_file_eof(void *stream, bool *result) {
     return SAIL_OK;
 }
 
+/*
+ * Windows has no pread() equivalent that leaves the file position intact, so positioned reads
+ * are supported on POSIX systems only.
+ */
+#ifndef SAIL_WIN32
+static sail_status_t io_file_read_at(void *stream, uint64_t offset, void *buf, size_t size, size_t *read_size) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_BUFFER_PTR(buf);
+    SAIL_CHECK_RESULT_PTR(read_size);
+
+    FILE *fptr = (FILE *)stream;
+    const int fd = fileno(fptr);
+
+    *read_size = 0;
+
+    while (*read_size < size) {
+        const ssize_t result = pread(fd, (char *)buf + *read_size, size - *read_size, (off_t)(offset + *read_size));
+
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            sail_print_errno("Failed to read the file: %s");
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+        }
+
+        /* End of file. */
+        if (result == 0) {
+            break;
+        }
+
+        *read_size += (size_t)result;
+    }
+
+    return SAIL_OK;
+}
+#endif
+
+/* Returns true if the SAIL_MMAP_IO environment variable is set to a non-zero value. */
+static bool mmap_io_env(void) {
+
+    SAIL_THREAD_LOCAL static bool mmap_io_env_called = false;
+    SAIL_THREAD_LOCAL static bool mmap_io = false;
+
+    if (mmap_io_env_called) {
+        return mmap_io;
+    }
+
+    mmap_io_env_called = true;
+
+#ifdef SAIL_WIN32
+    char *env = NULL;
+    _dupenv_s(&env, NULL, "SAIL_MMAP_IO");
+    mmap_io = env != NULL && strcmp(env, "0") != 0;
+    free(env);
+#else
+    const char *env = getenv("SAIL_MMAP_IO");
+    mmap_io = env != NULL && strcmp(env, "0") != 0;
+#endif
+
+    return mmap_io;
+}
+
 static sail_status_t alloc_io_file(const char *path, const char *mode, struct sail_io **io) {
 
     SAIL_CHECK_PATH_PTR(path);
@@ -180,15 +284,36 @@ static sail_status_t alloc_io_file(const char *path, const char *mode, struct sa
 
 sail_status_t alloc_io_read_file(const char *path, struct sail_io **io) {
 
+    SAIL_TRY(alloc_io_read_file_with_options(path, mmap_io_env() ? SAIL_IO_OPTION_MMAP : 0, io));
+
+    return SAIL_OK;
+}
+
+sail_status_t alloc_io_read_file_with_options(const char *path, int io_options, struct sail_io **io) {
+
+    if (io_options & SAIL_IO_OPTION_MMAP) {
+        /* Fall back to regular file I/O if the file could not be mapped. For example, if it's empty. */
+        if (alloc_io_read_mmap(path, io) == SAIL_OK) {
+            return SAIL_OK;
+        }
+
+        SAIL_LOG_DEBUG("Failed to map '%s'. Falling back to regular file I/O", path);
+    }
+
     SAIL_TRY(alloc_io_file(path, "rb", io));
 
-    (*io)->read  = io_file_read;
-    (*io)->seek  = io_file_seek;
-    (*io)->tell  = io_file_tell;
-    (*io)->write = io_noop_write;
-    (*io)->flush = io_noop_flush;
-    (*io)->close = io_file_close;
-    (*io)->eof   = io_file_eof;
+    (*io)->read    = io_file_read;
+    (*io)->seek    = io_file_seek;
+    (*io)->tell    = io_file_tell;
+    (*io)->seek64  = io_file_seek64;
+    (*io)->tell64  = io_file_tell64;
+    (*io)->write   = io_noop_write;
+    (*io)->flush   = io_noop_flush;
+    (*io)->close   = io_file_close;
+    (*io)->eof     = io_file_eof;
+#ifndef SAIL_WIN32
+    (*io)->read_at = io_file_read_at;
+#endif
 
     return SAIL_OK;
 }
@@ -197,13 +322,37 @@ sail_status_t alloc_io_write_file(const char *path, struct sail_io **io) {
 
     SAIL_TRY(alloc_io_file(path, "w+b", io));
 
-    (*io)->read  = io_file_read;
-    (*io)->seek  = io_file_seek;
-    (*io)->tell  = io_file_tell;
-    (*io)->write = io_file_write;
-    (*io)->flush = io_file_flush;
-    (*io)->close = io_file_close;
-    (*io)->eof   = io_file_eof;
+    (*io)->read   = io_file_read;
+    (*io)->seek   = io_file_seek;
+    (*io)->tell   = io_file_tell;
+    (*io)->seek64 = io_file_seek64;
+    (*io)->tell64 = io_file_tell64;
+    (*io)->write  = io_file_write;
+    (*io)->flush  = io_file_flush;
+    (*io)->close  = io_file_close;
+    (*io)->eof    = io_file_eof;
 
     return SAIL_OK;
 }
+
+void readahead_file(const char *path, size_t length) {
+
+#if !defined SAIL_WIN32 && defined POSIX_FADV_WILLNEED
+    if (path == NULL) {
+        return;
+    }
+
+    const int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return;
+    }
+
+    /* The kernel keeps reading into the page cache after the file is closed. */
+    posix_fadvise(fd, 0, (off_t)length, POSIX_FADV_WILLNEED);
+    close(fd);
+#else
+    (void)path;
+    (void)length;
+#endif
+}
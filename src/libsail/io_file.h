@@ -26,6 +26,8 @@
 #ifndef SAIL_IO_FILE_H
 #define SAIL_IO_FILE_H
 
+#include <stddef.h>
+
 #ifdef SAIL_BUILD
     #include "error.h"
     #include "export.h"
@@ -38,12 +40,23 @@ struct sail_io;
 
 /*
  * Opens the specified image file for reading and allocates a new I/O object for it.
+ * Memory-maps the file if the SAIL_MMAP_IO environment variable is set to a non-zero value.
  * The assigned I/O object MUST be destroyed later with sail_destroy_io().
  *
  * Returns SAIL_OK on success.
  */
 SAIL_HIDDEN sail_status_t alloc_io_read_file(const char *path, struct sail_io **io);
 
+/*
+ * Opens the specified image file for reading and allocates a new I/O object for it.
+ * Memory-maps the file if SAIL_IO_OPTION_MMAP is set in the or-ed I/O options. See SailIoOption.
+ * Falls back to regular file I/O if the file could not be mapped.
+ * The assigned I/O object MUST be destroyed later with sail_destroy_io().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t alloc_io_read_file_with_options(const char *path, int io_options, struct sail_io **io);
+
 /*
  * Opens the specified image file for writing and allocates a new I/O object for it.
  * The assigned I/O object MUST be destroyed later with sail_destroy_io().
@@ -52,4 +65,11 @@ SAIL_HIDDEN sail_status_t alloc_io_read_file(const char *path, struct sail_io **
  */
 SAIL_HIDDEN sail_status_t alloc_io_write_file(const char *path, struct sail_io **io);
 
+/*
+ * Hints the OS to start reading the first length bytes of the specified file into the page cache
+ * in background, so the file is opened and read faster later. Does nothing if the OS doesn't support
+ * such hints. Errors are ignored.
+ */
+SAIL_HIDDEN void readahead_file(const char *path, size_t length);
+
 #endif
@@ -26,6 +26,7 @@
 #include "config.h"
 
 #include <errno.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -68,6 +69,40 @@ struct mem_io_write_stream {
     void *buffer;
 };
 
+/* Shares the layout with mem_io_write_stream so the read, tell and eof callbacks are reused. */
+struct mem_io_growing_write_stream {
+    /* The total buffer size is its current capacity. */
+    struct mem_io_buffer_info mem_io_buffer_info;
+    void *buffer;
+
+    /* Where to hand the final buffer and its length over when closing. */
+    void **result_buffer;
+    size_t *result_length;
+};
+
+struct mem_io_segment {
+    const void *buffer;
+    size_t length;
+
+    /* Absolute offset of the segment in the logical stream. */
+    size_t offset;
+};
+
+struct mem_io_segments_read_stream {
+    /* Total length of all the segments. */
+    size_t length;
+
+    /* Current stream position. */
+    size_t pos;
+
+    /* Index of the segment containing the current position or segments_count at the end. */
+    size_t segment;
+
+    /* Non-empty segments only. */
+    size_t segments_count;
+    struct mem_io_segment segments[];
+};
+
 /*
  * Private functions.
  */
@@ -87,40 +122,42 @@ static sail_status_t io_mem_read(void *stream, void *buf, size_t object_size, si
         SAIL_LOG_AND_RETURN(SAIL_ERROR_EOF);
     }
 
-    while (mem_io_buffer_info->pos <= mem_io_buffer_info->accessible_length - object_size && objects_count > 0) {
-        memcpy(buf, (const char *)mem_io_read_stream->buffer + mem_io_buffer_info->pos, object_size);
+    /* Copy as many whole objects as available at once. */
+    const size_t available_objects = (object_size == 0)
+                                        ? 0
+                                        : (mem_io_buffer_info->accessible_length - mem_io_buffer_info->pos) / object_size;
 
-        buf = (char *)buf + object_size;
-        mem_io_buffer_info->pos += object_size;
+    *read_objects_count = (objects_count < available_objects) ? objects_count : available_objects;
 
-        (*read_objects_count)++;
-        objects_count--;
-    }
+    const size_t size = *read_objects_count * object_size;
+
+    memcpy(buf, (const char *)mem_io_read_stream->buffer + mem_io_buffer_info->pos, size);
+    mem_io_buffer_info->pos += size;
 
     return SAIL_OK;
 }
 
-static sail_status_t io_mem_seek(void *stream, long offset, int whence) {
+static sail_status_t io_mem_seek64(void *stream, int64_t offset, int whence) {
 
     SAIL_CHECK_STREAM_PTR(stream);
 
     struct mem_io_buffer_info *mem_io_buffer_info = (struct mem_io_buffer_info *)stream;
 
-    size_t new_pos;
+    uint64_t new_pos;
 
     switch (whence) {
         case SEEK_SET: {
-            new_pos = offset;
+            new_pos = (uint64_t)offset;
             break;
         }
 
         case SEEK_CUR: {
-            new_pos = mem_io_buffer_info->pos + offset;
+            new_pos = mem_io_buffer_info->pos + (uint64_t)offset;
             break;
         }
 
         case SEEK_END: {
-            new_pos = mem_io_buffer_info->accessible_length + offset;
+            new_pos = mem_io_buffer_info->accessible_length + (uint64_t)offset;
             break;
         }
 
@@ -134,15 +171,22 @@ static sail_status_t io_mem_seek(void *stream, long offset, int whence) {
         new_pos = mem_io_buffer_info->length;
         mem_io_buffer_info->accessible_length = mem_io_buffer_info->length;
     } else if (new_pos >= mem_io_buffer_info->accessible_length) {
-        mem_io_buffer_info->accessible_length = new_pos + 1;
+        mem_io_buffer_info->accessible_length = (size_t)new_pos + 1;
     }
 
-    mem_io_buffer_info->pos = new_pos;
+    mem_io_buffer_info->pos = (size_t)new_pos;
 
     return SAIL_OK;
 }
 
-static sail_status_t io_mem_tell(void *stream, size_t *offset) {
+static sail_status_t io_mem_seek(void *stream, long offset, int whence) {
+
+    SAIL_TRY(io_mem_seek64(stream, offset, whence));
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mem_tell64(void *stream, uint64_t *offset) {
 
     SAIL_CHECK_STREAM_PTR(stream);
     SAIL_CHECK_PTR(offset);
@@ -154,6 +198,16 @@ static sail_status_t io_mem_tell(void *stream, size_t *offset) {
     return SAIL_OK;
 }
 
+static sail_status_t io_mem_tell(void *stream, size_t *offset) {
+
+    uint64_t offset64;
+    SAIL_TRY(io_mem_tell64(stream, &offset64));
+
+    SAIL_TRY(offset64_to_size(offset64, offset));
+
+    return SAIL_OK;
+}
+
 static sail_status_t io_mem_write(void *stream, const void *buf, size_t object_size, size_t objects_count, size_t *written_objects_count) {
 
     SAIL_CHECK_STREAM_PTR(stream);
@@ -187,6 +241,132 @@ static sail_status_t io_mem_write(void *stream, const void *buf, size_t object_s
     return SAIL_OK;
 }
 
+static sail_status_t io_mem_growing_seek64(void *stream, int64_t offset, int whence) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+
+    struct mem_io_buffer_info *mem_io_buffer_info = (struct mem_io_buffer_info *)stream;
+
+    uint64_t base;
+
+    switch (whence) {
+        case SEEK_SET: base = 0;                                     break;
+        case SEEK_CUR: base = mem_io_buffer_info->pos;               break;
+        case SEEK_END: base = mem_io_buffer_info->accessible_length; break;
+
+        default: {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_SEEK_WHENCE);
+        }
+    }
+
+    if (offset < 0 && (uint64_t)0 - (uint64_t)offset > base) {
+        SAIL_LOG_ERROR("Failed to seek to a negative position");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    const uint64_t new_pos = base + (uint64_t)offset;
+
+    if (new_pos > SIZE_MAX) {
+        SAIL_LOG_ERROR("Failed to seek beyond the addressable memory");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    /* Like with files, seeking beyond the end doesn't extend the buffer until something is written there. */
+    mem_io_buffer_info->pos = (size_t)new_pos;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mem_growing_seek(void *stream, long offset, int whence) {
+
+    SAIL_TRY(io_mem_growing_seek64(stream, offset, whence));
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mem_growing_write(void *stream, const void *buf, size_t object_size, size_t objects_count, size_t *written_objects_count) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_BUFFER_PTR(buf);
+    SAIL_CHECK_RESULT_PTR(written_objects_count);
+
+    struct mem_io_growing_write_stream *mem_io_growing_write_stream = (struct mem_io_growing_write_stream *)stream;
+    struct mem_io_buffer_info *mem_io_buffer_info = &mem_io_growing_write_stream->mem_io_buffer_info;
+
+    *written_objects_count = 0;
+
+    if (object_size != 0 && objects_count > (SIZE_MAX - mem_io_buffer_info->pos) / object_size) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    const size_t size = object_size * objects_count;
+    const size_t end = mem_io_buffer_info->pos + size;
+
+    /* Grow geometrically to keep the number of reallocations logarithmic. */
+    if (end > mem_io_buffer_info->length) {
+        size_t capacity = (mem_io_buffer_info->length < 4096) ? 4096 : mem_io_buffer_info->length;
+
+        while (capacity < end) {
+            capacity = (capacity > SIZE_MAX / 2) ? end : capacity * 2;
+        }
+
+        void *ptr = mem_io_growing_write_stream->buffer;
+        SAIL_TRY(sail_realloc(capacity, &ptr));
+
+        mem_io_growing_write_stream->buffer = ptr;
+        mem_io_buffer_info->length          = capacity;
+    }
+
+    /* Zero the gap left by seeking beyond the end. */
+    if (mem_io_buffer_info->pos > mem_io_buffer_info->accessible_length) {
+        memset((char *)mem_io_growing_write_stream->buffer + mem_io_buffer_info->accessible_length,
+                0,
+                mem_io_buffer_info->pos - mem_io_buffer_info->accessible_length);
+    }
+
+    memcpy((char *)mem_io_growing_write_stream->buffer + mem_io_buffer_info->pos, buf, size);
+    mem_io_buffer_info->pos = end;
+
+    if (end > mem_io_buffer_info->accessible_length) {
+        mem_io_buffer_info->accessible_length = end;
+    }
+
+    *written_objects_count = objects_count;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mem_growing_close(void *stream) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+
+    struct mem_io_growing_write_stream *mem_io_growing_write_stream = (struct mem_io_growing_write_stream *)stream;
+    struct mem_io_buffer_info *mem_io_buffer_info = &mem_io_growing_write_stream->mem_io_buffer_info;
+
+    void *buffer = mem_io_growing_write_stream->buffer;
+    const size_t length = mem_io_buffer_info->accessible_length;
+
+    if (length == 0) {
+        sail_free(buffer);
+        buffer = NULL;
+    } else if (length < mem_io_buffer_info->length) {
+        /* Shrink to fit. Keep the bigger buffer if it fails. */
+        void *ptr = buffer;
+
+        if (sail_realloc(length, &ptr) == SAIL_OK) {
+            buffer = ptr;
+        }
+    }
+
+    /* Hand the ownership over to the caller. */
+    *mem_io_growing_write_stream->result_buffer = buffer;
+    *mem_io_growing_write_stream->result_length = length;
+
+    sail_free(mem_io_growing_write_stream);
+
+    return SAIL_OK;
+}
+
 static sail_status_t io_mem_flush(void *stream) {
 
     SAIL_CHECK_STREAM_PTR(stream);
@@ -215,6 +395,271 @@ static sail_status_t io_mem_eof(void *stream, bool *result) {
     return SAIL_OK;
 }
 
+static sail_status_t io_mem_borrow(void *stream, size_t size, const void **buf, size_t *borrowed_size) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_BUFFER_PTR(buf);
+    SAIL_CHECK_RESULT_PTR(borrowed_size);
+
+    struct mem_io_read_stream *mem_io_read_stream = (struct mem_io_read_stream *)stream;
+    struct mem_io_buffer_info *mem_io_buffer_info = &mem_io_read_stream->mem_io_buffer_info;
+
+    if (mem_io_buffer_info->pos >= mem_io_buffer_info->accessible_length) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_EOF);
+    }
+
+    const size_t available = mem_io_buffer_info->accessible_length - mem_io_buffer_info->pos;
+
+    *buf           = (const char *)mem_io_read_stream->buffer + mem_io_buffer_info->pos;
+    *borrowed_size = (size < available) ? size : available;
+
+    mem_io_buffer_info->pos += *borrowed_size;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mem_read_at(void *stream, uint64_t offset, void *buf, size_t size, size_t *read_size) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_BUFFER_PTR(buf);
+    SAIL_CHECK_RESULT_PTR(read_size);
+
+    const struct mem_io_read_stream *mem_io_read_stream = (const struct mem_io_read_stream *)stream;
+    const struct mem_io_buffer_info *mem_io_buffer_info = &mem_io_read_stream->mem_io_buffer_info;
+
+    if (offset >= mem_io_buffer_info->accessible_length) {
+        *read_size = 0;
+        return SAIL_OK;
+    }
+
+    const size_t available = mem_io_buffer_info->accessible_length - (size_t)offset;
+
+    *read_size = (size < available) ? size : available;
+
+    memcpy(buf, (const char *)mem_io_read_stream->buffer + (size_t)offset, *read_size);
+
+    return SAIL_OK;
+}
+
+/* Returns the index of the segment containing the specified offset or segments_count if it's beyond the end. */
+static size_t mem_segment_by_offset(const struct mem_io_segments_read_stream *mem_io_segments_read_stream, size_t offset) {
+
+    if (offset >= mem_io_segments_read_stream->length) {
+        return mem_io_segments_read_stream->segments_count;
+    }
+
+    /* Binary search for the last segment starting at or before the offset. */
+    size_t low = 0;
+    size_t high = mem_io_segments_read_stream->segments_count;
+
+    while (high - low > 1) {
+        const size_t middle = low + (high - low) / 2;
+
+        if (mem_io_segments_read_stream->segments[middle].offset <= offset) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/*
+ * Copies size bytes starting at the specified offset located in the specified segment.
+ * The bytes must be available. Returns the index of the segment containing offset + size.
+ */
+static size_t mem_segments_copy(const struct mem_io_segments_read_stream *mem_io_segments_read_stream,
+                                size_t segment, size_t offset, void *buf, size_t size) {
+
+    while (size > 0) {
+        const struct mem_io_segment *mem_io_segment = &mem_io_segments_read_stream->segments[segment];
+
+        const size_t offset_in_segment = offset - mem_io_segment->offset;
+        const size_t available = mem_io_segment->length - offset_in_segment;
+        const size_t chunk = (size < available) ? size : available;
+
+        memcpy(buf, (const char *)mem_io_segment->buffer + offset_in_segment, chunk);
+
+        buf     = (char *)buf + chunk;
+        offset += chunk;
+        size   -= chunk;
+
+        if (chunk == available) {
+            segment++;
+        }
+    }
+
+    return segment;
+}
+
+static sail_status_t io_mem_segments_read(void *stream, void *buf, size_t object_size, size_t objects_count, size_t *read_objects_count) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_BUFFER_PTR(buf);
+    SAIL_CHECK_RESULT_PTR(read_objects_count);
+
+    struct mem_io_segments_read_stream *mem_io_segments_read_stream = (struct mem_io_segments_read_stream *)stream;
+
+    *read_objects_count = 0;
+
+    if (mem_io_segments_read_stream->pos >= mem_io_segments_read_stream->length) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_EOF);
+    }
+
+    /* Copy as many whole objects as available at once. */
+    const size_t available_objects = (object_size == 0)
+                                        ? 0
+                                        : (mem_io_segments_read_stream->length - mem_io_segments_read_stream->pos) / object_size;
+
+    *read_objects_count = (objects_count < available_objects) ? objects_count : available_objects;
+
+    const size_t size = *read_objects_count * object_size;
+
+    mem_io_segments_read_stream->segment = mem_segments_copy(mem_io_segments_read_stream,
+                                                             mem_io_segments_read_stream->segment,
+                                                             mem_io_segments_read_stream->pos,
+                                                             buf,
+                                                             size);
+    mem_io_segments_read_stream->pos += size;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mem_segments_seek64(void *stream, int64_t offset, int whence) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+
+    struct mem_io_segments_read_stream *mem_io_segments_read_stream = (struct mem_io_segments_read_stream *)stream;
+
+    uint64_t base;
+
+    switch (whence) {
+        case SEEK_SET: base = 0;                                   break;
+        case SEEK_CUR: base = mem_io_segments_read_stream->pos;    break;
+        case SEEK_END: base = mem_io_segments_read_stream->length; break;
+
+        default: {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_SEEK_WHENCE);
+        }
+    }
+
+    if (offset < 0 && (uint64_t)0 - (uint64_t)offset > base) {
+        SAIL_LOG_ERROR("Failed to seek to a negative position");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    uint64_t new_pos = base + (uint64_t)offset;
+
+    /* Correct the value like with contiguous memory buffers. */
+    if (new_pos > mem_io_segments_read_stream->length) {
+        new_pos = mem_io_segments_read_stream->length;
+    }
+
+    mem_io_segments_read_stream->pos     = (size_t)new_pos;
+    mem_io_segments_read_stream->segment = mem_segment_by_offset(mem_io_segments_read_stream, (size_t)new_pos);
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mem_segments_seek(void *stream, long offset, int whence) {
+
+    SAIL_TRY(io_mem_segments_seek64(stream, offset, whence));
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mem_segments_tell64(void *stream, uint64_t *offset) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_PTR(offset);
+
+    const struct mem_io_segments_read_stream *mem_io_segments_read_stream = (const struct mem_io_segments_read_stream *)stream;
+
+    *offset = mem_io_segments_read_stream->pos;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mem_segments_tell(void *stream, size_t *offset) {
+
+    uint64_t offset64;
+    SAIL_TRY(io_mem_segments_tell64(stream, &offset64));
+
+    SAIL_TRY(offset64_to_size(offset64, offset));
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mem_segments_eof(void *stream, bool *result) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_RESULT_PTR(result);
+
+    const struct mem_io_segments_read_stream *mem_io_segments_read_stream = (const struct mem_io_segments_read_stream *)stream;
+
+    *result = mem_io_segments_read_stream->pos >= mem_io_segments_read_stream->length;
+
+    return SAIL_OK;
+}
+
+/* Borrows bytes from the current segment only as the borrowed bytes must be contiguous. */
+static sail_status_t io_mem_segments_borrow(void *stream, size_t size, const void **buf, size_t *borrowed_size) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_BUFFER_PTR(buf);
+    SAIL_CHECK_RESULT_PTR(borrowed_size);
+
+    struct mem_io_segments_read_stream *mem_io_segments_read_stream = (struct mem_io_segments_read_stream *)stream;
+
+    if (mem_io_segments_read_stream->pos >= mem_io_segments_read_stream->length) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_EOF);
+    }
+
+    const struct mem_io_segment *mem_io_segment = &mem_io_segments_read_stream->segments[mem_io_segments_read_stream->segment];
+
+    const size_t offset_in_segment = mem_io_segments_read_stream->pos - mem_io_segment->offset;
+    const size_t available = mem_io_segment->length - offset_in_segment;
+
+    *buf           = (const char *)mem_io_segment->buffer + offset_in_segment;
+    *borrowed_size = (size < available) ? size : available;
+
+    mem_io_segments_read_stream->pos += *borrowed_size;
+
+    if (*borrowed_size == available) {
+        mem_io_segments_read_stream->segment++;
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mem_segments_read_at(void *stream, uint64_t offset, void *buf, size_t size, size_t *read_size) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_BUFFER_PTR(buf);
+    SAIL_CHECK_RESULT_PTR(read_size);
+
+    const struct mem_io_segments_read_stream *mem_io_segments_read_stream = (const struct mem_io_segments_read_stream *)stream;
+
+    if (offset >= mem_io_segments_read_stream->length) {
+        *read_size = 0;
+        return SAIL_OK;
+    }
+
+    const size_t available = mem_io_segments_read_stream->length - (size_t)offset;
+
+    *read_size = (size < available) ? size : available;
+
+    /* Doesn't touch the current segment index to stay thread-safe. */
+    mem_segments_copy(mem_io_segments_read_stream,
+                      mem_segment_by_offset(mem_io_segments_read_stream, (size_t)offset),
+                      (size_t)offset,
+                      buf,
+                      *read_size);
+
+    return SAIL_OK;
+}
+
 /*
  * Public functions.
  */
@@ -238,15 +683,19 @@ sail_status_t alloc_io_read_mem(const void *buffer, size_t length, struct sail_i
     mem_io_read_stream->mem_io_buffer_info.pos               = 0;
     mem_io_read_stream->buffer                               = buffer;
 
-    (*io)->id     = SAIL_MEMORY_IO_ID;
-    (*io)->stream = mem_io_read_stream;
-    (*io)->read   = io_mem_read;
-    (*io)->seek   = io_mem_seek;
-    (*io)->tell   = io_mem_tell;
-    (*io)->write  = io_noop_write;
-    (*io)->flush  = io_noop_flush;
-    (*io)->close  = io_mem_close;
-    (*io)->eof    = io_mem_eof;
+    (*io)->id      = SAIL_MEMORY_IO_ID;
+    (*io)->stream  = mem_io_read_stream;
+    (*io)->read    = io_mem_read;
+    (*io)->seek    = io_mem_seek;
+    (*io)->tell    = io_mem_tell;
+    (*io)->seek64  = io_mem_seek64;
+    (*io)->tell64  = io_mem_tell64;
+    (*io)->write   = io_noop_write;
+    (*io)->flush   = io_noop_flush;
+    (*io)->close   = io_mem_close;
+    (*io)->eof     = io_mem_eof;
+    (*io)->borrow  = io_mem_borrow;
+    (*io)->read_at = io_mem_read_at;
 
     return SAIL_OK;
 }
@@ -275,6 +724,8 @@ sail_status_t alloc_io_write_mem(void *buffer, size_t length, struct sail_io **i
     (*io)->read   = io_mem_read;
     (*io)->seek   = io_mem_seek;
     (*io)->tell   = io_mem_tell;
+    (*io)->seek64 = io_mem_seek64;
+    (*io)->tell64 = io_mem_tell64;
     (*io)->write  = io_mem_write;
     (*io)->flush  = io_mem_flush;
     (*io)->close  = io_mem_close;
@@ -282,3 +733,116 @@ sail_status_t alloc_io_write_mem(void *buffer, size_t length, struct sail_io **i
 
     return SAIL_OK;
 }
+
+sail_status_t alloc_io_write_growing_mem(void **buffer, size_t *length, struct sail_io **io) {
+
+    SAIL_CHECK_BUFFER_PTR(buffer);
+    SAIL_CHECK_PTR(length);
+    SAIL_CHECK_IO_PTR(io);
+
+    SAIL_LOG_DEBUG("Opening growing memory buffer for writing");
+
+    *buffer = NULL;
+    *length = 0;
+
+    SAIL_TRY(sail_alloc_io(io));
+
+    void *ptr;
+    SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(struct mem_io_growing_write_stream), &ptr),
+                        /* cleanup */ sail_destroy_io(*io));
+    struct mem_io_growing_write_stream *mem_io_growing_write_stream = ptr;
+
+    mem_io_growing_write_stream->mem_io_buffer_info.length            = 0;
+    mem_io_growing_write_stream->mem_io_buffer_info.accessible_length = 0;
+    mem_io_growing_write_stream->mem_io_buffer_info.pos               = 0;
+    mem_io_growing_write_stream->buffer                               = NULL;
+    mem_io_growing_write_stream->result_buffer                        = buffer;
+    mem_io_growing_write_stream->result_length                        = length;
+
+    (*io)->id     = SAIL_MEMORY_IO_ID;
+    (*io)->stream = mem_io_growing_write_stream;
+    (*io)->read   = io_mem_read;
+    (*io)->seek   = io_mem_growing_seek;
+    (*io)->tell   = io_mem_tell;
+    (*io)->seek64 = io_mem_growing_seek64;
+    (*io)->tell64 = io_mem_tell64;
+    (*io)->write  = io_mem_growing_write;
+    (*io)->flush  = io_mem_flush;
+    (*io)->close  = io_mem_growing_close;
+    (*io)->eof    = io_mem_eof;
+
+    return SAIL_OK;
+}
+
+sail_status_t alloc_io_read_mem_segments(const struct sail_mem_segment *segments, size_t segments_count, struct sail_io **io) {
+
+    SAIL_CHECK_PTR(segments);
+    SAIL_CHECK_IO_PTR(io);
+
+    /* Validate the segments and count non-empty ones. */
+    size_t length = 0;
+    size_t non_empty_segments_count = 0;
+
+    for (size_t i = 0; i < segments_count; i++) {
+        if (segments[i].length == 0) {
+            continue;
+        }
+
+        SAIL_CHECK_BUFFER_PTR(segments[i].buffer);
+
+        if (segments[i].length > SIZE_MAX - length) {
+            SAIL_LOG_ERROR("The total length of the memory segments is too big");
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+        }
+
+        length += segments[i].length;
+        non_empty_segments_count++;
+    }
+
+    SAIL_LOG_DEBUG("Opening %lu memory segments of total size %lu for reading",
+                    (unsigned long)non_empty_segments_count, (unsigned long)length);
+
+    SAIL_TRY(sail_alloc_io(io));
+
+    void *ptr;
+    SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(struct mem_io_segments_read_stream) + non_empty_segments_count * sizeof(struct mem_io_segment), &ptr),
+                        /* cleanup */ sail_destroy_io(*io));
+    struct mem_io_segments_read_stream *mem_io_segments_read_stream = ptr;
+
+    mem_io_segments_read_stream->length         = length;
+    mem_io_segments_read_stream->pos            = 0;
+    mem_io_segments_read_stream->segment        = 0;
+    mem_io_segments_read_stream->segments_count = non_empty_segments_count;
+
+    /* Only the segment descriptors are copied, not the data. */
+    size_t offset = 0;
+
+    for (size_t i = 0, j = 0; i < segments_count; i++) {
+        if (segments[i].length == 0) {
+            continue;
+        }
+
+        mem_io_segments_read_stream->segments[j].buffer = segments[i].buffer;
+        mem_io_segments_read_stream->segments[j].length = segments[i].length;
+        mem_io_segments_read_stream->segments[j].offset = offset;
+
+        offset += segments[i].length;
+        j++;
+    }
+
+    (*io)->id      = SAIL_MEM_SEGMENTS_IO_ID;
+    (*io)->stream  = mem_io_segments_read_stream;
+    (*io)->read    = io_mem_segments_read;
+    (*io)->seek    = io_mem_segments_seek;
+    (*io)->tell    = io_mem_segments_tell;
+    (*io)->seek64  = io_mem_segments_seek64;
+    (*io)->tell64  = io_mem_segments_tell64;
+    (*io)->write   = io_noop_write;
+    (*io)->flush   = io_noop_flush;
+    (*io)->close   = io_mem_close;
+    (*io)->eof     = io_mem_segments_eof;
+    (*io)->borrow  = io_mem_segments_borrow;
+    (*io)->read_at = io_mem_segments_read_at;
+
+    return SAIL_OK;
+}
@@ -37,15 +37,27 @@
 #endif
 
 struct sail_io;
+struct sail_mem_segment;
 
 /*
  * Opens the specified memory buffer for reading and allocates a new I/O object for it.
+ * The I/O object supports borrowing the buffer contents without copying.
  * The assigned I/O object MUST be destroyed later with sail_destroy_io().
  *
  * Returns SAIL_OK on success.
  */
 SAIL_HIDDEN sail_status_t alloc_io_read_mem(const void *buffer, size_t length, struct sail_io **io);
 
+/*
+ * Opens the specified list of memory segments for reading as a single logical stream
+ * and allocates a new I/O object for it. Only the segment descriptors are copied, the segment data
+ * MUST stay valid until the I/O object is destroyed. Borrowing never crosses segment boundaries.
+ * The assigned I/O object MUST be destroyed later with sail_destroy_io().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t alloc_io_read_mem_segments(const struct sail_mem_segment *segments, size_t segments_count, struct sail_io **io);
+
 /*
  * Opens the specified memory buffer for writing and allocates a new I/O object for it.
  * The assigned I/O object MUST be destroyed later with sail_destroy_io().
@@ -54,4 +66,15 @@ SAIL_HIDDEN sail_status_t alloc_io_read_mem(const void *buffer, size_t length, s
  */
 SAIL_HIDDEN sail_status_t alloc_io_write_mem(void *buffer, size_t length, struct sail_io **io);
 
+/*
+ * Allocates a new I/O object that writes into a memory buffer growing on demand.
+ * When the I/O object is closed, the final buffer and its length are assigned to the specified
+ * pointers which must stay valid until then. The caller takes the ownership of the buffer
+ * and MUST free it with sail_free(). The buffer is NULL if nothing was written.
+ * The assigned I/O object MUST be destroyed later with sail_destroy_io().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t alloc_io_write_growing_mem(void **buffer, size_t *length, struct sail_io **io);
+
 #endif
@@ -0,0 +1,243 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sail-common.h"
+#include "sail.h"
+
+struct mmap_io_stream {
+    struct file_mapping *file_mapping;
+
+    /* Current stream position. Could be beyond the end of the mapping after seeking. */
+    size_t pos;
+};
+
+/*
+ * Private functions.
+ */
+
+static size_t io_mmap_available(const struct mmap_io_stream *mmap_io_stream) {
+
+    const size_t size = mmap_io_stream->file_mapping->size;
+
+    return mmap_io_stream->pos < size ? size - mmap_io_stream->pos : 0;
+}
+
+static sail_status_t io_mmap_read(void *stream, void *buf, size_t object_size, size_t objects_count, size_t *read_objects_count) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_BUFFER_PTR(buf);
+    SAIL_CHECK_RESULT_PTR(read_objects_count);
+
+    struct mmap_io_stream *mmap_io_stream = stream;
+
+    /* Same semantics as fread(): read as many whole objects as available. */
+    const size_t available_objects = object_size == 0 ? 0 : io_mmap_available(mmap_io_stream) / object_size;
+
+    *read_objects_count = objects_count < available_objects ? objects_count : available_objects;
+
+    const size_t size = *read_objects_count * object_size;
+
+    memcpy(buf, (const char *)mmap_io_stream->file_mapping->data + mmap_io_stream->pos, size);
+    mmap_io_stream->pos += size;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_seek64(void *stream, int64_t offset, int whence) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+
+    struct mmap_io_stream *mmap_io_stream = stream;
+
+    int64_t base;
+
+    switch (whence) {
+        case SEEK_SET: base = 0;                                           break;
+        case SEEK_CUR: base = (int64_t)mmap_io_stream->pos;                break;
+        case SEEK_END: base = (int64_t)mmap_io_stream->file_mapping->size; break;
+
+        default: {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_SEEK_WHENCE);
+        }
+    }
+
+    if (offset < -base) {
+        SAIL_LOG_ERROR("Failed to seek to a negative position");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    /* Like with files, seeking beyond the end is allowed. Saturate positions not addressable in memory. */
+    const uint64_t new_pos = (uint64_t)base + (uint64_t)offset;
+
+    mmap_io_stream->pos = (new_pos > SIZE_MAX) ? SIZE_MAX : (size_t)new_pos;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_seek(void *stream, long offset, int whence) {
+
+    SAIL_TRY(io_mmap_seek64(stream, offset, whence));
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_tell64(void *stream, uint64_t *offset) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_PTR(offset);
+
+    const struct mmap_io_stream *mmap_io_stream = stream;
+
+    *offset = mmap_io_stream->pos;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_tell(void *stream, size_t *offset) {
+
+    uint64_t offset64;
+    SAIL_TRY(io_mmap_tell64(stream, &offset64));
+
+    SAIL_TRY(offset64_to_size(offset64, offset));
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_close(void *stream) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+
+    struct mmap_io_stream *mmap_io_stream = stream;
+
+    unmap_file(mmap_io_stream->file_mapping);
+    sail_free(mmap_io_stream);
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_eof(void *stream, bool *result) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_RESULT_PTR(result);
+
+    const struct mmap_io_stream *mmap_io_stream = stream;
+
+    *result = mmap_io_stream->pos >= mmap_io_stream->file_mapping->size;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_borrow(void *stream, size_t size, const void **buf, size_t *borrowed_size) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_BUFFER_PTR(buf);
+    SAIL_CHECK_RESULT_PTR(borrowed_size);
+
+    struct mmap_io_stream *mmap_io_stream = stream;
+
+    const size_t available = io_mmap_available(mmap_io_stream);
+
+    if (available == 0) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_EOF);
+    }
+
+    *buf           = (const char *)mmap_io_stream->file_mapping->data + mmap_io_stream->pos;
+    *borrowed_size = size < available ? size : available;
+
+    mmap_io_stream->pos += *borrowed_size;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_read_at(void *stream, uint64_t offset, void *buf, size_t size, size_t *read_size) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_BUFFER_PTR(buf);
+    SAIL_CHECK_RESULT_PTR(read_size);
+
+    const struct mmap_io_stream *mmap_io_stream = stream;
+    const struct file_mapping *file_mapping = mmap_io_stream->file_mapping;
+
+    if (offset >= file_mapping->size) {
+        *read_size = 0;
+        return SAIL_OK;
+    }
+
+    const size_t available = file_mapping->size - (size_t)offset;
+
+    *read_size = size < available ? size : available;
+
+    memcpy(buf, (const char *)file_mapping->data + (size_t)offset, *read_size);
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t alloc_io_read_mmap(const char *path, struct sail_io **io) {
+
+    SAIL_CHECK_PATH_PTR(path);
+    SAIL_CHECK_IO_PTR(io);
+
+    SAIL_LOG_DEBUG("Mapping file '%s' for reading", path);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct mmap_io_stream), &ptr));
+    struct mmap_io_stream *mmap_io_stream = ptr;
+
+    mmap_io_stream->pos = 0;
+
+    SAIL_TRY_OR_CLEANUP(map_file(path, &mmap_io_stream->file_mapping),
+                        /* cleanup */ sail_free(mmap_io_stream));
+
+    SAIL_TRY_OR_CLEANUP(sail_alloc_io(io),
+                        /* cleanup */ unmap_file(mmap_io_stream->file_mapping),
+                                      sail_free(mmap_io_stream));
+
+    (*io)->id      = SAIL_MMAP_IO_ID;
+    (*io)->stream  = mmap_io_stream;
+    (*io)->read    = io_mmap_read;
+    (*io)->seek    = io_mmap_seek;
+    (*io)->tell    = io_mmap_tell;
+    (*io)->seek64  = io_mmap_seek64;
+    (*io)->tell64  = io_mmap_tell64;
+    (*io)->write   = io_noop_write;
+    (*io)->flush   = io_noop_flush;
+    (*io)->close   = io_mmap_close;
+    (*io)->eof     = io_mmap_eof;
+    (*io)->borrow  = io_mmap_borrow;
+    (*io)->read_at = io_mmap_read_at;
+
+    return SAIL_OK;
+}
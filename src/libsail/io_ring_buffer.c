@@ -0,0 +1,339 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sail-common.h"
+#include "sail.h"
+
+/* The size of chunks used to skip data when seeking forward. */
+#define SAIL_RING_BUFFER_SKIP_CHUNK_SIZE 4096
+
+struct ring_buffer_io_stream {
+    struct sail_io *source;
+
+    /* Keeps the last window_size bytes read from the source. Offset N is stored at N % window_size. */
+    unsigned char *window;
+    size_t window_size;
+
+    /* The number of valid bytes in the window. */
+    size_t window_filled;
+
+    /* The number of bytes read from the source so far. */
+    uint64_t source_pos;
+
+    /* Current stream position. Could be behind source_pos after seeking back. */
+    uint64_t pos;
+
+    bool source_eof;
+};
+
+/*
+ * Private functions.
+ */
+
+static void append_to_window(struct ring_buffer_io_stream *ring_buffer_io_stream, const unsigned char *data, size_t size) {
+
+    const size_t window_size = ring_buffer_io_stream->window_size;
+
+    /* Only the last window_size bytes survive. */
+    if (size > window_size) {
+        data += size - window_size;
+        ring_buffer_io_stream->source_pos += size - window_size;
+        size = window_size;
+    }
+
+    const size_t start = (size_t)(ring_buffer_io_stream->source_pos % window_size);
+    const size_t first_part = (size < window_size - start) ? size : window_size - start;
+
+    memcpy(ring_buffer_io_stream->window + start, data, first_part);
+    memcpy(ring_buffer_io_stream->window, data + first_part, size - first_part);
+
+    ring_buffer_io_stream->source_pos += size;
+    ring_buffer_io_stream->window_filled = (ring_buffer_io_stream->window_filled + size < window_size)
+                                            ? ring_buffer_io_stream->window_filled + size
+                                            : window_size;
+}
+
+/* Reads up to size bytes from the source and remembers them in the window. */
+static sail_status_t read_from_source(struct ring_buffer_io_stream *ring_buffer_io_stream, void *buf, size_t size, size_t *read_size) {
+
+    struct sail_io *source = ring_buffer_io_stream->source;
+
+    *read_size = 0;
+
+    /* Pipes and sockets could return less than requested. Read until the buffer is full or EOF is reached. */
+    while (*read_size < size && !ring_buffer_io_stream->source_eof) {
+        size_t nbytes;
+        const sail_status_t status = source->read(source->stream, (unsigned char *)buf + *read_size, 1, size - *read_size, &nbytes);
+
+        if (status == SAIL_ERROR_EOF || (status == SAIL_OK && nbytes == 0)) {
+            ring_buffer_io_stream->source_eof = true;
+            break;
+        }
+
+        SAIL_TRY(status);
+
+        append_to_window(ring_buffer_io_stream, (unsigned char *)buf + *read_size, nbytes);
+        *read_size += nbytes;
+    }
+
+    return SAIL_OK;
+}
+
+/* Reads and discards data from the source until the specified offset or EOF is reached. */
+static sail_status_t skip_source_to(struct ring_buffer_io_stream *ring_buffer_io_stream, uint64_t offset) {
+
+    unsigned char chunk[SAIL_RING_BUFFER_SKIP_CHUNK_SIZE];
+
+    while (ring_buffer_io_stream->source_pos < offset && !ring_buffer_io_stream->source_eof) {
+        const uint64_t left = offset - ring_buffer_io_stream->source_pos;
+        size_t nbytes;
+
+        SAIL_TRY(read_from_source(ring_buffer_io_stream, chunk, (left < sizeof(chunk)) ? (size_t)left : sizeof(chunk), &nbytes));
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_ring_buffer_read(void *stream, void *buf, size_t object_size, size_t objects_count, size_t *read_objects_count) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_BUFFER_PTR(buf);
+    SAIL_CHECK_RESULT_PTR(read_objects_count);
+
+    struct ring_buffer_io_stream *ring_buffer_io_stream = stream;
+
+    *read_objects_count = 0;
+
+    if (object_size == 0 || objects_count == 0) {
+        return SAIL_OK;
+    }
+
+    /* Could happen after seeking beyond the end of the source. */
+    if (ring_buffer_io_stream->pos > ring_buffer_io_stream->source_pos) {
+        return SAIL_OK;
+    }
+
+    const size_t size = object_size * objects_count;
+    size_t done = 0;
+
+    /* Replay the window first if we seeked back. */
+    while (done < size && ring_buffer_io_stream->pos < ring_buffer_io_stream->source_pos) {
+        const size_t start = (size_t)(ring_buffer_io_stream->pos % ring_buffer_io_stream->window_size);
+        const uint64_t behind = ring_buffer_io_stream->source_pos - ring_buffer_io_stream->pos;
+
+        size_t chunk = ring_buffer_io_stream->window_size - start;
+        chunk = (behind < chunk) ? (size_t)behind : chunk;
+        chunk = (chunk < size - done) ? chunk : size - done;
+
+        memcpy((unsigned char *)buf + done, ring_buffer_io_stream->window + start, chunk);
+
+        done += chunk;
+        ring_buffer_io_stream->pos += chunk;
+    }
+
+    if (done < size) {
+        size_t nbytes;
+        SAIL_TRY(read_from_source(ring_buffer_io_stream, (unsigned char *)buf + done, size - done, &nbytes));
+
+        done += nbytes;
+        ring_buffer_io_stream->pos += nbytes;
+    }
+
+    *read_objects_count = done / object_size;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_ring_buffer_seek64(void *stream, int64_t offset, int whence) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+
+    struct ring_buffer_io_stream *ring_buffer_io_stream = stream;
+
+    uint64_t base;
+
+    switch (whence) {
+        case SEEK_SET: {
+            base = 0;
+            break;
+        }
+
+        case SEEK_CUR: {
+            base = ring_buffer_io_stream->pos;
+            break;
+        }
+
+        case SEEK_END: {
+            /* The end is unknown until the whole source is read. */
+            SAIL_TRY(skip_source_to(ring_buffer_io_stream, UINT64_MAX));
+            base = ring_buffer_io_stream->source_pos;
+            break;
+        }
+
+        default: {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_SEEK_WHENCE);
+        }
+    }
+
+    if (offset < 0 && (uint64_t)0 - (uint64_t)offset > base) {
+        SAIL_LOG_ERROR("Failed to seek to a negative position");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    const uint64_t new_pos = base + (uint64_t)offset;
+
+    if (new_pos < ring_buffer_io_stream->source_pos - ring_buffer_io_stream->window_filled) {
+        SAIL_LOG_ERROR("Failed to seek to %llu, it's beyond the rewind window of %lu bytes",
+                        (unsigned long long)new_pos, (unsigned long)ring_buffer_io_stream->window_size);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_SEEK_IO);
+    }
+
+    SAIL_TRY(skip_source_to(ring_buffer_io_stream, new_pos));
+
+    ring_buffer_io_stream->pos = new_pos;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_ring_buffer_seek(void *stream, long offset, int whence) {
+
+    SAIL_TRY(io_ring_buffer_seek64(stream, offset, whence));
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_ring_buffer_tell64(void *stream, uint64_t *offset) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_PTR(offset);
+
+    const struct ring_buffer_io_stream *ring_buffer_io_stream = stream;
+
+    *offset = ring_buffer_io_stream->pos;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_ring_buffer_tell(void *stream, size_t *offset) {
+
+    uint64_t offset64;
+    SAIL_TRY(io_ring_buffer_tell64(stream, &offset64));
+
+    SAIL_TRY(offset64_to_size(offset64, offset));
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_ring_buffer_close(void *stream) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+
+    struct ring_buffer_io_stream *ring_buffer_io_stream = stream;
+
+    /* The source is owned by the caller. */
+    sail_free(ring_buffer_io_stream->window);
+    sail_free(ring_buffer_io_stream);
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_ring_buffer_eof(void *stream, bool *result) {
+
+    SAIL_CHECK_STREAM_PTR(stream);
+    SAIL_CHECK_RESULT_PTR(result);
+
+    struct ring_buffer_io_stream *ring_buffer_io_stream = stream;
+
+    if (ring_buffer_io_stream->pos < ring_buffer_io_stream->source_pos) {
+        *result = false;
+        return SAIL_OK;
+    }
+
+    if (!ring_buffer_io_stream->source_eof) {
+        bool source_eof;
+        SAIL_TRY(ring_buffer_io_stream->source->eof(ring_buffer_io_stream->source->stream, &source_eof));
+        ring_buffer_io_stream->source_eof = source_eof;
+    }
+
+    *result = ring_buffer_io_stream->source_eof;
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t alloc_io_read_ring_buffer(struct sail_io *source, size_t window_size, struct sail_io **io) {
+
+    SAIL_CHECK_IO(source);
+    SAIL_CHECK_IO_PTR(io);
+
+    if (window_size == 0) {
+        window_size = SAIL_RING_BUFFER_DEFAULT_WINDOW_SIZE;
+    }
+
+    SAIL_LOG_DEBUG("Opening ring buffer with the rewind window of %lu bytes for reading", (unsigned long)window_size);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct ring_buffer_io_stream), &ptr));
+    struct ring_buffer_io_stream *ring_buffer_io_stream = ptr;
+
+    SAIL_TRY_OR_CLEANUP(sail_malloc(window_size, &ptr),
+                        /* cleanup */ sail_free(ring_buffer_io_stream));
+
+    ring_buffer_io_stream->source        = source;
+    ring_buffer_io_stream->window        = ptr;
+    ring_buffer_io_stream->window_size   = window_size;
+    ring_buffer_io_stream->window_filled = 0;
+    ring_buffer_io_stream->source_pos    = 0;
+    ring_buffer_io_stream->pos           = 0;
+    ring_buffer_io_stream->source_eof    = false;
+
+    SAIL_TRY_OR_CLEANUP(sail_alloc_io(io),
+                        /* cleanup */ sail_free(ring_buffer_io_stream->window),
+                                      sail_free(ring_buffer_io_stream));
+
+    (*io)->id     = SAIL_RING_BUFFER_IO_ID;
+    (*io)->stream = ring_buffer_io_stream;
+    (*io)->read   = io_ring_buffer_read;
+    (*io)->seek   = io_ring_buffer_seek;
+    (*io)->tell   = io_ring_buffer_tell;
+    (*io)->seek64 = io_ring_buffer_seek64;
+    (*io)->tell64 = io_ring_buffer_tell64;
+    (*io)->write  = io_noop_write;
+    (*io)->flush  = io_noop_flush;
+    (*io)->close  = io_ring_buffer_close;
+    (*io)->eof    = io_ring_buffer_eof;
+
+    return SAIL_OK;
+}
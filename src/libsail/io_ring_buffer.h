@@ -0,0 +1,59 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_IO_RING_BUFFER_H
+#define SAIL_IO_RING_BUFFER_H
+
+#include <stddef.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+struct sail_io;
+
+/* Default size of the rewind window used when 0 is passed to alloc_io_read_ring_buffer(). */
+#define SAIL_RING_BUFFER_DEFAULT_WINDOW_SIZE (64 * 1024)
+
+/*
+ * Allocates a new I/O object that reads the specified source sequentially and keeps the last
+ * window_size bytes read in a ring buffer. This makes the I/O object seekable backward within
+ * the window and forward by reading and discarding data. Seeking backward beyond the window fails.
+ * If window_size is 0, SAIL_RING_BUFFER_DEFAULT_WINDOW_SIZE is used.
+ *
+ * The source is only read with read() and eof(). It MUST stay valid while the I/O object is used
+ * and it's NOT closed when the I/O object is destroyed.
+ *
+ * The assigned I/O object MUST be destroyed later with sail_destroy_io().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t alloc_io_read_ring_buffer(struct sail_io *source, size_t window_size, struct sail_io **io);
+
+#endif
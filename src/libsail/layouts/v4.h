@@ -102,6 +102,25 @@ sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_read_seek_next_pass_v4)(void
  */
 sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_read_frame_v4)(void *state, struct sail_io *io, struct sail_image *image);
 
+/*
+ * Reads the next scan_lines_count scan lines of the current frame into the specified buffer. Scan lines
+ * are separated with image->bytes_per_line bytes. The image pixels are NOT allocated. This method is used
+ * to read frames by bands without holding whole frames in memory.
+ *
+ * When scan_lines is NULL, the scan lines must be skipped as fast as possible. libsail skips the scan lines
+ * outside of the region of interest this way. Codecs could also use the region of interest from the read options
+ * to decode only the columns covering it. Other columns of the output scan lines are ignored in this case.
+ *
+ * libsail calls sail_codec_read_seek_next_pass() once and then calls this method until all the scan lines
+ * of the frame are read. It's never called for interlaced frames.
+ *
+ * This method is optional and only called for codecs with SAIL_CODEC_FEATURE_SCAN_LINES in their read features.
+ *
+ * Returns SAIL_OK on success.
+ */
+sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_read_scan_lines_v4)(void *state, struct sail_io *io, const struct sail_image *image,
+                                                                        void *scan_lines, unsigned scan_lines_count);
+
 /*
  * Finilizes reading operation. No more readings are possible after calling this function.
  * This function doesn't close the io stream. It just stops decoding. Use io->close() or sail_destroy_io()
@@ -31,14 +31,21 @@
 #ifdef SAIL_BUILD
     #include "sail-common.h"
 
+    #include "codecs_cache.h"
+    #include "codecs_cache_private.h"
     #include "context.h"
     #include "context_private.h"
+    #include "file_mapping.h"
     #include "ini.h"
+    #include "io_counting.h"
     #include "io_file.h"
     #include "io_mem.h"
+    #include "io_mmap.h"
     #include "io_noop.h"
+    #include "io_ring_buffer.h"
     #include "codec.h"
     #include "codec_info.h"
+    #include "codec_info_index.h"
     #include "codec_info_node.h"
     #include "codec_info_private.h"
     #include "sail_advanced.h"
@@ -48,11 +55,13 @@
     #include "sail_technical_diver.h"
     #include "sail_technical_diver_private.h"
     #include "string_node.h"
+    #include "threading.h"
 #else
     #include <sail-common/sail-common.h>
 
     #include <sail/codec_info.h>
     #include <sail/codec_info_node.h>
+    #include <sail/codecs_cache.h>
     #include <sail/context.h>
     #include <sail/sail_advanced.h>
     #include <sail/sail_deep_diver.h>
@@ -25,6 +25,8 @@
 
 #include "config.h"
 
+#include <limits.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #include "sail-common.h"
@@ -34,6 +36,19 @@ sail_status_t sail_probe_io(struct sail_io *io, struct sail_image **image, const
 
     SAIL_CHECK_IO_PTR(io);
 
+    /* Read non-seekable sources through a ring buffer to rewind them after reading the magic number. */
+    if (io->features & SAIL_IO_FEATURE_NON_SEEKABLE) {
+        struct sail_io *ring_buffer_io;
+        SAIL_TRY(alloc_io_read_ring_buffer(io, 0 /* default window size */, &ring_buffer_io));
+
+        SAIL_TRY_OR_CLEANUP(sail_probe_io(ring_buffer_io, image, codec_info),
+                            /* cleanup */ sail_destroy_io(ring_buffer_io));
+
+        sail_destroy_io(ring_buffer_io);
+
+        return SAIL_OK;
+    }
+
     const struct sail_codec_info *codec_info_noop;
     const struct sail_codec_info **codec_info_local = codec_info == NULL ? &codec_info_noop : codec_info;
 
@@ -48,6 +63,9 @@ sail_status_t sail_probe_io(struct sail_io *io, struct sail_image **image, const
     SAIL_TRY_OR_CLEANUP(sail_alloc_read_options_from_features((*codec_info_local)->read_features, &read_options_local),
                         /* cleanup */ sail_destroy_read_options(read_options_local));
 
+    /* Parse headers only. */
+    read_options_local->io_options |= SAIL_IO_OPTION_PROBE;
+
     SAIL_TRY_OR_CLEANUP(codec->v4->read_init(io, read_options_local, &state),
                         /* cleanup */ codec->v4->read_finish(&state, io),
                                       sail_destroy_read_options(read_options_local));
@@ -90,6 +108,14 @@ sail_status_t sail_start_reading_mem(const void *buffer, size_t buffer_length, c
     return SAIL_OK;
 }
 
+sail_status_t sail_start_reading_mem_segments(const struct sail_mem_segment *segments, size_t segments_count,
+                                             const struct sail_codec_info *codec_info, void **state) {
+
+    SAIL_TRY(sail_start_reading_mem_segments_with_options(segments, segments_count, codec_info, NULL, state));
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_read_next_frame(void *state, struct sail_image **image) {
 
     SAIL_CHECK_STATE_PTR(state);
@@ -101,38 +127,122 @@ sail_status_t sail_read_next_frame(void *state, struct sail_image **image) {
     SAIL_CHECK_STATE_PTR(state_of_mind->state);
     SAIL_CHECK_CODEC_PTR(state_of_mind->codec);
 
-    SAIL_TRY(state_of_mind->codec->v4->read_seek_next_frame(state_of_mind->state, state_of_mind->io, image));
+    SAIL_TRY(seek_next_frame_to_read(state_of_mind, image));
 
-    /* Detect the number of passes needed to write an interlaced image. */
-    int interlaced_passes;
-    if ((*image)->source_image->properties & SAIL_IMAGE_PROPERTY_INTERLACED) {
-        interlaced_passes = (*image)->interlaced_passes;
+    SAIL_TRY_OR_CLEANUP(read_frame_pixels(state_of_mind, *image),
+                        /* cleanup */ sail_destroy_image(*image));
 
-        if (interlaced_passes < 1) {
-            sail_destroy_image(*image);
-            SAIL_LOG_AND_RETURN(SAIL_ERROR_INTERLACING_UNSUPPORTED);
+    return SAIL_OK;
+}
+
+sail_status_t sail_read_next_frame_to_buffer(void *state, void *buffer, size_t buffer_size, unsigned bytes_per_line,
+                                            struct sail_image **image) {
+
+    SAIL_CHECK_STATE_PTR(state);
+    SAIL_CHECK_BUFFER_PTR(buffer);
+    SAIL_CHECK_IMAGE_PTR(image);
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_CHECK_IO(state_of_mind->io);
+    SAIL_CHECK_STATE_PTR(state_of_mind->state);
+    SAIL_CHECK_CODEC_PTR(state_of_mind->codec);
+
+    const bool by_rows = transform_requested(state_of_mind);
+
+    /* Resume the frame seeked by the previous call that failed because of a too small buffer. */
+    struct sail_image *image_local = state_of_mind->pending_image;
+    state_of_mind->pending_image = NULL;
+
+    if (image_local == NULL) {
+        if (by_rows) {
+            SAIL_TRY(sail_read_next_frame_header(state, &image_local));
+        } else {
+            SAIL_TRY(read_seek_next_frame(state_of_mind, &image_local));
         }
+    }
+
+    /* Validate the caller buffer against the actual frame dimensions before decoding any pixels. */
+    uint64_t min_bytes_per_line;
+    SAIL_TRY_OR_CLEANUP(sail_bytes_per_line64(image_local->width, image_local->pixel_format, &min_bytes_per_line),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    if (min_bytes_per_line > UINT_MAX) {
+        SAIL_LOG_ERROR("The %ux%u frame is too wide to be read into a buffer", image_local->width, image_local->height);
+        sail_destroy_image(image_local);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INCORRECT_IMAGE_DIMENSIONS);
+    }
+
+    if (bytes_per_line == 0) {
+        bytes_per_line = (unsigned)min_bytes_per_line;
+    } else if (bytes_per_line < min_bytes_per_line) {
+        SAIL_LOG_ERROR("Bytes per line %u is less than %llu needed to hold a scan line", bytes_per_line, (unsigned long long)min_bytes_per_line);
+        state_of_mind->pending_image = image_local;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INCORRECT_BYTES_PER_LINE);
+    }
+
+    const size_t stride = bytes_per_line;
+
+    if (image_local->height > 0 && stride > buffer_size / image_local->height) {
+        SAIL_LOG_ERROR("The buffer of %lu bytes is too small to hold %ux%u pixels with %u bytes per line",
+                        (unsigned long)buffer_size, image_local->width, image_local->height, bytes_per_line);
+        state_of_mind->pending_image = image_local;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    /* Codecs honor bytes per line, so they write scan lines directly into the caller buffer. */
+    image_local->bytes_per_line = bytes_per_line;
+    image_local->pixels         = buffer;
+
+    if (by_rows) {
+        SAIL_TRY_OR_CLEANUP(read_rows(state_of_mind, buffer, bytes_per_line, image_local->height),
+                            /* cleanup */ image_local->pixels = NULL,
+                                          sail_destroy_image(image_local));
     } else {
-        interlaced_passes = 1;
+        SAIL_TRY_OR_CLEANUP(read_frame_passes(state_of_mind, image_local),
+                            /* cleanup */ image_local->pixels = NULL,
+                                          sail_destroy_image(image_local));
     }
 
-    /* Allocate pixels. */
-    unsigned pixels_size;
-    SAIL_TRY_OR_CLEANUP(sail_bytes_per_image(*image, &pixels_size),
-                        /* cleanup */ sail_destroy_image(*image));
+    /* The buffer is owned by the caller. */
+    image_local->pixels = NULL;
+
+    *image = image_local;
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_read_next_frame_header(void *state, struct sail_image **image) {
+
+    SAIL_CHECK_STATE_PTR(state);
+    SAIL_CHECK_IMAGE_PTR(image);
 
-    SAIL_TRY_OR_CLEANUP(sail_malloc(pixels_size, &(*image)->pixels),
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_CHECK_IO(state_of_mind->io);
+    SAIL_CHECK_STATE_PTR(state_of_mind->state);
+    SAIL_CHECK_CODEC_PTR(state_of_mind->codec);
+
+    SAIL_TRY(read_seek_next_frame(state_of_mind, image));
+
+    SAIL_TRY_OR_CLEANUP(start_reading_rows(state_of_mind, *image),
                         /* cleanup */ sail_destroy_image(*image));
 
-    for (int pass = 0; pass < interlaced_passes; pass++) {
-        SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->read_seek_next_pass(state_of_mind->state, state_of_mind->io, *image),
-                            /* cleanup */ sail_destroy_image(*image));
+    return SAIL_OK;
+}
 
-        SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->read_frame(state_of_mind->state,
-                                                                    state_of_mind->io,
-                                                                    *image),
-                            /* cleanup */ sail_destroy_image(*image));
-    }
+sail_status_t sail_read_next_rows(void *state, void *rows, unsigned count) {
+
+    SAIL_CHECK_STATE_PTR(state);
+    SAIL_CHECK_BUFFER_PTR(rows);
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_CHECK_IO(state_of_mind->io);
+    SAIL_CHECK_STATE_PTR(state_of_mind->state);
+    SAIL_CHECK_CODEC_PTR(state_of_mind->codec);
+
+    SAIL_TRY(read_rows(state_of_mind, rows, 0 /* region bytes per line */, count));
 
     return SAIL_OK;
 }
@@ -152,8 +262,13 @@ sail_status_t sail_stop_reading(void *state) {
         return SAIL_OK;
     }
 
+    struct sail_arena *thread_arena = sail_set_thread_arena(state_of_mind->arena);
+
     SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->read_finish(&state_of_mind->state, state_of_mind->io),
-                        /* cleanup */ destroy_hidden_state(state_of_mind));
+                        /* cleanup */ sail_set_thread_arena(thread_arena),
+                                      destroy_hidden_state(state_of_mind));
+
+    sail_set_thread_arena(thread_arena);
 
     destroy_hidden_state(state_of_mind);
 
@@ -174,6 +289,14 @@ sail_status_t sail_start_writing_mem(void *buffer, size_t buffer_length, const s
     return SAIL_OK;
 }
 
+sail_status_t sail_start_writing_growing_mem(void **buffer, size_t *buffer_length,
+                                            const struct sail_codec_info *codec_info, void **state) {
+
+    SAIL_TRY(sail_start_writing_growing_mem_with_options(buffer, buffer_length, codec_info, NULL, state));
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_write_next_frame(void *state, const struct sail_image *image) {
 
     SAIL_CHECK_STATE_PTR(state);
@@ -206,16 +329,23 @@ sail_status_t sail_write_next_frame(void *state, const struct sail_image *image)
     unsigned bytes_per_line;
     SAIL_TRY(sail_bytes_per_line(image->width, image->pixel_format, &bytes_per_line));
 
-    SAIL_TRY(state_of_mind->codec->v4->write_seek_next_frame(state_of_mind->state, state_of_mind->io, image));
+    struct sail_arena *thread_arena = sail_set_thread_arena(state_of_mind->arena);
+
+    SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->write_seek_next_frame(state_of_mind->state, state_of_mind->io, image),
+                        /* cleanup */ sail_set_thread_arena(thread_arena));
 
     for (int pass = 0; pass < interlaced_passes; pass++) {
-        SAIL_TRY(state_of_mind->codec->v4->write_seek_next_pass(state_of_mind->state, state_of_mind->io, image));
+        SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->write_seek_next_pass(state_of_mind->state, state_of_mind->io, image),
+                            /* cleanup */ sail_set_thread_arena(thread_arena));
 
-        SAIL_TRY(state_of_mind->codec->v4->write_frame(state_of_mind->state,
-                                                        state_of_mind->io,
-                                                        image));
+        SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->write_frame(state_of_mind->state,
+                                                                    state_of_mind->io,
+                                                                    image),
+                            /* cleanup */ sail_set_thread_arena(thread_arena));
     }
 
+    sail_set_thread_arena(thread_arena);
+
     return SAIL_OK;
 }
 
@@ -38,6 +38,7 @@
 extern "C" {
 #endif
 
+struct sail_mem_segment;
 struct sail_codec_info;
 
 /*
@@ -45,7 +46,12 @@ struct sail_codec_info;
  * MUST be destroyed later with sail_destroy_image(). The assigned codec info MUST NOT be destroyed
  * because it is a pointer to an internal data structure. If you don't need it, just pass NULL.
  *
- * This function is pretty fast because it doesn't decode whole image data for most image formats.
+ * This function is pretty fast because codecs parse only image headers with SAIL_IO_OPTION_PROBE. They don't set up
+ * decoders, allocate canvases, or decode image data. source_image->frames is set to the number of frames
+ * if the image format stores it in headers.
+ *
+ * Non-seekable I/O sources (with SAIL_IO_FEATURE_NON_SEEKABLE) are read through a ring buffer
+ * with a limited rewind window.
  *
  * Typical usage: This is a standalone function that could be called at any time.
  *
@@ -58,7 +64,9 @@ SAIL_EXPORT sail_status_t sail_probe_io(struct sail_io *io, struct sail_image **
  * MUST be destroyed later with sail_destroy_image(). The assigned codec info MUST NOT be destroyed
  * because it is a pointer to an internal data structure. If you don't need it, just pass NULL.
  *
- * This function is pretty fast because it doesn't decode whole image data for most image formats.
+ * This function is pretty fast because codecs parse only image headers with SAIL_IO_OPTION_PROBE. They don't set up
+ * decoders, allocate canvases, or decode image data. source_image->frames is set to the number of frames
+ * if the image format stores it in headers.
  *
  * Typical usage: This is a standalone function that could be called at any time.
  *
@@ -119,15 +127,106 @@ SAIL_EXPORT sail_status_t sail_start_reading_file(const char *path, const struct
 SAIL_EXPORT sail_status_t sail_start_reading_mem(const void *buffer, size_t buffer_length,
                                                 const struct sail_codec_info *codec_info, void **state);
 
+/*
+ * Starts reading the specified list of memory segments as a single image, for example, a chain
+ * of network buffers. Pass codec info if you would like to start reading with a specific codec.
+ * If not, just pass NULL. The image format is detected by its magic number in this case.
+ *
+ * Only the segment descriptors are copied, the segment data is never concatenated. The segment data
+ * MUST stay valid until sail_stop_reading() is called.
+ *
+ * The subsequent calls to sail_read_next_frame() output pixels in the BPP32-RGBA pixel format.
+ *
+ * Typical usage: sail_start_reading_mem_segments() ->
+ *                sail_read_next_frame()            ->
+ *                sail_stop_reading().
+ *
+ * STATE explanation: Passes the address of a local void* pointer. SAIL will store an internal state
+ * in it and destroy it in sail_stop_reading(). States must be used per image. DO NOT use the same state
+ * to start reading multiple images at the same time.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_start_reading_mem_segments(const struct sail_mem_segment *segments, size_t segments_count,
+                                                         const struct sail_codec_info *codec_info, void **state);
+
 /*
  * Continues reading the file started by sail_start_reading_file() and brothers. The assigned image
  * MUST be destroyed later with sail_image_destroy().
  *
+ * When the region of interest is set in the read options, the image contains only the region, and the scan
+ * lines outside of it are skipped by the codecs that support reading by scan lines.
+ *
+ * When a reduction is requested in the read options, the image is reduced natively by the codecs
+ * with SAIL_CODEC_FEATURE_SCALING, and with a box filter while reading scan lines otherwise.
+ *
  * Returns SAIL_OK on success.
  * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
+ * Returns SAIL_ERROR_INCORRECT_IMAGE_DIMENSIONS when the region of interest is outside of the frame.
+ * Returns SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT when the frame pixels cannot be reduced with a box filter.
  */
 SAIL_EXPORT sail_status_t sail_read_next_frame(void *state, struct sail_image **image);
 
+/*
+ * Continues reading the file started by sail_start_reading_file() and brothers. Unlike sail_read_next_frame(),
+ * decodes the frame pixels into the caller-provided buffer instead of allocating them. The buffer must hold
+ * at least bytes_per_line * height bytes. Pass 0 as bytes_per_line to use the minimum number of bytes per line.
+ * Custom bytes per line is useful to decode into padded or aligned rows like GPU textures or framebuffers.
+ *
+ * The frame dimensions are not known in advance. Use sail_probe_file() and brothers to get them
+ * before reading. The buffer is validated against the frame header before decoding any pixels.
+ * If it's too small, the function fails, and the next call to sail_read_next_frame_to_buffer()
+ * retries the same frame, so the caller could allocate a bigger buffer and try again. Reading
+ * the next frame with other functions skips the frame.
+ *
+ * The output image doesn't own the buffer, and its pixels are set to NULL. Its bytes per line
+ * is set to the stride used to decode the frame. The output image MUST be destroyed later with sail_destroy_image().
+ *
+ * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
+ * Returns SAIL_ERROR_INVALID_ARGUMENT when the buffer is too small to hold the frame.
+ * Returns SAIL_ERROR_INCORRECT_BYTES_PER_LINE when the bytes per line is too small to hold a scan line.
+ */
+SAIL_EXPORT sail_status_t sail_read_next_frame_to_buffer(void *state, void *buffer, size_t buffer_size, unsigned bytes_per_line,
+                                                        struct sail_image **image);
+
+/*
+ * Continues reading the file started by sail_start_reading_file() and brothers. Unlike sail_read_next_frame(),
+ * doesn't decode the frame pixels. Use sail_read_next_rows() to decode them by bands of scan lines afterwards.
+ * The assigned image has no pixels and MUST be destroyed later with sail_destroy_image().
+ *
+ * When a reduction or the region of interest is set in the read options, the image dimensions are
+ * reduced and cropped accordingly.
+ *
+ * Reading the next frame before all the scan lines of the previous frame are read skips the rest
+ * of the previous frame. Codecs without SAIL_CODEC_FEATURE_SCAN_LINES decode it in full to skip it.
+ *
+ * Typical usage: sail_start_reading_file()     ->
+ *                sail_read_next_frame_header() ->
+ *                sail_read_next_rows()         ->
+ *                sail_read_next_rows()         ->
+ *                ...                           ->
+ *                sail_stop_reading().
+ *
+ * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
+ */
+SAIL_EXPORT sail_status_t sail_read_next_frame_header(void *state, struct sail_image **image);
+
+/*
+ * Decodes the next count scan lines of the frame started by sail_read_next_frame_header() into the
+ * caller-provided buffer. The buffer must hold at least bytes_per_line * count bytes where bytes_per_line
+ * is taken from the image returned by sail_read_next_frame_header().
+ *
+ * Codecs with SAIL_CODEC_FEATURE_SCAN_LINES in their read features decode only the requested scan lines,
+ * so reading huge images takes the memory of a few scan lines. Other codecs and interlaced frames
+ * are decoded in full into an internal buffer on the first call, and the scan lines are copied from it.
+ *
+ * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_INVALID_ARGUMENT when no frame is being read or the frame has less than count scan lines left.
+ */
+SAIL_EXPORT sail_status_t sail_read_next_rows(void *state, void *rows, unsigned count);
+
 /*
  * Stops reading the file started by sail_start_reading_file() and brothers. Does nothing if the state is NULL.
  *
@@ -191,6 +290,31 @@ SAIL_EXPORT sail_status_t sail_start_writing_file(const char *path, const struct
 SAIL_EXPORT sail_status_t sail_start_writing_mem(void *buffer, size_t buffer_length,
                                                 const struct sail_codec_info *codec_info, void **state);
 
+/*
+ * Starts writing into a memory buffer allocated by SAIL and growing on demand.
+ *
+ * The buffer and its length are assigned in sail_stop_writing(). The buffer and length pointers
+ * must stay valid until then. The caller takes the ownership of the buffer and MUST free it
+ * later with sail_free(). The buffer is NULL if nothing was written.
+ *
+ * The subsequent calls to sail_write_next_frame() output pixels in pixel format
+ * as specified in sail_write_features.default_output_pixel_format.
+ *
+ * Typical usage: sail_codec_info_from_extension() ->
+ *                sail_start_writing_growing_mem() ->
+ *                sail_write_next_frame()          ->
+ *                sail_stop_writing()              ->
+ *                sail_free(buffer).
+ *
+ * STATE explanation: Passes the address of a local void* pointer. SAIL will store an internal state
+ * in it and destroy it in sail_stop_writing. States must be used per image. DO NOT use the same state
+ * to start writing multiple images at the same time.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_start_writing_growing_mem(void **buffer, size_t *buffer_length,
+                                                        const struct sail_codec_info *codec_info, void **state);
+
 /*
  * Continues writing the file started by sail_start_writing_file() and brothers.
  *
@@ -25,11 +25,111 @@
 
 #include "config.h"
 
+#include <stdint.h>
 #include <stdlib.h>
 
 #include "sail-common.h"
 #include "sail.h"
 
+struct read_files_state {
+    const char * const *paths;
+    const struct sail_read_options *read_options;
+
+    sail_read_files_callback_t callback;
+    void *user_data;
+
+    /* Serializes calls to the callback. */
+    sail_mutex_t callback_mutex;
+
+    /* Guards the bytes in flight. Signaled when frames are delivered. */
+    sail_mutex_t budget_mutex;
+    sail_cond_t budget_cond;
+    uint64_t max_bytes_in_flight;
+    uint64_t bytes_in_flight;
+};
+
+/*
+ * Private functions.
+ */
+
+/* Waits until the specified number of bytes fits into the limit and reserves them. */
+static void reserve_bytes_in_flight(struct read_files_state *state, uint64_t bytes) {
+
+    lock_mutex(&state->budget_mutex);
+
+    /* Always let a single frame through, even if it's bigger than the limit. */
+    while (state->max_bytes_in_flight > 0 && state->bytes_in_flight > 0
+            && state->bytes_in_flight + bytes > state->max_bytes_in_flight) {
+        wait_cond(&state->budget_cond, &state->budget_mutex);
+    }
+
+    state->bytes_in_flight += bytes;
+
+    unlock_mutex(&state->budget_mutex);
+}
+
+static void release_bytes_in_flight(struct read_files_state *state, uint64_t bytes) {
+
+    if (bytes == 0) {
+        return;
+    }
+
+    lock_mutex(&state->budget_mutex);
+    state->bytes_in_flight -= bytes;
+    broadcast_cond(&state->budget_cond);
+    unlock_mutex(&state->budget_mutex);
+}
+
+/* Reads the first frame of the file. Reserves its pixels size before allocating them. */
+static sail_status_t read_file_in_budget(struct read_files_state *state, const char *path,
+                                        struct sail_image **image, uint64_t *reserved) {
+
+    void *reading_state = NULL;
+
+    SAIL_TRY_OR_CLEANUP(sail_start_reading_file_with_options(path, NULL /* codec info */, state->read_options, &reading_state),
+                        /* cleanup */ sail_stop_reading(reading_state));
+
+    struct hidden_state *state_of_mind = reading_state;
+
+    SAIL_TRY_OR_CLEANUP(seek_next_frame_to_read(state_of_mind, image),
+                        /* cleanup */ sail_stop_reading(reading_state));
+
+    SAIL_TRY_OR_CLEANUP(sail_bytes_per_image64(*image, reserved),
+                        /* cleanup */ sail_destroy_image(*image),
+                                      sail_stop_reading(reading_state));
+
+    reserve_bytes_in_flight(state, *reserved);
+
+    SAIL_TRY_OR_CLEANUP(read_frame_pixels(state_of_mind, *image),
+                        /* cleanup */ sail_destroy_image(*image),
+                                      sail_stop_reading(reading_state));
+
+    SAIL_TRY_OR_CLEANUP(sail_stop_reading(reading_state),
+                        /* cleanup */ sail_destroy_image(*image));
+
+    return SAIL_OK;
+}
+
+static void read_file_item(void *arg, size_t index) {
+
+    struct read_files_state *state = arg;
+
+    struct sail_image *image = NULL;
+    uint64_t reserved = 0;
+
+    const sail_status_t status = read_file_in_budget(state, state->paths[index], &image, &reserved);
+
+    lock_mutex(&state->callback_mutex);
+    state->callback(index, status, status == SAIL_OK ? image : NULL, state->user_data);
+    unlock_mutex(&state->callback_mutex);
+
+    release_bytes_in_flight(state, reserved);
+}
+
+/*
+ * Public functions.
+ */
+
 sail_status_t sail_start_reading_file_with_options(const char *path, const struct sail_codec_info *codec_info,
                                                   const struct sail_read_options *read_options, void **state) {
 
@@ -44,7 +144,12 @@ sail_status_t sail_start_reading_file_with_options(const char *path, const struc
     }
 
     struct sail_io *io;
-    SAIL_TRY(alloc_io_read_file(path, &io));
+
+    if (read_options == NULL) {
+        SAIL_TRY(alloc_io_read_file(path, &io));
+    } else {
+        SAIL_TRY(alloc_io_read_file_with_options(path, read_options->io_options, &io));
+    }
 
     SAIL_TRY(start_reading_io_with_options(io, true, codec_info_local, read_options, state));
 
@@ -73,6 +178,65 @@ sail_status_t sail_start_reading_mem_with_options(const void *buffer, size_t buf
     return SAIL_OK;
 }
 
+sail_status_t sail_start_reading_mem_segments_with_options(const struct sail_mem_segment *segments, size_t segments_count,
+                                                          const struct sail_codec_info *codec_info,
+                                                          const struct sail_read_options *read_options, void **state) {
+
+    SAIL_CHECK_PTR(segments);
+
+    struct sail_io *io;
+    SAIL_TRY(alloc_io_read_mem_segments(segments, segments_count, &io));
+
+    const struct sail_codec_info *codec_info_local;
+
+    if (codec_info == NULL) {
+        SAIL_TRY_OR_CLEANUP(sail_codec_info_by_magic_number_from_io(io, &codec_info_local),
+                            /* cleanup */ sail_destroy_io(io));
+    } else {
+        codec_info_local = codec_info;
+    }
+
+    /* The I/O object will be destroyed in this function. */
+    SAIL_TRY(start_reading_io_with_options(io, true, codec_info_local, read_options, state));
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_read_files_with_options(const char * const *paths, size_t count,
+                                            const struct sail_read_options *read_options,
+                                            size_t max_bytes_in_flight, unsigned threads,
+                                            sail_read_files_callback_t callback, void *user_data) {
+
+    SAIL_CHECK_PTR(paths);
+    SAIL_CHECK_PTR(callback);
+
+    struct read_files_state state;
+
+    state.paths               = paths;
+    state.read_options        = read_options;
+    state.callback            = callback;
+    state.user_data           = user_data;
+    state.max_bytes_in_flight = max_bytes_in_flight;
+    state.bytes_in_flight     = 0;
+
+    SAIL_TRY(init_mutex(&state.callback_mutex));
+    SAIL_TRY_OR_CLEANUP(init_mutex(&state.budget_mutex),
+                        /* cleanup */ destroy_mutex(&state.callback_mutex));
+    SAIL_TRY_OR_CLEANUP(init_cond(&state.budget_cond),
+                        /* cleanup */ destroy_mutex(&state.budget_mutex),
+                                      destroy_mutex(&state.callback_mutex));
+
+    const sail_status_t status = parallel_for(count, threads, read_file_item, &state);
+
+    destroy_cond(&state.budget_cond);
+    destroy_mutex(&state.budget_mutex);
+    destroy_mutex(&state.callback_mutex);
+
+    SAIL_TRY(status);
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_start_writing_file_with_options(const char *path, const struct sail_codec_info *codec_info,
                                                   const struct sail_write_options *write_options, void **state) {
 
@@ -110,6 +274,22 @@ sail_status_t sail_start_writing_mem_with_options(void *buffer, size_t buffer_le
     return SAIL_OK;
 }
 
+sail_status_t sail_start_writing_growing_mem_with_options(void **buffer, size_t *buffer_length,
+                                                         const struct sail_codec_info *codec_info,
+                                                         const struct sail_write_options *write_options, void **state) {
+    SAIL_CHECK_BUFFER_PTR(buffer);
+    SAIL_CHECK_PTR(buffer_length);
+    SAIL_CHECK_CODEC_INFO_PTR(codec_info);
+
+    struct sail_io *io;
+    SAIL_TRY(alloc_io_write_growing_mem(buffer, buffer_length, &io));
+
+    /* The I/O object will be destroyed in this function. */
+    SAIL_TRY(start_writing_io_with_options(io, true, codec_info, write_options, state));
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_stop_writing_with_written(void *state, size_t *written) {
 
     SAIL_TRY(stop_writing(state, written));
@@ -40,11 +40,20 @@
 extern "C" {
 #endif
 
+struct sail_image;
 struct sail_io;
+struct sail_mem_segment;
 struct sail_codec_info;
 struct sail_read_options;
 struct sail_write_options;
 
+/*
+ * Receives the result of reading paths[index] with sail_read_files_with_options(). The image is NULL
+ * if the status is not SAIL_OK. Otherwise, the callback takes ownership of the image and MUST destroy it
+ * later with sail_destroy_image().
+ */
+typedef void (*sail_read_files_callback_t)(size_t index, sail_status_t status, struct sail_image *image, void *user_data);
+
 /*
  * Starts reading the specified image file with the specified read options. Pass codec info if you would like
  * to start reading with a specific codec. If not, just pass NULL. If you do not need specific read options,
@@ -95,6 +104,60 @@ SAIL_EXPORT sail_status_t sail_start_reading_mem_with_options(const void *buffer
                                                              const struct sail_codec_info *codec_info,
                                                              const struct sail_read_options *read_options, void **state);
 
+/*
+ * Starts reading the specified list of memory segments as a single image with the specified read options.
+ * Pass codec info if you would like to start reading with a specific codec. If not, just pass NULL.
+ * The image format is detected by its magic number in this case. If you do not need specific read options,
+ * just pass NULL. Codec-specific defaults will be used in this case.
+ *
+ * Only the segment descriptors are copied, the segment data is never concatenated. The segment data
+ * MUST stay valid until sail_stop_reading() is called.
+ *
+ * The read options are deep copied.
+ *
+ * If read options is NULL, the subsequent calls to sail_read_next_frame() output pixels in the BPP32-RGBA pixel format.
+ *
+ * Typical usage: sail_start_reading_mem_segments_with_options() ->
+ *                sail_read_next_frame()                         ->
+ *                sail_stop_reading().
+ *
+ * STATE explanation: Passes the address of a local void* pointer. SAIL will store an internal state
+ * in it and destroy it in sail_stop_reading(). States must be used per image. DO NOT use the same state
+ * to start reading multiple images at the same time.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_start_reading_mem_segments_with_options(const struct sail_mem_segment *segments, size_t segments_count,
+                                                                      const struct sail_codec_info *codec_info,
+                                                                      const struct sail_read_options *read_options, void **state);
+
+/*
+ * Reads the first frames of the specified image files with the specified read options in up to
+ * the specified number of threads including the calling one. Pass 0 to use as many threads as CPU cores.
+ * If you do not need specific read options, just pass NULL. The frames are output in the BPP32-RGBA
+ * pixel format in this case.
+ *
+ * Every file is read with the sail_start_reading_file_with_options() -> sail_read_next_frame() ->
+ * sail_stop_reading() sequence. Every read frame or error is delivered to the callback as soon as
+ * it's ready, so the order is not preserved. Calls to the callback are serialized, but they are made
+ * from different threads. A failure to read a file doesn't stop reading the rest of them.
+ *
+ * max_bytes_in_flight limits the total size of the pixels being read or delivered to the callback.
+ * The pixels count as in flight until the callback returns. A thread that would exceed the limit waits
+ * for other frames to be delivered before it allocates pixels. A frame bigger than the limit is read
+ * alone. Pass 0 for no limit.
+ *
+ * Worker threads share the context of the calling thread, so they don't enumerate codecs again.
+ *
+ * Typical usage: This is a standalone function that could be called at any time.
+ *
+ * Returns SAIL_OK if all the files were read, successfully or not.
+ */
+SAIL_EXPORT sail_status_t sail_read_files_with_options(const char * const *paths, size_t count,
+                                                      const struct sail_read_options *read_options,
+                                                      size_t max_bytes_in_flight, unsigned threads,
+                                                      sail_read_files_callback_t callback, void *user_data);
+
 /*
  * Starts writing the specified image file with the specified write options. Pass codec info if you would like
  * to start writing with a specific codec. If not, just pass NULL. If you do not need specific write options,
@@ -124,6 +187,32 @@ SAIL_EXPORT sail_status_t sail_start_writing_file_with_options(const char *path,
                                                               const struct sail_codec_info *codec_info,
                                                               const struct sail_write_options *write_options, void **state);
 
+/*
+ * Starts writing into a memory buffer allocated by SAIL and growing on demand with the specified write options.
+ * If you do not need specific write options, just pass NULL. Codec-specific defaults will be used in this case.
+ *
+ * The write options are deep copied.
+ *
+ * The buffer and its length are assigned in sail_stop_writing(). The buffer and length pointers
+ * must stay valid until then. The caller takes the ownership of the buffer and MUST free it
+ * later with sail_free(). The buffer is NULL if nothing was written.
+ *
+ * Typical usage: sail_codec_info_from_extension()              ->
+ *                sail_start_writing_growing_mem_with_options() ->
+ *                sail_write_next_frame()                       ->
+ *                sail_stop_writing()                           ->
+ *                sail_free(buffer).
+ *
+ * STATE explanation: Passes the address of a local void* pointer. SAIL will store an internal state
+ * in it and destroy it in sail_stop_writing. States must be used per image. DO NOT use the same state
+ * to start writing multiple images at the same time.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_start_writing_growing_mem_with_options(void **buffer, size_t *buffer_length,
+                                                                     const struct sail_codec_info *codec_info,
+                                                                     const struct sail_write_options *write_options, void **state);
+
 /*
  * Starts writing the specified memory buffer with the specified write options. If you do not need specific
  * write options, just pass NULL. Codec-specific defaults will be used in this case.
@@ -30,6 +30,45 @@
 #include "sail-common.h"
 #include "sail.h"
 
+/* The number of bytes to read ahead from every file to be probed. Enough for typical headers. */
+static const size_t PROBE_READAHEAD_SIZE = 64 * 1024;
+
+struct probe_files_state {
+    const char * const *paths;
+    size_t count;
+    struct sail_probe_result *results;
+
+    /* How many files ahead to read in background. The first files are probed right away. */
+    size_t readahead_distance;
+};
+
+/*
+ * Private functions.
+ */
+
+static void probe_file_item(void *arg, size_t index) {
+
+    struct probe_files_state *state = arg;
+
+    /* Items are handed out in order, so this file is likely to be probed next by some thread. */
+    if (index + state->readahead_distance < state->count) {
+        readahead_file(state->paths[index + state->readahead_distance], PROBE_READAHEAD_SIZE);
+    }
+
+    struct sail_probe_result *result = &state->results[index];
+
+    result->status = sail_probe_file(state->paths[index], &result->image, &result->codec_info);
+
+    if (result->status != SAIL_OK) {
+        result->image      = NULL;
+        result->codec_info = NULL;
+    }
+}
+
+/*
+ * Public functions.
+ */
+
 sail_status_t sail_probe_file(const char *path, struct sail_image **image, const struct sail_codec_info **codec_info) {
 
     SAIL_CHECK_PATH_PTR(path);
@@ -45,6 +84,27 @@ sail_status_t sail_probe_file(const char *path, struct sail_image **image, const
     return SAIL_OK;
 }
 
+sail_status_t sail_probe_files(const char * const *paths, size_t count, struct sail_probe_result *results, unsigned threads) {
+
+    SAIL_CHECK_PTR(paths);
+    SAIL_CHECK_PTR(results);
+
+    if (threads == 0) {
+        threads = cpu_count();
+    }
+
+    struct probe_files_state state;
+
+    state.paths              = paths;
+    state.count              = count;
+    state.results            = results;
+    state.readahead_distance = threads;
+
+    SAIL_TRY(parallel_for(count, threads, probe_file_item, &state));
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_read_file(const char *path, struct sail_image **image) {
 
     SAIL_CHECK_PATH_PTR(path);
@@ -26,6 +26,8 @@
 #ifndef SAIL_SAIL_JUNIOR_H
 #define SAIL_SAIL_JUNIOR_H
 
+#include <stddef.h> /* size_t */
+
 #ifdef SAIL_BUILD
     #include "error.h"
     #include "export.h"
@@ -47,7 +49,9 @@ struct sail_codec_info;
  * MUST be destroyed later with sail_destroy_image(). The assigned codec info MUST NOT be destroyed
  * because it is a pointer to an internal data structure. If you don't need it, just pass NULL.
  *
- * This function is pretty fast because it doesn't decode whole image data for most image formats.
+ * This function is pretty fast because codecs parse only image headers with SAIL_IO_OPTION_PROBE. They don't set up
+ * decoders, allocate canvases, or decode image data. source_image->frames is set to the number of frames
+ * if the image format stores it in headers.
  *
  * Typical usage: This is a standalone function that could be called at any time.
  *
@@ -55,6 +59,45 @@ struct sail_codec_info;
  */
 SAIL_EXPORT sail_status_t sail_probe_file(const char *path, struct sail_image **image, const struct sail_codec_info **codec_info);
 
+/*
+ * Result of probing a single file with sail_probe_files().
+ */
+struct sail_probe_result {
+
+    /* Status of probing the file. */
+    sail_status_t status;
+
+    /*
+     * Image properties without pixels or NULL on error. MUST be destroyed later
+     * with sail_destroy_image().
+     */
+    struct sail_image *image;
+
+    /*
+     * Codec info of the file or NULL on error. MUST NOT be destroyed because it is a pointer
+     * to an internal data structure.
+     */
+    const struct sail_codec_info *codec_info;
+};
+
+/*
+ * Probes the specified image files like sail_probe_file() in up to the specified number of threads
+ * including the calling one. Pass 0 to use as many threads as CPU cores. The results array MUST have
+ * at least count elements. results[i] is filled with the status, properties, and codec info of paths[i].
+ *
+ * Worker threads share the context of the calling thread, so they don't enumerate codecs again.
+ * Headers of the files to be probed next are read ahead in background. Use this function to crawl
+ * large image collections.
+ *
+ * A failure to probe a file doesn't stop probing the rest of them. Check the status of every result.
+ *
+ * Typical usage: This is a standalone function that could be called at any time.
+ *
+ * Returns SAIL_OK if all the files were probed, successfully or not.
+ */
+SAIL_EXPORT sail_status_t sail_probe_files(const char * const *paths, size_t count,
+                                            struct sail_probe_result *results, unsigned threads);
+
 /*
  * Loads the specified image file and returns its properties and pixels. The assigned image
  * MUST be destroyed later with sail_destroy_image().
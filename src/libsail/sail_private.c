@@ -25,6 +25,7 @@
 
 #include "config.h"
 
+#include <stdint.h>
 #include <string.h>
 
 #include "sail-common.h"
@@ -34,21 +35,6 @@
  * Private functions.
  */
 
-static sail_status_t load_codec(struct sail_codec_info_node *node) {
-
-    SAIL_CHECK_PTR(node);
-
-    /* Already loaded. */
-    if (node->codec != NULL) {
-        return SAIL_OK;
-    }
-
-    /* Codec is not loaded. Let's load it. */
-    SAIL_TRY(alloc_and_load_codec(node->codec_info, &node->codec));
-
-    return SAIL_OK;
-}
-
 static void print_unsupported_write_output_pixel_format(enum SailPixelFormat input_pixel_format, enum SailPixelFormat output_pixel_format) {
 
     const char *input_pixel_format_str = NULL;
@@ -70,44 +56,370 @@ static void print_unsupported_write_input_pixel_format(enum SailPixelFormat inpu
                     input_pixel_format_str);
 }
 
+static void destroy_rows(struct hidden_state *state_of_mind) {
+
+    sail_destroy_image(state_of_mind->rows_image);
+    sail_free(state_of_mind->scan_line);
+    sail_free(state_of_mind->box_sums);
+
+    state_of_mind->rows_image      = NULL;
+    state_of_mind->rows_read       = 0;
+    state_of_mind->scan_lines_read = 0;
+    state_of_mind->scale           = 1;
+    state_of_mind->scan_line       = NULL;
+    state_of_mind->box_sums        = NULL;
+}
+
+/* Reads or skips (when scan_lines is NULL) the next scan lines of the frame being read by scan lines. */
+static sail_status_t read_scan_lines(struct hidden_state *state_of_mind, void *scan_lines, unsigned count) {
+
+    struct sail_arena *thread_arena = sail_set_thread_arena(state_of_mind->arena);
+
+    SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->read_scan_lines(state_of_mind->state, state_of_mind->io,
+                                                                    state_of_mind->rows_image, scan_lines, count),
+                        /* cleanup */ sail_set_thread_arena(thread_arena));
+
+    sail_set_thread_arena(thread_arena);
+
+    state_of_mind->scan_lines_read += count;
+
+    return SAIL_OK;
+}
+
+/* Decodes the frame being read by scan lines in full when the codec cannot read it by scan lines. */
+static sail_status_t decode_rows_frame(struct hidden_state *state_of_mind) {
+
+    struct sail_image *rows_image = state_of_mind->rows_image;
+
+    uint64_t pixels_size;
+    SAIL_TRY(sail_bytes_per_image64(rows_image, &pixels_size));
+
+    if (pixels_size > SIZE_MAX) {
+        SAIL_LOG_ERROR("The image of %llu bytes doesn't fit into the address space", (unsigned long long)pixels_size);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
+    }
+
+    SAIL_TRY(sail_malloc((size_t)pixels_size, &rows_image->pixels));
+
+    SAIL_TRY_OR_CLEANUP(read_frame_passes(state_of_mind, rows_image),
+                        /* cleanup */ sail_free(rows_image->pixels),
+                                      rows_image->pixels = NULL);
+
+    return SAIL_OK;
+}
+
 /*
- * Public functions.
+ * Returns the specified scan line of rows_image. When reading by scan lines, scan lines must be requested
+ * in ascending order. Scan lines between them are skipped.
  */
+static sail_status_t source_scan_line(struct hidden_state *state_of_mind, unsigned line, const unsigned char **scan_line) {
 
-sail_status_t load_codec_by_codec_info(const struct sail_codec_info *codec_info, const struct sail_codec **codec) {
+    const struct sail_image *rows_image = state_of_mind->rows_image;
 
-    SAIL_CHECK_CODEC_INFO_PTR(codec_info);
-    SAIL_CHECK_CODEC_PTR(codec);
+    /* The frame is decoded in full. */
+    if (rows_image->pixels != NULL) {
+        *scan_line = (const unsigned char *)rows_image->pixels + (size_t)line * rows_image->bytes_per_line;
+        return SAIL_OK;
+    }
 
-    struct sail_context *context;
-    SAIL_TRY(current_tls_context(&context));
+    if (state_of_mind->scan_lines_read < line) {
+        SAIL_TRY(read_scan_lines(state_of_mind, NULL, line - state_of_mind->scan_lines_read));
+    }
 
-    /* Find the codec in the cache. */
-    struct sail_codec_info_node *node = context->codec_info_node;
-    struct sail_codec_info_node *found_node = NULL;
+    SAIL_TRY(read_scan_lines(state_of_mind, state_of_mind->scan_line, 1));
 
-    while (node != NULL) {
-        if (node->codec_info == codec_info) {
-            if (node->codec != NULL) {
-                *codec = node->codec;
-                return SAIL_OK;
+    *scan_line = state_of_mind->scan_line;
+
+    return SAIL_OK;
+}
+
+/* Returns the number of bytes per channel of the pixel formats that could be reduced with a box filter. */
+static sail_status_t box_depth(enum SailPixelFormat pixel_format, unsigned *depth) {
+
+    switch (pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE:
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA:
+        case SAIL_PIXEL_FORMAT_BPP24_RGB:
+        case SAIL_PIXEL_FORMAT_BPP24_BGR:
+        case SAIL_PIXEL_FORMAT_BPP32_RGBX:
+        case SAIL_PIXEL_FORMAT_BPP32_BGRX:
+        case SAIL_PIXEL_FORMAT_BPP32_XRGB:
+        case SAIL_PIXEL_FORMAT_BPP32_XBGR:
+        case SAIL_PIXEL_FORMAT_BPP32_RGBA:
+        case SAIL_PIXEL_FORMAT_BPP32_BGRA:
+        case SAIL_PIXEL_FORMAT_BPP32_ARGB:
+        case SAIL_PIXEL_FORMAT_BPP32_ABGR:
+        case SAIL_PIXEL_FORMAT_BPP32_CMYK:
+        case SAIL_PIXEL_FORMAT_BPP24_YCBCR:
+        case SAIL_PIXEL_FORMAT_BPP32_YCCK:
+        case SAIL_PIXEL_FORMAT_BPP24_CIE_LAB: {
+            *depth = 1;
+            return SAIL_OK;
+        }
+
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE:
+        case SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA:
+        case SAIL_PIXEL_FORMAT_BPP48_RGB:
+        case SAIL_PIXEL_FORMAT_BPP48_BGR:
+        case SAIL_PIXEL_FORMAT_BPP64_RGBX:
+        case SAIL_PIXEL_FORMAT_BPP64_BGRX:
+        case SAIL_PIXEL_FORMAT_BPP64_XRGB:
+        case SAIL_PIXEL_FORMAT_BPP64_XBGR:
+        case SAIL_PIXEL_FORMAT_BPP64_RGBA:
+        case SAIL_PIXEL_FORMAT_BPP64_BGRA:
+        case SAIL_PIXEL_FORMAT_BPP64_ARGB:
+        case SAIL_PIXEL_FORMAT_BPP64_ABGR:
+        case SAIL_PIXEL_FORMAT_BPP64_CMYK:
+        case SAIL_PIXEL_FORMAT_BPP48_CIE_LAB: {
+            *depth = 2;
+            return SAIL_OK;
+        }
+
+        default: {
+            const char *pixel_format_str = NULL;
+            SAIL_TRY_OR_SUPPRESS(sail_pixel_format_to_string(pixel_format, &pixel_format_str));
+            SAIL_LOG_ERROR("%s pixels cannot be reduced. Use a direct color pixel format with 8 or 16 bits per channel", pixel_format_str);
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+        }
+    }
+}
+
+/* Returns the index of the alpha channel of the pixel formats that could be reduced, or the number of channels without alpha. */
+static unsigned box_alpha(enum SailPixelFormat pixel_format, unsigned channels) {
+
+    switch (pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA:
+        case SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA: {
+            return 1;
+        }
+
+        case SAIL_PIXEL_FORMAT_BPP32_RGBA:
+        case SAIL_PIXEL_FORMAT_BPP32_BGRA:
+        case SAIL_PIXEL_FORMAT_BPP64_RGBA:
+        case SAIL_PIXEL_FORMAT_BPP64_BGRA: {
+            return 3;
+        }
+
+        case SAIL_PIXEL_FORMAT_BPP32_ARGB:
+        case SAIL_PIXEL_FORMAT_BPP32_ABGR:
+        case SAIL_PIXEL_FORMAT_BPP64_ARGB:
+        case SAIL_PIXEL_FORMAT_BPP64_ABGR: {
+            return 0;
+        }
+
+        default: {
+            return channels;
+        }
+    }
+}
+
+/*
+ * Reduces the scan lines of rows_image covered by the specified scan line of the reduced region into target.
+ * Color channels are weighted by alpha, so transparent pixels don't bleed their color into the box.
+ * Fully transparent boxes are transparent black.
+ */
+static sail_status_t reduce_scan_line(struct hidden_state *state_of_mind, unsigned line, unsigned char *target) {
+
+    const struct sail_image *rows_image = state_of_mind->rows_image;
+
+    const unsigned scale           = state_of_mind->scale;
+    const unsigned channels        = state_of_mind->box_channels;
+    const unsigned depth           = state_of_mind->box_depth;
+    const unsigned alpha           = state_of_mind->box_alpha;
+    const unsigned bytes_per_pixel = channels * depth;
+    uint64_t *sums                 = state_of_mind->box_sums;
+
+    const unsigned first_line = line * scale;
+    const unsigned lines      = (scale < rows_image->height - first_line) ? scale : rows_image->height - first_line;
+
+    memset(sums, 0, (size_t)state_of_mind->region_width * channels * sizeof(uint64_t));
+
+    for (unsigned i = 0; i < lines; i++) {
+        const unsigned char *scan_line;
+        SAIL_TRY(source_scan_line(state_of_mind, first_line + i, &scan_line));
+
+        for (unsigned x = 0; x < state_of_mind->region_width; x++) {
+            const unsigned first_column = (state_of_mind->region_x + x) * scale;
+            const unsigned values       = ((scale < rows_image->width - first_column) ? scale : rows_image->width - first_column) * channels;
+
+            const unsigned char *pixel = scan_line + (size_t)first_column * bytes_per_pixel;
+            uint64_t *sum = sums + (size_t)x * channels;
+
+            for (unsigned value = 0; value < values; value += channels) {
+                unsigned channel_values[4];
+
+                for (unsigned channel = 0; channel < channels; channel++) {
+                    if (depth == 1) {
+                        channel_values[channel] = pixel[value + channel];
+                    } else {
+                        uint16_t channel_value;
+                        memcpy(&channel_value, pixel + (size_t)(value + channel) * 2, sizeof(channel_value));
+                        channel_values[channel] = channel_value;
+                    }
+                }
+
+                const unsigned weight = (alpha < channels) ? channel_values[alpha] : 1;
+
+                for (unsigned channel = 0; channel < channels; channel++) {
+                    sum[channel] += (channel == alpha) ? channel_values[channel] : (uint64_t)channel_values[channel] * weight;
+                }
             }
+        }
+    }
+
+    /* Average the boxes. Boxes at the right and bottom edges of the frame could be smaller. */
+    for (unsigned x = 0; x < state_of_mind->region_width; x++) {
+        const unsigned first_column = (state_of_mind->region_x + x) * scale;
+        const unsigned columns      = (scale < rows_image->width - first_column) ? scale : rows_image->width - first_column;
+        const uint64_t samples      = (uint64_t)columns * lines;
+
+        const uint64_t *sum  = sums + (size_t)x * channels;
+        unsigned char *pixel = target + (size_t)x * bytes_per_pixel;
+
+        /* Color channels are divided by the total weight. */
+        const uint64_t weights = (alpha < channels) ? sum[alpha] : samples;
+
+        for (unsigned channel = 0; channel < channels; channel++) {
+            const uint64_t divisor = (channel == alpha) ? samples : weights;
+            const uint64_t average = (divisor == 0) ? 0 : (sum[channel] + divisor / 2) / divisor;
+
+            if (depth == 1) {
+                pixel[channel] = (unsigned char)average;
+            } else {
+                const uint16_t value = (uint16_t)average;
+                memcpy(pixel + (size_t)channel * 2, &value, sizeof(value));
+            }
+        }
+    }
+
+    return SAIL_OK;
+}
+
+struct parallel_for_state {
+    parallel_func_t func;
+    void *arg;
+    size_t count;
 
-            found_node = node;
+    /* The context of the thread that called parallel_for(). */
+    struct sail_context *context;
+
+    /* Guards the next index. */
+    sail_mutex_t mutex;
+    size_t next_index;
+};
+
+/* Processes the items of parallel_for() one by one until no items left. */
+static void process_parallel_items(struct parallel_for_state *state) {
+
+    while (true) {
+        lock_mutex(&state->mutex);
+        const size_t index = state->next_index;
+
+        if (index < state->count) {
+            state->next_index++;
+        }
+
+        unlock_mutex(&state->mutex);
+
+        if (index >= state->count) {
             break;
         }
 
-        node = node->next;
+        state->func(state->arg, index);
+    }
+}
+
+static void parallel_for_thread(void *arg) {
+
+    struct parallel_for_state *state = arg;
+
+    borrow_tls_context(state->context);
+    process_parallel_items(state);
+    borrow_tls_context(NULL);
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t parallel_for(size_t count, unsigned threads, parallel_func_t func, void *arg) {
+
+    SAIL_CHECK_PTR(func);
+
+    if (threads == 0) {
+        threads = cpu_count();
+    }
+    /* Compare before narrowing, so huge counts never wrap around. */
+    if ((size_t)threads > count) {
+        threads = (unsigned)count;
     }
 
-    /* Something weird. The pointer to the codec info is not found the cache. */
-    if (found_node == NULL) {
-        SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            func(arg, i);
+        }
+
+        return SAIL_OK;
     }
 
-    SAIL_TRY(load_codec(found_node));
+    struct parallel_for_state state;
 
-    *codec = found_node->codec;
+    state.func       = func;
+    state.arg        = arg;
+    state.count      = count;
+    state.next_index = 0;
+
+    /*
+     * Initialize the context once for all the workers. The reference keeps it alive and its codecs
+     * loaded even if sail_finish() or sail_unload_codecs() is called while the workers run.
+     */
+    SAIL_TRY(acquire_tls_context(&state.context));
+    SAIL_TRY_OR_CLEANUP(init_mutex(&state.mutex),
+                        /* cleanup */ release_context(state.context));
+
+    /* The calling thread processes items as well. */
+    const unsigned workers = threads - 1;
+
+    void *ptr;
+    SAIL_TRY_OR_CLEANUP(sail_malloc(workers * sizeof(sail_thread_t), &ptr),
+                        /* cleanup */ destroy_mutex(&state.mutex),
+                                      release_context(state.context));
+    sail_thread_t *worker_threads = ptr;
+
+    unsigned started = 0;
+
+    for (; started < workers; started++) {
+        if (create_thread(&worker_threads[started], parallel_for_thread, &state) != SAIL_OK) {
+            /* The started threads and the calling thread process all the items anyway. */
+            break;
+        }
+    }
+
+    SAIL_LOG_DEBUG("Processing %lu items in %u threads", (unsigned long)count, started + 1);
+
+    process_parallel_items(&state);
+
+    for (unsigned i = 0; i < started; i++) {
+        join_thread(worker_threads[i]);
+    }
+
+    sail_free(worker_threads);
+    destroy_mutex(&state.mutex);
+    release_context(state.context);
+
+    return SAIL_OK;
+}
+
+sail_status_t load_codec_by_codec_info(const struct sail_codec_info *codec_info, const struct sail_codec **codec) {
+
+    SAIL_CHECK_CODEC_INFO_PTR(codec_info);
+    SAIL_CHECK_CODEC_PTR(codec);
+
+    struct sail_context *context;
+    SAIL_TRY(current_tls_context(&context));
+
+    /* The context could be shared between threads or preload codecs in background. */
+    SAIL_TRY(load_context_codec(context, codec_info, codec));
 
     return SAIL_OK;
 }
@@ -122,11 +434,21 @@ void destroy_hidden_state(struct hidden_state *state) {
         sail_destroy_io(state->io);
     }
 
+    destroy_rows(state);
+    sail_destroy_image(state->pending_image);
+    sail_destroy_read_options(state->read_options);
+
+    struct sail_arena *thread_arena = sail_set_thread_arena(state->arena);
+
     sail_destroy_write_options(state->write_options);
 
     /* This state must be freed and zeroed by codecs. We free it just in case to avoid memory leaks. */
     sail_free(state->state);
 
+    sail_set_thread_arena(thread_arena);
+
+    sail_destroy_arena(state->arena);
+
     sail_free(state);
 }
 
@@ -149,14 +471,29 @@ sail_status_t stop_writing(void *state, size_t *written) {
         return SAIL_OK;
     }
 
+    struct sail_arena *thread_arena = sail_set_thread_arena(state_of_mind->arena);
+
     SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->write_finish(&state_of_mind->state, state_of_mind->io),
-                        /* cleanup */ destroy_hidden_state(state_of_mind));
+                        /* cleanup */ sail_set_thread_arena(thread_arena),
+                                      destroy_hidden_state(state_of_mind));
+
+    sail_set_thread_arena(thread_arena);
 
     if (written != NULL) {
-        /* The stream cursor may not be positioned at the end. Let's move it. */
-        SAIL_TRY_OR_CLEANUP(state_of_mind->io->seek(state_of_mind->io->stream, 0, SEEK_END),
+        /*
+         * The stream cursor may not be positioned at the end. Let's move it.
+         * Non-seekable sinks are always written sequentially and count the bytes written.
+         */
+        if ((state_of_mind->io->features & SAIL_IO_FEATURE_NON_SEEKABLE) == 0) {
+            SAIL_TRY_OR_CLEANUP(sail_io_seek(state_of_mind->io, 0, SEEK_END),
+                                /* cleanup */ destroy_hidden_state(state_of_mind));
+        }
+
+        uint64_t written_local = 0;
+        sail_io_tell(state_of_mind->io, &written_local);
+
+        SAIL_TRY_OR_CLEANUP(offset64_to_size(written_local, written),
                             /* cleanup */ destroy_hidden_state(state_of_mind));
-        state_of_mind->io->tell(state_of_mind->io->stream, written);
     }
 
     destroy_hidden_state(state_of_mind);
@@ -164,6 +501,346 @@ sail_status_t stop_writing(void *state, size_t *written) {
     return SAIL_OK;
 }
 
+sail_status_t offset64_to_size(uint64_t offset64, size_t *offset) {
+
+    SAIL_CHECK_PTR(offset);
+
+    if (offset64 > SIZE_MAX) {
+        SAIL_LOG_ERROR("The I/O offset %llu doesn't fit into size_t", (unsigned long long)offset64);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_TELL_IO);
+    }
+
+    *offset = (size_t)offset64;
+
+    return SAIL_OK;
+}
+
+sail_status_t read_seek_next_frame(struct hidden_state *state_of_mind, struct sail_image **image) {
+
+    /* The frame which pixels didn't fit into the buffer of sail_read_next_frame_to_buffer() is skipped. */
+    sail_destroy_image(state_of_mind->pending_image);
+    state_of_mind->pending_image = NULL;
+
+    /*
+     * Reading the next frame abandons the frame being read by scan lines. Multi-frame codecs need
+     * the rest of the frame to be consumed to reach the next frame. Skip the rest of its scan lines,
+     * or decode it in full if the codec cannot read it by scan lines and it's not decoded yet.
+     */
+    if (state_of_mind->rows_image != NULL) {
+        const int multi_frame = SAIL_CODEC_FEATURE_ANIMATED | SAIL_CODEC_FEATURE_MULTI_FRAME;
+
+        if ((state_of_mind->codec_info->read_features->features & multi_frame) != 0) {
+            if (can_read_scan_lines(state_of_mind, state_of_mind->rows_image)) {
+                if (state_of_mind->scan_lines_read < state_of_mind->rows_image->height) {
+                    SAIL_TRY_OR_CLEANUP(read_scan_lines(state_of_mind, NULL, state_of_mind->rows_image->height - state_of_mind->scan_lines_read),
+                                        /* cleanup */ destroy_rows(state_of_mind));
+                }
+            } else if (state_of_mind->rows_image->pixels == NULL) {
+                SAIL_TRY_OR_CLEANUP(decode_rows_frame(state_of_mind),
+                                    /* cleanup */ destroy_rows(state_of_mind));
+            }
+        }
+
+        destroy_rows(state_of_mind);
+    }
+
+    if (state_of_mind->arena == NULL) {
+        SAIL_TRY(state_of_mind->codec->v4->read_seek_next_frame(state_of_mind->state, state_of_mind->io, image));
+        return SAIL_OK;
+    }
+
+    struct sail_arena *thread_arena = sail_set_thread_arena(state_of_mind->arena);
+
+    struct sail_image *arena_image;
+    SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->read_seek_next_frame(state_of_mind->state, state_of_mind->io, &arena_image),
+                        /* cleanup */ sail_set_thread_arena(thread_arena));
+
+    /* Copy the image out of the arena. The arena copy is freed with the arena. */
+    sail_set_thread_arena(NULL);
+
+    SAIL_TRY_OR_CLEANUP(sail_copy_image(arena_image, image),
+                        /* cleanup */ sail_set_thread_arena(thread_arena));
+
+    sail_set_thread_arena(thread_arena);
+
+    return SAIL_OK;
+}
+
+bool can_read_scan_lines(const struct hidden_state *state_of_mind, const struct sail_image *image) {
+
+    if (state_of_mind->codec->v4->read_scan_lines == NULL) {
+        return false;
+    }
+
+    if ((state_of_mind->codec_info->read_features->features & SAIL_CODEC_FEATURE_SCAN_LINES) == 0) {
+        return false;
+    }
+
+    return (image->source_image->properties & SAIL_IMAGE_PROPERTY_INTERLACED) == 0;
+}
+
+bool transform_requested(const struct hidden_state *state_of_mind) {
+
+    const struct sail_read_options *read_options = state_of_mind->read_options;
+
+    if (read_options == NULL) {
+        return false;
+    }
+
+    if (read_options->roi_width > 0 && read_options->roi_height > 0) {
+        return true;
+    }
+
+    if (state_of_mind->codec_info->read_features->features & SAIL_CODEC_FEATURE_SCALING) {
+        return false;
+    }
+
+    return read_options->target_size > 0 || read_options->scale_denominator > 1;
+}
+
+sail_status_t start_reading_rows(struct hidden_state *state_of_mind, struct sail_image *image) {
+
+    /* Reduce frames if the codec cannot do it natively. */
+    unsigned scale = 1;
+
+    if (state_of_mind->read_options != NULL && (state_of_mind->codec_info->read_features->features & SAIL_CODEC_FEATURE_SCALING) == 0) {
+        SAIL_TRY(sail_read_options_scale_denominator(state_of_mind->read_options, image->width, image->height, &scale));
+    }
+
+    unsigned bits_per_pixel;
+    SAIL_TRY(sail_bits_per_pixel(image->pixel_format, &bits_per_pixel));
+
+    unsigned depth    = 0;
+    unsigned channels = 0;
+
+    if (scale > 1) {
+        SAIL_TRY(box_depth(image->pixel_format, &depth));
+        channels = bits_per_pixel / 8 / depth;
+    }
+
+    const unsigned frame_width  = (image->width  + scale - 1) / scale;
+    const unsigned frame_height = (image->height + scale - 1) / scale;
+
+    unsigned region_x      = 0;
+    unsigned region_y      = 0;
+    unsigned region_width  = frame_width;
+    unsigned region_height = frame_height;
+
+    if (state_of_mind->read_options != NULL && state_of_mind->read_options->roi_width > 0 && state_of_mind->read_options->roi_height > 0) {
+        const struct sail_read_options *read_options = state_of_mind->read_options;
+
+        if (read_options->roi_x >= frame_width || read_options->roi_y >= frame_height) {
+            SAIL_LOG_ERROR("The region of interest at %u,%u is outside of the %ux%u frame",
+                            read_options->roi_x, read_options->roi_y, frame_width, frame_height);
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_INCORRECT_IMAGE_DIMENSIONS);
+        }
+
+        region_x      = read_options->roi_x;
+        region_y      = read_options->roi_y;
+        region_width  = (read_options->roi_width  < frame_width  - region_x) ? read_options->roi_width  : frame_width  - region_x;
+        region_height = (read_options->roi_height < frame_height - region_y) ? read_options->roi_height : frame_height - region_y;
+    }
+
+    /* Scan lines are cropped by copying bytes. */
+    if (((uint64_t)region_x * bits_per_pixel) % 8 != 0) {
+        SAIL_LOG_ERROR("The region of interest must start at a byte boundary in the %u-bit pixel format", bits_per_pixel);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+    }
+
+    unsigned region_bytes_per_line;
+    SAIL_TRY(sail_bytes_per_line(region_width, image->pixel_format, &region_bytes_per_line));
+
+    /* Keep a private copy to pass to codecs as the caller is free to modify or destroy its image. */
+    struct sail_image *rows_image;
+    SAIL_TRY(sail_copy_image(image, &rows_image));
+
+    const bool scan_lines = can_read_scan_lines(state_of_mind, rows_image);
+
+    void *scan_line = NULL;
+    uint64_t *box_sums = NULL;
+
+    if (scan_lines && (scale > 1 || region_width < rows_image->width)) {
+        SAIL_TRY_OR_CLEANUP(sail_malloc(rows_image->bytes_per_line, &scan_line),
+                            /* cleanup */ sail_destroy_image(rows_image));
+    }
+
+    if (scale > 1) {
+        void *ptr;
+        SAIL_TRY_OR_CLEANUP(sail_malloc((size_t)region_width * channels * sizeof(uint64_t), &ptr),
+                            /* cleanup */ sail_free(scan_line),
+                                          sail_destroy_image(rows_image));
+        box_sums = ptr;
+    }
+
+    /* Frames read by scan lines have exactly one pass. */
+    if (scan_lines) {
+        struct sail_arena *thread_arena = sail_set_thread_arena(state_of_mind->arena);
+
+        SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->read_seek_next_pass(state_of_mind->state, state_of_mind->io, rows_image),
+                            /* cleanup */ sail_set_thread_arena(thread_arena),
+                                          sail_free(box_sums),
+                                          sail_free(scan_line),
+                                          sail_destroy_image(rows_image));
+
+        sail_set_thread_arena(thread_arena);
+    }
+
+    state_of_mind->rows_image      = rows_image;
+    state_of_mind->rows_read       = 0;
+    state_of_mind->scan_lines_read = 0;
+    state_of_mind->scale           = scale;
+    state_of_mind->region_x        = region_x;
+    state_of_mind->region_y        = region_y;
+    state_of_mind->region_width    = region_width;
+    state_of_mind->region_height   = region_height;
+    state_of_mind->scan_line       = scan_line;
+    state_of_mind->box_sums        = box_sums;
+    state_of_mind->box_channels    = channels;
+    state_of_mind->box_depth       = depth;
+    state_of_mind->box_alpha       = box_alpha(image->pixel_format, channels);
+
+    /* The caller sees the region only. */
+    image->width          = region_width;
+    image->height         = region_height;
+    image->bytes_per_line = region_bytes_per_line;
+
+    return SAIL_OK;
+}
+
+sail_status_t read_rows(struct hidden_state *state_of_mind, void *rows, unsigned bytes_per_line, unsigned count) {
+
+    struct sail_image *rows_image = state_of_mind->rows_image;
+
+    if (rows_image == NULL) {
+        SAIL_LOG_ERROR("No frame is being read by scan lines. Call sail_read_next_frame_header() first");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    const unsigned rows_left = state_of_mind->region_height - state_of_mind->rows_read;
+
+    if (count > rows_left) {
+        SAIL_LOG_ERROR("Cannot read %u scan lines as only %u scan lines are left in the frame", count, rows_left);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    if (count == 0) {
+        return SAIL_OK;
+    }
+
+    unsigned bits_per_pixel;
+    SAIL_TRY(sail_bits_per_pixel(rows_image->pixel_format, &bits_per_pixel));
+
+    unsigned region_bytes_per_line;
+    SAIL_TRY(sail_bytes_per_line(state_of_mind->region_width, rows_image->pixel_format, &region_bytes_per_line));
+
+    const size_t region_offset = (size_t)((uint64_t)state_of_mind->region_x * bits_per_pixel / 8);
+
+    if (bytes_per_line == 0) {
+        bytes_per_line = region_bytes_per_line;
+    }
+
+    const bool scan_lines = can_read_scan_lines(state_of_mind, rows_image);
+
+    /* The codec cannot read this frame by scan lines. Decode it in full once and hand out its scan lines. */
+    if (!scan_lines && rows_image->pixels == NULL) {
+        SAIL_TRY(decode_rows_frame(state_of_mind));
+    }
+
+    const unsigned first_row = state_of_mind->region_y + state_of_mind->rows_read;
+
+    if (scan_lines && state_of_mind->scan_line == NULL) {
+        /* Whole scan lines are read directly. Skip the scan lines above the region. */
+        if (state_of_mind->scan_lines_read < first_row) {
+            SAIL_TRY(read_scan_lines(state_of_mind, NULL, first_row - state_of_mind->scan_lines_read));
+        }
+
+        if (bytes_per_line == rows_image->bytes_per_line) {
+            SAIL_TRY(read_scan_lines(state_of_mind, rows, count));
+        } else {
+            for (unsigned row = 0; row < count; row++) {
+                SAIL_TRY(read_scan_lines(state_of_mind, (unsigned char *)rows + (size_t)row * bytes_per_line, 1));
+            }
+        }
+    } else if (state_of_mind->scale > 1) {
+        for (unsigned row = 0; row < count; row++) {
+            SAIL_TRY(reduce_scan_line(state_of_mind, first_row + row, (unsigned char *)rows + (size_t)row * bytes_per_line));
+        }
+    } else {
+        for (unsigned row = 0; row < count; row++) {
+            const unsigned char *scan_line;
+            SAIL_TRY(source_scan_line(state_of_mind, first_row + row, &scan_line));
+
+            memcpy((unsigned char *)rows + (size_t)row * bytes_per_line, scan_line + region_offset, region_bytes_per_line);
+        }
+    }
+
+    state_of_mind->rows_read += count;
+
+    return SAIL_OK;
+}
+
+sail_status_t seek_next_frame_to_read(struct hidden_state *state_of_mind, struct sail_image **image) {
+
+    SAIL_TRY(read_seek_next_frame(state_of_mind, image));
+
+    /* Regions of interest and reduced frames are read by scan lines to skip the rest of the frame. */
+    if (transform_requested(state_of_mind)) {
+        SAIL_TRY_OR_CLEANUP(start_reading_rows(state_of_mind, *image),
+                            /* cleanup */ sail_destroy_image(*image));
+    }
+
+    return SAIL_OK;
+}
+
+sail_status_t read_frame_pixels(struct hidden_state *state_of_mind, struct sail_image *image) {
+
+    uint64_t pixels_size;
+    SAIL_TRY(sail_bytes_per_image64(image, &pixels_size));
+
+    if (pixels_size > SIZE_MAX) {
+        SAIL_LOG_ERROR("The image of %llu bytes doesn't fit into the address space", (unsigned long long)pixels_size);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
+    }
+
+    SAIL_TRY(sail_acquire_pooled_pixels((size_t)pixels_size, &image->pixels, &image->pixels_pool_size));
+
+    if (transform_requested(state_of_mind)) {
+        SAIL_TRY(read_rows(state_of_mind, image->pixels, image->bytes_per_line, image->height));
+    } else {
+        SAIL_TRY(read_frame_passes(state_of_mind, image));
+    }
+
+    return SAIL_OK;
+}
+
+sail_status_t read_frame_passes(struct hidden_state *state_of_mind, struct sail_image *image) {
+
+    /* Detect the number of passes needed to read an interlaced image. */
+    int interlaced_passes;
+    if (image->source_image->properties & SAIL_IMAGE_PROPERTY_INTERLACED) {
+        interlaced_passes = image->interlaced_passes;
+
+        if (interlaced_passes < 1) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_INTERLACING_UNSUPPORTED);
+        }
+    } else {
+        interlaced_passes = 1;
+    }
+
+    struct sail_arena *thread_arena = sail_set_thread_arena(state_of_mind->arena);
+
+    for (int pass = 0; pass < interlaced_passes; pass++) {
+        SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->read_seek_next_pass(state_of_mind->state, state_of_mind->io, image),
+                            /* cleanup */ sail_set_thread_arena(thread_arena));
+        SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->read_frame(state_of_mind->state, state_of_mind->io, image),
+                            /* cleanup */ sail_set_thread_arena(thread_arena));
+    }
+
+    sail_set_thread_arena(thread_arena);
+
+    return SAIL_OK;
+}
+
 sail_status_t allowed_write_output_pixel_format(const struct sail_write_features *write_features,
                                                 enum SailPixelFormat input_pixel_format,
                                                 enum SailPixelFormat output_pixel_format) {
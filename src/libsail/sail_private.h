@@ -28,6 +28,7 @@
 
 #include <stdbool.h>
 #include <stddef.h> /* size_t */
+#include <stdint.h>
 
 #ifdef SAIL_BUILD
     #include "common.h"
@@ -40,7 +41,9 @@
 #endif
 
 struct sail_codec_info;
+struct sail_arena;
 struct sail_codec;
+struct sail_image;
 struct sail_string_node;
 struct sail_write_features;
 
@@ -55,14 +58,85 @@ struct hidden_state {
      */
     struct sail_write_options *write_options;
 
+    /* Read operations save read options to apply the region of interest. NULL when reading with default options. */
+    struct sail_read_options *read_options;
+
     /* Local state passed to codec reading and writing functions. */
     void *state;
 
+    /*
+     * Arena to allocate the codec state and other internal data from. It's set as the thread arena
+     * while codecs are running. NULL when SAIL_IO_OPTION_ARENA is not requested.
+     */
+    struct sail_arena *arena;
+
+    /*
+     * Frame being read with sail_read_next_rows() and the number of its scan lines read so far.
+     * Its pixels hold the whole frame when the codec cannot read the frame by scan lines.
+     * NULL when no frame is being read by scan lines.
+     */
+    struct sail_image *rows_image;
+    unsigned rows_read;
+
+    /*
+     * Frame seeked by sail_read_next_frame_to_buffer() which pixels didn't fit into the caller buffer.
+     * The next call reads its pixels instead of seeking the next frame. NULL otherwise.
+     */
+    struct sail_image *pending_image;
+
+    /* The number of scan lines of rows_image consumed from the codec when reading by scan lines. */
+    unsigned scan_lines_read;
+
+    /*
+     * Denominator to reduce rows_image with when the codec cannot reduce frames natively. 1 means no reduction.
+     * Scan lines are reduced with a box filter.
+     */
+    unsigned scale;
+
+    /*
+     * Region of the reduced rows_image handed out to the caller. Equals the whole reduced frame without
+     * a region of interest.
+     */
+    unsigned region_x;
+    unsigned region_y;
+    unsigned region_width;
+    unsigned region_height;
+
+    /*
+     * Buffer to read scan lines into to crop or reduce them. NULL when scan lines of the region
+     * are read directly.
+     */
+    void *scan_line;
+
+    /*
+     * Per-channel sums of the reduced region scan line, the number of channels, bytes per channel,
+     * and the index of the alpha channel. The alpha index equals the number of channels without alpha.
+     */
+    uint64_t *box_sums;
+    unsigned box_channels;
+    unsigned box_depth;
+    unsigned box_alpha;
+
     /* Pointers to internal data structures so no need to free these. */
     const struct sail_codec_info *codec_info;
     const struct sail_codec *codec;
 };
 
+/*
+ * Function called by parallel_for() for every item.
+ */
+typedef void (*parallel_func_t)(void *arg, size_t index);
+
+/*
+ * Calls the function for every index from 0 to count - 1 in up to the specified number of threads
+ * including the calling one. 0 threads means the number of CPU cores. Indexes are handed out
+ * in ascending order. Worker threads borrow the context of the calling thread, so they don't enumerate
+ * codecs again. Returns when all the items are processed.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t parallel_for(size_t count, unsigned threads, parallel_func_t func, void *arg);
+
 SAIL_HIDDEN sail_status_t load_codec_by_codec_info(const struct sail_codec_info *codec_info,
                                                     const struct sail_codec **codec);
 
@@ -70,6 +144,60 @@ SAIL_HIDDEN void destroy_hidden_state(struct hidden_state *state);
 
 SAIL_HIDDEN sail_status_t stop_writing(void *state, size_t *written);
 
+/*
+ * Converts the 64-bit I/O offset into size_t. Used by the size_t-based tell() callbacks.
+ *
+ * Returns SAIL_OK on success or SAIL_ERROR_TELL_IO if the offset doesn't fit into size_t.
+ */
+SAIL_HIDDEN sail_status_t offset64_to_size(uint64_t offset64, size_t *offset);
+
+/*
+ * Seeks to the next frame. The image is never allocated from the arena as it's handed over to the caller.
+ */
+SAIL_HIDDEN sail_status_t read_seek_next_frame(struct hidden_state *state_of_mind, struct sail_image **image);
+
+/*
+ * Returns true if the codec can read the specified frame by scan lines with read_scan_lines().
+ * Interlaced frames are never read by scan lines.
+ */
+SAIL_HIDDEN bool can_read_scan_lines(const struct hidden_state *state_of_mind, const struct sail_image *image);
+
+/*
+ * Returns true if the region of interest or a reduction the codec cannot do natively was requested
+ * in the read options. Such frames are read with read_rows().
+ */
+SAIL_HIDDEN bool transform_requested(const struct hidden_state *state_of_mind);
+
+/*
+ * Prepares the frame returned by read_seek_next_frame() for reading with read_rows(). Reduces
+ * the image dimensions and crops them to the region of interest if it was requested.
+ */
+SAIL_HIDDEN sail_status_t start_reading_rows(struct hidden_state *state_of_mind, struct sail_image *image);
+
+/*
+ * Reads the next count scan lines of the region of the frame started with start_reading_rows().
+ * Pass 0 as bytes_per_line to use the minimum number of bytes per line of the region.
+ */
+SAIL_HIDDEN sail_status_t read_rows(struct hidden_state *state_of_mind, void *rows, unsigned bytes_per_line, unsigned count);
+
+/*
+ * Seeks to the next frame to be read with read_frame_pixels(). Prepares the frame for reading
+ * with read_rows() if a transform was requested.
+ */
+SAIL_HIDDEN sail_status_t seek_next_frame_to_read(struct hidden_state *state_of_mind, struct sail_image **image);
+
+/*
+ * Allocates the pixels of the frame returned by seek_next_frame_to_read() and reads them.
+ * Images could be bigger than 4 GB.
+ */
+SAIL_HIDDEN sail_status_t read_frame_pixels(struct hidden_state *state_of_mind, struct sail_image *image);
+
+/*
+ * Reads all the passes of the current frame into the pixels of the specified image
+ * using its bytes per line.
+ */
+SAIL_HIDDEN sail_status_t read_frame_passes(struct hidden_state *state_of_mind, struct sail_image *image);
+
 SAIL_HIDDEN sail_status_t allowed_write_output_pixel_format(const struct sail_write_features *write_features,
                                                             enum SailPixelFormat input_pixel_format,
                                                             enum SailPixelFormat output_pixel_format);
@@ -30,6 +30,26 @@
 #include "sail-common.h"
 #include "sail.h"
 
+/*
+ * Private functions.
+ */
+
+/* Non-seekable sources are read only by codecs that never seek. */
+static sail_status_t check_non_seekable_read(const struct sail_io *io, const struct sail_codec_info *codec_info) {
+
+    if ((io->features & SAIL_IO_FEATURE_NON_SEEKABLE) &&
+            (codec_info->read_features->features & SAIL_CODEC_FEATURE_STREAMING) == 0) {
+        SAIL_LOG_ERROR("%s codec cannot read from non-seekable I/O streams", codec_info->name);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_CODEC_FEATURE);
+    }
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
 sail_status_t sail_start_reading_io(struct sail_io *io, const struct sail_codec_info *codec_info, void **state) {
 
     SAIL_TRY(sail_start_reading_io_with_options(io, codec_info, NULL, state));
@@ -41,7 +61,33 @@ sail_status_t sail_start_reading_io_with_options(struct sail_io *io,
                                                 const struct sail_codec_info *codec_info,
                                                 const struct sail_read_options *read_options, void **state) {
 
-    SAIL_TRY(start_reading_io_with_options(io, false, codec_info, read_options, state));
+    SAIL_CHECK_IO_PTR(io);
+
+    /* Streaming codecs read non-seekable sources directly. */
+    if (codec_info != NULL) {
+        SAIL_TRY(check_non_seekable_read(io, codec_info));
+        SAIL_TRY(start_reading_io_with_options(io, false, codec_info, read_options, state));
+        return SAIL_OK;
+    }
+
+    /* Read non-seekable sources through a ring buffer to rewind them after reading the magic number. */
+    struct sail_io *io_local = io;
+    bool own_io = false;
+
+    if (io->features & SAIL_IO_FEATURE_NON_SEEKABLE) {
+        SAIL_TRY(alloc_io_read_ring_buffer(io, 0 /* default window size */, &io_local));
+        own_io = true;
+    }
+
+    const struct sail_codec_info *codec_info_local;
+    SAIL_TRY_OR_CLEANUP(sail_codec_info_by_magic_number_from_io(io_local, &codec_info_local),
+                        /* cleanup */ if (own_io) sail_destroy_io(io_local));
+
+    SAIL_TRY_OR_CLEANUP(check_non_seekable_read(io, codec_info_local),
+                        /* cleanup */ if (own_io) sail_destroy_io(io_local));
+
+    /* The ring buffer I/O object will be destroyed in this function. */
+    SAIL_TRY(start_reading_io_with_options(io_local, own_io, codec_info_local, read_options, state));
 
     return SAIL_OK;
 }
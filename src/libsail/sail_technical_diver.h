@@ -44,7 +44,13 @@ struct sail_read_options;
 struct sail_write_options;
 
 /*
- * Starts reading the specified I/O stream.
+ * Starts reading the specified I/O stream. If the codec info is NULL, the image format is detected
+ * by its magic number.
+ *
+ * Non-seekable I/O streams (with SAIL_IO_FEATURE_NON_SEEKABLE) could be read only by codecs
+ * with SAIL_CODEC_FEATURE_STREAMING in their read features like JPEG, PNG, or GIF. They are read directly
+ * when the codec info is specified. Otherwise, they are read through a ring buffer with a limited rewind window
+ * to detect the image format. Other codecs fail with SAIL_ERROR_UNSUPPORTED_CODEC_FEATURE up front.
  *
  * Outputs pixels in the BPP32-RGBA pixel format.
  *
@@ -68,6 +74,9 @@ SAIL_EXPORT sail_status_t sail_start_reading_io(struct sail_io *io, const struct
  * Starts reading the specified I/O stream with the specified read options. If you don't need specific read options,
  * just pass NULL. Codec-specific defaults will be used in this case. The read options are deep copied.
  *
+ * If the codec info is NULL, the image format is detected by its magic number. See sail_start_reading_io()
+ * for how non-seekable I/O streams are handled.
+ *
  * If read options is NULL, the subsequent calls to sail_read_next_frame() output pixels in the BPP32-RGBA pixel format.
  *
  * Typical usage: sail_alloc_io()                      ->
@@ -91,6 +100,11 @@ SAIL_EXPORT sail_status_t sail_start_reading_io_with_options(struct sail_io *io,
 /*
  * Starts writing into the specified I/O stream.
  *
+ * Non-seekable I/O streams (with SAIL_IO_FEATURE_NON_SEEKABLE) could be written only by codecs
+ * with SAIL_CODEC_FEATURE_STREAMING in their write features. The data is streamed into them as it's
+ * encoded, and the number of bytes written is counted instead of seeking. Other codecs fail
+ * with SAIL_ERROR_UNSUPPORTED_CODEC_FEATURE up front.
+ *
  * The subsequent calls to sail_write_next_frame() output pixels in pixel format as specified
  * in sail_write_features.default_output_pixel_format.
  *
@@ -117,6 +131,8 @@ SAIL_EXPORT sail_status_t sail_start_writing_io(struct sail_io *io, const struct
  * If write options is NULL, the subsequent calls to sail_write_next_frame() output pixels in pixel format
  * as specified in sail_write_features.default_output_pixel_format.
  *
+ * See sail_start_writing_io() for how non-seekable I/O streams are handled.
+ *
  * Typical usage: sail_alloc_io()                      ->
  *                set I/O callbacks                    ->
  *                sail_codec_info_from_extension()     ->
@@ -103,6 +103,15 @@ sail_status_t start_reading_io_with_options(struct sail_io *io, bool own_io,
     if (read_options != NULL) {
         SAIL_TRY_OR_CLEANUP(allowed_read_output_pixel_format(codec_info->read_features, read_options->output_pixel_format),
                             /* cleanup */ if (own_io) sail_destroy_io(io));
+
+        /* Codecs don't set up decoders in the probe mode. */
+        if (read_options->io_options & SAIL_IO_OPTION_PROBE) {
+            SAIL_LOG_ERROR("Frames cannot be read with SAIL_IO_OPTION_PROBE. Use sail_probe_io() and brothers instead");
+            if (own_io) {
+                sail_destroy_io(io);
+            }
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+        }
     }
 
     void *ptr;
@@ -110,12 +119,28 @@ sail_status_t start_reading_io_with_options(struct sail_io *io, bool own_io,
                         /* cleanup */ if (own_io) sail_destroy_io(io));
     struct hidden_state *state_of_mind = ptr;
 
-    state_of_mind->io            = io;
-    state_of_mind->own_io        = own_io;
-    state_of_mind->write_options = NULL;
-    state_of_mind->state         = NULL;
-    state_of_mind->codec_info   = codec_info;
-    state_of_mind->codec        = NULL;
+    state_of_mind->io              = io;
+    state_of_mind->own_io          = own_io;
+    state_of_mind->write_options   = NULL;
+    state_of_mind->read_options    = NULL;
+    state_of_mind->state           = NULL;
+    state_of_mind->arena           = NULL;
+    state_of_mind->rows_image      = NULL;
+    state_of_mind->rows_read       = 0;
+    state_of_mind->pending_image   = NULL;
+    state_of_mind->scan_lines_read = 0;
+    state_of_mind->region_x        = 0;
+    state_of_mind->region_y        = 0;
+    state_of_mind->region_width    = 0;
+    state_of_mind->region_height   = 0;
+    state_of_mind->scan_line       = NULL;
+    state_of_mind->scale           = 1;
+    state_of_mind->box_sums        = NULL;
+    state_of_mind->box_channels    = 0;
+    state_of_mind->box_depth       = 0;
+    state_of_mind->box_alpha       = 0;
+    state_of_mind->codec_info      = codec_info;
+    state_of_mind->codec           = NULL;
 
     SAIL_TRY_OR_CLEANUP(load_codec_by_codec_info(state_of_mind->codec_info, &state_of_mind->codec),
                         /* cleanup */ destroy_hidden_state(state_of_mind));
@@ -132,9 +157,22 @@ sail_status_t start_reading_io_with_options(struct sail_io *io, bool own_io,
                                           destroy_hidden_state(state_of_mind));
         sail_destroy_read_options(read_options_local);
     } else {
+        SAIL_TRY_OR_CLEANUP(sail_copy_read_options(read_options, &state_of_mind->read_options),
+                            /* cleanup */ destroy_hidden_state(state_of_mind));
+
+        if (read_options->io_options & SAIL_IO_OPTION_ARENA) {
+            SAIL_TRY_OR_CLEANUP(sail_alloc_arena(0, &state_of_mind->arena),
+                                /* cleanup */ destroy_hidden_state(state_of_mind));
+        }
+
+        struct sail_arena *thread_arena = sail_set_thread_arena(state_of_mind->arena);
+
         SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->read_init(state_of_mind->io, read_options, &state_of_mind->state),
                             /* cleanup */ state_of_mind->codec->v4->read_finish(&state_of_mind->state, state_of_mind->io),
+                                          sail_set_thread_arena(thread_arena),
                                           destroy_hidden_state(state_of_mind));
+
+        sail_set_thread_arena(thread_arena);
     }
 
     *state = state_of_mind;
@@ -160,33 +198,79 @@ sail_status_t start_writing_io_with_options(struct sail_io *io, bool own_io,
                             /* cleanup */ if (own_io) sail_destroy_io(io));
     }
 
+    /* Non-seekable sinks are written only by codecs that never seek. Count the bytes as they go. */
+    if (io->features & SAIL_IO_FEATURE_NON_SEEKABLE) {
+        if ((codec_info->write_features->features & SAIL_CODEC_FEATURE_STREAMING) == 0) {
+            SAIL_LOG_ERROR("%s codec cannot write into non-seekable I/O streams", codec_info->name);
+            if (own_io) {
+                sail_destroy_io(io);
+            }
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_CODEC_FEATURE);
+        }
+
+        struct sail_io *counting_io;
+        SAIL_TRY_OR_CLEANUP(alloc_io_write_counting(io, own_io, &counting_io),
+                            /* cleanup */ if (own_io) sail_destroy_io(io));
+
+        io     = counting_io;
+        own_io = true;
+    }
+
     void *ptr;
     SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(struct hidden_state), &ptr),
                         /* cleanup */ if (own_io) sail_destroy_io(io));
     struct hidden_state *state_of_mind = ptr;
 
-    state_of_mind->io            = io;
-    state_of_mind->own_io        = own_io;
-    state_of_mind->write_options = NULL;
-    state_of_mind->state         = NULL;
-    state_of_mind->codec_info    = codec_info;
-    state_of_mind->codec         = NULL;
+    state_of_mind->io              = io;
+    state_of_mind->own_io          = own_io;
+    state_of_mind->write_options   = NULL;
+    state_of_mind->read_options    = NULL;
+    state_of_mind->state           = NULL;
+    state_of_mind->arena           = NULL;
+    state_of_mind->rows_image      = NULL;
+    state_of_mind->rows_read       = 0;
+    state_of_mind->pending_image   = NULL;
+    state_of_mind->scan_lines_read = 0;
+    state_of_mind->region_x        = 0;
+    state_of_mind->region_y        = 0;
+    state_of_mind->region_width    = 0;
+    state_of_mind->region_height   = 0;
+    state_of_mind->scan_line       = NULL;
+    state_of_mind->scale           = 1;
+    state_of_mind->box_sums        = NULL;
+    state_of_mind->box_channels    = 0;
+    state_of_mind->box_depth       = 0;
+    state_of_mind->box_alpha       = 0;
+    state_of_mind->codec_info      = codec_info;
+    state_of_mind->codec           = NULL;
 
     SAIL_TRY_OR_CLEANUP(load_codec_by_codec_info(state_of_mind->codec_info, &state_of_mind->codec),
                         /* cleanup */ destroy_hidden_state(state_of_mind));
 
+    if (write_options != NULL && (write_options->io_options & SAIL_IO_OPTION_ARENA)) {
+        SAIL_TRY_OR_CLEANUP(sail_alloc_arena(0, &state_of_mind->arena),
+                            /* cleanup */ destroy_hidden_state(state_of_mind));
+    }
+
+    struct sail_arena *thread_arena = sail_set_thread_arena(state_of_mind->arena);
+
     if (write_options == NULL) {
         SAIL_TRY_OR_CLEANUP(sail_alloc_write_options_from_features(state_of_mind->codec_info->write_features, &state_of_mind->write_options),
-                            /* cleanup */ destroy_hidden_state(state_of_mind));
+                            /* cleanup */ sail_set_thread_arena(thread_arena),
+                                          destroy_hidden_state(state_of_mind));
     } else {
         SAIL_TRY_OR_CLEANUP(sail_copy_write_options(write_options, &state_of_mind->write_options),
-                            /* cleanup */ destroy_hidden_state(state_of_mind));
+                            /* cleanup */ sail_set_thread_arena(thread_arena),
+                                          destroy_hidden_state(state_of_mind));
     }
 
     SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v4->write_init(state_of_mind->io, state_of_mind->write_options, &state_of_mind->state),
                         /* cleanup */ state_of_mind->codec->v4->write_finish(&state_of_mind->state, state_of_mind->io),
+                                      sail_set_thread_arena(thread_arena),
                                       destroy_hidden_state(state_of_mind));
 
+    sail_set_thread_arena(thread_arena);
+
     *state = state_of_mind;
 
     return SAIL_OK;
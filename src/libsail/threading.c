@@ -0,0 +1,221 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <string.h>
+
+#ifndef SAIL_WIN32
+    #include <unistd.h> /* sysconf */
+#endif
+
+#include "sail-common.h"
+#include "sail.h"
+
+/*
+ * Private functions.
+ */
+
+struct thread_data {
+    sail_thread_func_t func;
+    void *arg;
+};
+
+#ifdef SAIL_WIN32
+static DWORD WINAPI thread_trampoline(LPVOID data) {
+#else
+static void *thread_trampoline(void *data) {
+#endif
+
+    struct thread_data thread_data = *(struct thread_data *)data;
+    sail_free(data);
+
+    thread_data.func(thread_data.arg);
+
+#ifdef SAIL_WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t init_mutex(sail_mutex_t *mutex) {
+
+    SAIL_CHECK_PTR(mutex);
+
+#ifdef SAIL_WIN32
+    InitializeSRWLock(mutex);
+#else
+    int res = pthread_mutex_init(mutex, NULL);
+
+    if (res != 0) {
+        SAIL_LOG_ERROR("Failed to initialize mutex: %s", strerror(res));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_THREADING);
+    }
+#endif
+
+    return SAIL_OK;
+}
+
+void destroy_mutex(sail_mutex_t *mutex) {
+
+    if (mutex == NULL) {
+        return;
+    }
+
+#ifdef SAIL_WIN32
+    /* SRW locks don't need to be destroyed. */
+#else
+    pthread_mutex_destroy(mutex);
+#endif
+}
+
+void lock_mutex(sail_mutex_t *mutex) {
+
+#ifdef SAIL_WIN32
+    AcquireSRWLockExclusive(mutex);
+#else
+    pthread_mutex_lock(mutex);
+#endif
+}
+
+void unlock_mutex(sail_mutex_t *mutex) {
+
+#ifdef SAIL_WIN32
+    ReleaseSRWLockExclusive(mutex);
+#else
+    pthread_mutex_unlock(mutex);
+#endif
+}
+
+sail_status_t init_cond(sail_cond_t *cond) {
+
+    SAIL_CHECK_PTR(cond);
+
+#ifdef SAIL_WIN32
+    InitializeConditionVariable(cond);
+#else
+    int res = pthread_cond_init(cond, NULL);
+
+    if (res != 0) {
+        SAIL_LOG_ERROR("Failed to initialize condition variable: %s", strerror(res));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_THREADING);
+    }
+#endif
+
+    return SAIL_OK;
+}
+
+void destroy_cond(sail_cond_t *cond) {
+
+    if (cond == NULL) {
+        return;
+    }
+
+#ifdef SAIL_WIN32
+    /* Condition variables don't need to be destroyed. */
+#else
+    pthread_cond_destroy(cond);
+#endif
+}
+
+void wait_cond(sail_cond_t *cond, sail_mutex_t *mutex) {
+
+#ifdef SAIL_WIN32
+    SleepConditionVariableSRW(cond, mutex, INFINITE, 0);
+#else
+    pthread_cond_wait(cond, mutex);
+#endif
+}
+
+void broadcast_cond(sail_cond_t *cond) {
+
+#ifdef SAIL_WIN32
+    WakeAllConditionVariable(cond);
+#else
+    pthread_cond_broadcast(cond);
+#endif
+}
+
+sail_status_t create_thread(sail_thread_t *thread, sail_thread_func_t func, void *arg) {
+
+    SAIL_CHECK_PTR(thread);
+    SAIL_CHECK_PTR(func);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct thread_data), &ptr));
+    struct thread_data *thread_data = ptr;
+
+    thread_data->func = func;
+    thread_data->arg  = arg;
+
+#ifdef SAIL_WIN32
+    *thread = CreateThread(NULL, 0, thread_trampoline, thread_data, 0, NULL);
+
+    if (*thread == NULL) {
+        SAIL_LOG_ERROR("Failed to create thread. Error: %d", GetLastError());
+        sail_free(thread_data);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_THREADING);
+    }
+#else
+    int res = pthread_create(thread, NULL, thread_trampoline, thread_data);
+
+    if (res != 0) {
+        SAIL_LOG_ERROR("Failed to create thread: %s", strerror(res));
+        sail_free(thread_data);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_THREADING);
+    }
+#endif
+
+    return SAIL_OK;
+}
+
+void join_thread(sail_thread_t thread) {
+
+#ifdef SAIL_WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+unsigned cpu_count(void) {
+
+#ifdef SAIL_WIN32
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+
+    return system_info.dwNumberOfProcessors > 0 ? (unsigned)system_info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return count > 0 ? (unsigned)count : 1;
+#endif
+}
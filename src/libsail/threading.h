@@ -0,0 +1,132 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_THREADING_H
+#define SAIL_THREADING_H
+
+#include "config.h"
+
+#ifdef SAIL_WIN32
+    #include <windows.h>
+#else
+    #include <pthread.h>
+#endif
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+/*
+ * Minimal portable mutex used to guard the state shared between threads.
+ */
+#ifdef SAIL_WIN32
+    typedef SRWLOCK sail_mutex_t;
+    #define SAIL_MUTEX_INITIALIZER SRWLOCK_INIT
+#else
+    typedef pthread_mutex_t sail_mutex_t;
+    #define SAIL_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#endif
+
+/*
+ * Minimal portable condition variable and thread.
+ */
+#ifdef SAIL_WIN32
+    typedef CONDITION_VARIABLE sail_cond_t;
+    typedef HANDLE sail_thread_t;
+#else
+    typedef pthread_cond_t sail_cond_t;
+    typedef pthread_t sail_thread_t;
+#endif
+
+/*
+ * Thread entry point.
+ */
+typedef void (*sail_thread_func_t)(void *arg);
+
+/*
+ * Initializes the mutex. Mutexes with static storage duration could be initialized
+ * with SAIL_MUTEX_INITIALIZER instead.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t init_mutex(sail_mutex_t *mutex);
+
+/*
+ * Destroys the mutex initialized with init_mutex(). The mutex must be unlocked.
+ */
+SAIL_HIDDEN void destroy_mutex(sail_mutex_t *mutex);
+
+/*
+ * Locks and unlocks the mutex. The mutex is not recursive.
+ */
+SAIL_HIDDEN void lock_mutex(sail_mutex_t *mutex);
+SAIL_HIDDEN void unlock_mutex(sail_mutex_t *mutex);
+
+/*
+ * Initializes the condition variable.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t init_cond(sail_cond_t *cond);
+
+/*
+ * Destroys the condition variable initialized with init_cond(). No threads must wait on it.
+ */
+SAIL_HIDDEN void destroy_cond(sail_cond_t *cond);
+
+/*
+ * Atomically unlocks the locked mutex and waits for the condition variable to be signaled.
+ * Locks the mutex again before returning. Spurious wakeups are possible.
+ */
+SAIL_HIDDEN void wait_cond(sail_cond_t *cond, sail_mutex_t *mutex);
+
+/*
+ * Wakes up all the threads waiting for the condition variable.
+ */
+SAIL_HIDDEN void broadcast_cond(sail_cond_t *cond);
+
+/*
+ * Starts a new thread executing the specified function with the specified argument.
+ * The thread MUST be joined later with join_thread().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t create_thread(sail_thread_t *thread, sail_thread_func_t func, void *arg);
+
+/*
+ * Waits for the thread started with create_thread() to finish and releases its resources.
+ */
+SAIL_HIDDEN void join_thread(sail_thread_t thread);
+
+/*
+ * Returns the number of online CPU cores or 1 if it's unknown.
+ */
+SAIL_HIDDEN unsigned cpu_count(void);
+
+#endif
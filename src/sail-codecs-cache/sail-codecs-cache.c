@@ -0,0 +1,83 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sail-common.h"
+#include "sail.h"
+
+static void help(char *app) {
+
+    fprintf(stderr, "sail-codecs-cache: Regenerate the SAIL codecs cache.\n\n");
+    fprintf(stderr, "Usage: %s [PATH TO CODECS]\n", app);
+    fprintf(stderr, "       %s [-v | --version]\n", app);
+    fprintf(stderr, "       %s [-h | --help]\n\n", app);
+    fprintf(stderr, "When no path is specified, the SAIL_CODECS_PATH environment variable is used.\n");
+    fprintf(stderr, "If it's not set, '%s' is used.\n", SAIL_CODECS_PATH);
+}
+
+int main(int argc, char *argv[]) {
+
+    if (argc > 2) {
+        help(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *codecs_path;
+
+    if (argc == 2) {
+        if (strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0) {
+            help(argv[0]);
+            return EXIT_SUCCESS;
+        }
+
+        if (strcmp(argv[1], "-v") == 0 || strcmp(argv[1], "--version") == 0) {
+            fprintf(stderr, "sail-codecs-cache 1.0.0\n");
+            return EXIT_SUCCESS;
+        }
+
+        codecs_path = argv[1];
+    } else {
+        codecs_path = getenv("SAIL_CODECS_PATH");
+
+        if (codecs_path == NULL) {
+            codecs_path = SAIL_CODECS_PATH;
+        }
+    }
+
+    /* Statuses don't fit into exit codes. */
+    const sail_status_t status = sail_update_codecs_cache(codecs_path);
+
+    if (status != SAIL_OK) {
+        fprintf(stderr, "Failed to update the codecs cache in '%s'. Error: %d\n", codecs_path, status);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
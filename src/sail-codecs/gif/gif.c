@@ -57,6 +57,7 @@ struct gif_state {
     int prev_disposal;
     int current_image;
     int current_pass;
+    unsigned next_scan_line;
     unsigned row;
     unsigned column;
     unsigned width;
@@ -91,6 +92,7 @@ static sail_status_t alloc_gif_state(struct gif_state **gif_state) {
     (*gif_state)->prev_disposal      = DISPOSAL_UNSPECIFIED;
     (*gif_state)->current_image      = -1;
     (*gif_state)->current_pass       = -1;
+    (*gif_state)->next_scan_line     = 0;
     (*gif_state)->row                = 0;
     (*gif_state)->column             = 0;
     (*gif_state)->width              = 0;
@@ -126,6 +128,42 @@ static void destroy_gif_state(struct gif_state *gif_state) {
     sail_free(gif_state);
 }
 
+/* Reads the next line of the current frame and composes it over the scan line cc of the canvas. */
+static sail_status_t read_line(struct gif_state *gif_state, unsigned cc, unsigned char *scan, unsigned canvas_width) {
+
+    if (DGifGetLine(gif_state->gif, gif_state->buf, gif_state->width) == GIF_ERROR) {
+        SAIL_LOG_ERROR("GIF: %s", GifErrorString(gif_state->gif->Error));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    /* Lines may be composed right on the canvas when skipped. */
+    if (scan != gif_state->first_frame[cc]) {
+        memcpy(scan, gif_state->first_frame[cc], canvas_width * 4);
+    }
+
+    for (unsigned i = 0; i < gif_state->width; i++) {
+        if (gif_state->buf[i] == gif_state->transparency_index) {
+            continue;
+        }
+
+        unsigned char *pixel = scan + (gif_state->column + i)*4;
+
+        if (gif_state->read_options->output_pixel_format == SAIL_PIXEL_FORMAT_BPP32_RGBA) {
+            pixel[0] = gif_state->map->Colors[gif_state->buf[i]].Red;
+            pixel[1] = gif_state->map->Colors[gif_state->buf[i]].Green;
+            pixel[2] = gif_state->map->Colors[gif_state->buf[i]].Blue;
+        } else if (gif_state->read_options->output_pixel_format == SAIL_PIXEL_FORMAT_BPP32_BGRA) {
+            pixel[0] = gif_state->map->Colors[gif_state->buf[i]].Blue;
+            pixel[1] = gif_state->map->Colors[gif_state->buf[i]].Green;
+            pixel[2] = gif_state->map->Colors[gif_state->buf[i]].Red;
+        }
+
+        pixel[3] = 255;
+    } // for
+
+    return SAIL_OK;
+}
+
 /*
  * Decoding functions.
  */
@@ -174,6 +212,11 @@ SAIL_EXPORT sail_status_t sail_codec_read_init_v4_gif(struct sail_io *io, const
         memset(&gif_state->background, 0, sizeof(gif_state->background));
     }
 
+    /* Don't allocate the canvas when probing. */
+    if (gif_state->read_options->io_options & SAIL_IO_OPTION_PROBE) {
+        return SAIL_OK;
+    }
+
     void *ptr;
 
     SAIL_TRY(sail_malloc(gif_state->gif->SWidth * sizeof(GifPixelType), &ptr));
@@ -379,6 +422,7 @@ SAIL_EXPORT sail_status_t sail_codec_read_seek_next_pass_v4_gif(void *state, str
 
     gif_state->layer++;
     gif_state->current_pass++;
+    gif_state->next_scan_line = 0;
 
     return SAIL_OK;
 }
@@ -394,7 +438,7 @@ SAIL_EXPORT sail_status_t sail_codec_read_frame_v4_gif(void *state, struct sail_
     /* Apply disposal method on the previous frame. */
     if (gif_state->current_image > 0 && gif_state->current_pass == 0) {
        for (unsigned cc = gif_state->prev_row; cc < gif_state->prev_row+gif_state->prev_height; cc++) {
-            unsigned char *scan = (unsigned char *)image->pixels + image->width*4*cc;
+            unsigned char *scan = (unsigned char *)image->pixels + (size_t)image->bytes_per_line*cc;
 
             if (gif_state->prev_disposal == DISPOSE_BACKGROUND) {
                 /*
@@ -416,7 +460,7 @@ SAIL_EXPORT sail_status_t sail_codec_read_frame_v4_gif(void *state, struct sail_
 
     /* Read lines. */
     for (unsigned cc = 0; cc < image->height; cc++) {
-        unsigned char *scan = (unsigned char *)image->pixels + image->width*4*cc;
+        unsigned char *scan = (unsigned char *)image->pixels + (size_t)image->bytes_per_line*cc;
 
         if (cc < gif_state->row || cc >= gif_state->row + gif_state->height) {
             if (gif_state->current_pass == 0) {
@@ -444,37 +488,60 @@ SAIL_EXPORT sail_status_t sail_codec_read_frame_v4_gif(void *state, struct sail_
         }
 
         if (do_read) {
-            if (DGifGetLine(gif_state->gif, gif_state->buf, gif_state->width) == GIF_ERROR) {
-                SAIL_LOG_ERROR("GIF: %s", GifErrorString(gif_state->gif->Error));
-                SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
-            }
+            SAIL_TRY(read_line(gif_state, cc, scan, image->width));
+        }
 
-            memcpy(scan, gif_state->first_frame[cc], image->width * 4);
+        if (gif_state->current_pass == image->interlaced_passes-1) {
+            memcpy(gif_state->first_frame[cc], scan, image->width * 4);
+        }
+    }
 
-            for (unsigned i = 0; i < gif_state->width; i++) {
-                if (gif_state->buf[i] == gif_state->transparency_index) {
-                    continue;
-                }
+    return SAIL_OK;
+}
 
-                unsigned char *pixel = scan + (gif_state->column + i)*4;
+SAIL_EXPORT sail_status_t sail_codec_read_scan_lines_v4_gif(void *state, struct sail_io *io, const struct sail_image *image,
+                                                           void *scan_lines, unsigned scan_lines_count) {
 
-                if (gif_state->read_options->output_pixel_format == SAIL_PIXEL_FORMAT_BPP32_RGBA) {
-                    pixel[0] = gif_state->map->Colors[gif_state->buf[i]].Red;
-                    pixel[1] = gif_state->map->Colors[gif_state->buf[i]].Green;
-                    pixel[2] = gif_state->map->Colors[gif_state->buf[i]].Blue;
-                } else if (gif_state->read_options->output_pixel_format == SAIL_PIXEL_FORMAT_BPP32_BGRA) {
-                    pixel[0] = gif_state->map->Colors[gif_state->buf[i]].Blue;
-                    pixel[1] = gif_state->map->Colors[gif_state->buf[i]].Green;
-                    pixel[2] = gif_state->map->Colors[gif_state->buf[i]].Red;
-                }
+    SAIL_CHECK_STATE_PTR(state);
+    SAIL_CHECK_IO(io);
+    SAIL_CHECK_IMAGE(image);
 
-                pixel[3] = 255;
-            } // for
+    struct gif_state *gif_state = (struct gif_state *)state;
+
+    /* Interlaced frames are never read by scan lines. */
+    if (gif_state->gif->Image.Interlace) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INTERLACING_UNSUPPORTED);
+    }
+
+    /* Apply disposal method on the previous frame. Canvas lines are copied into the output below. */
+    if (gif_state->current_image > 0 && gif_state->next_scan_line == 0 && gif_state->prev_disposal == DISPOSE_BACKGROUND) {
+        for (unsigned cc = gif_state->prev_row; cc < gif_state->prev_row+gif_state->prev_height; cc++) {
+            memset(gif_state->first_frame[cc] + gif_state->prev_column*4, 0, gif_state->prev_width*4); /* 4 = RGBA */
         }
+    }
 
-        if (gif_state->current_pass == image->interlaced_passes-1) {
-            memcpy(gif_state->first_frame[cc], scan, image->width * 4);
+    for (unsigned i = 0; i < scan_lines_count; i++) {
+        const unsigned cc = gif_state->next_scan_line++;
+
+        /* Skipped lines are still composed on the canvas for the next frames. */
+        if (scan_lines == NULL) {
+            if (cc >= gif_state->row && cc < gif_state->row + gif_state->height) {
+                SAIL_TRY(read_line(gif_state, cc, gif_state->first_frame[cc], image->width));
+            }
+
+            continue;
         }
+
+        unsigned char *scan = (unsigned char *)scan_lines + (size_t)image->bytes_per_line*i;
+
+        if (cc < gif_state->row || cc >= gif_state->row + gif_state->height) {
+            memcpy(scan, gif_state->first_frame[cc], image->width * 4);
+            continue;
+        }
+
+        SAIL_TRY(read_line(gif_state, cc, scan, image->width));
+
+        memcpy(gif_state->first_frame[cc], scan, image->width * 4);
     }
 
     return SAIL_OK;
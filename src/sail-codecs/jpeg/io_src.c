@@ -23,6 +23,8 @@
     SOFTWARE.
 */
 
+#include <stdint.h>
+
 #include <jerror.h>
 
 #include "sail-common.h"
@@ -87,6 +89,19 @@ static boolean fill_input_buffer(j_decompress_ptr cinfo)
     struct sail_jpeg_source_mgr *src = (struct sail_jpeg_source_mgr *)cinfo->src;
     size_t nbytes;
 
+    /* Hand the whole remaining input to libjpeg without copying if the I/O object supports it. */
+    if (src->io->borrow != NULL) {
+        const void *borrowed_buffer;
+
+        if (src->io->borrow(src->io->stream, SIZE_MAX, &borrowed_buffer, &nbytes) == SAIL_OK && nbytes > 0) {
+            src->pub.next_input_byte = borrowed_buffer;
+            src->pub.bytes_in_buffer = nbytes;
+            src->start_of_file = FALSE;
+
+            return TRUE;
+        }
+    }
+
     sail_status_t err = src->io->read(src->io->stream, src->buffer, 1, INPUT_BUF_SIZE, &nbytes);
 
     if (err != SAIL_OK || nbytes <= 0) {
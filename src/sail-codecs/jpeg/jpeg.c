@@ -63,6 +63,11 @@ struct jpeg_state {
     /* Extra scan line used as a buffer when reading CMYK/YCCK images. */
     bool extra_scan_line_needed_for_cmyk;
     void *extra_scan_line;
+
+    /* Offset in bytes of the decoded columns in scan lines cropped to the region of interest. */
+    size_t crop_offset;
+    /* Scan line to skip scan lines when libjpeg cannot skip them. */
+    void *scan_line_for_skipping;
 };
 
 static sail_status_t alloc_jpeg_state(struct jpeg_state **jpeg_state) {
@@ -81,6 +86,8 @@ static sail_status_t alloc_jpeg_state(struct jpeg_state **jpeg_state) {
     (*jpeg_state)->started_compress                = false;
     (*jpeg_state)->extra_scan_line_needed_for_cmyk = false;
     (*jpeg_state)->extra_scan_line                 = NULL;
+    (*jpeg_state)->crop_offset                     = 0;
+    (*jpeg_state)->scan_line_for_skipping          = NULL;
 
     return SAIL_OK;
 }
@@ -98,6 +105,7 @@ static void destroy_jpeg_state(struct jpeg_state *jpeg_state) {
     sail_destroy_write_options(jpeg_state->write_options);
 
     sail_free(jpeg_state->extra_scan_line);
+    sail_free(jpeg_state->scan_line_for_skipping);
 
     sail_free(jpeg_state);
 }
@@ -173,8 +181,23 @@ SAIL_EXPORT sail_status_t sail_codec_read_init_v4_jpeg(struct sail_io *io, const
     /* We don't want colormapped output. */
     jpeg_state->decompress_context->quantize_colors = false;
 
-    /* Launch decompression! */
-    jpeg_start_decompress(jpeg_state->decompress_context);
+    /* Reduce with DCT scaling. */
+    unsigned scale_denominator;
+    SAIL_TRY(sail_read_options_scale_denominator(jpeg_state->read_options,
+                                                    jpeg_state->decompress_context->image_width,
+                                                    jpeg_state->decompress_context->image_height,
+                                                    &scale_denominator));
+
+    jpeg_state->decompress_context->scale_num   = 1;
+    jpeg_state->decompress_context->scale_denom = scale_denominator;
+
+    if (jpeg_state->read_options->io_options & SAIL_IO_OPTION_PROBE) {
+        /* Only calculate the output dimensions without setting up the decompression pipeline. */
+        jpeg_calc_output_dimensions(jpeg_state->decompress_context);
+    } else {
+        /* Launch decompression! */
+        jpeg_start_decompress(jpeg_state->decompress_context);
+    }
 
     return SAIL_OK;
 }
@@ -217,6 +240,7 @@ SAIL_EXPORT sail_status_t sail_codec_read_seek_next_frame_v4_jpeg(void *state, s
     (*image)->height                     = jpeg_state->decompress_context->output_height;
     (*image)->bytes_per_line             = bytes_per_line;
     (*image)->source_image->pixel_format = jpeg_private_color_space_to_pixel_format(jpeg_state->decompress_context->jpeg_color_space);
+    (*image)->source_image->frames       = 1;
 
     if (jpeg_state->read_options->output_pixel_format == SAIL_PIXEL_FORMAT_SOURCE) {
         (*image)->pixel_format           = (*image)->source_image->pixel_format;
@@ -225,7 +249,7 @@ SAIL_EXPORT sail_status_t sail_codec_read_seek_next_frame_v4_jpeg(void *state, s
     }
 
     /* Extra scan line used as a buffer when reading CMYK/YCCK images. */
-    if (jpeg_state->extra_scan_line_needed_for_cmyk) {
+    if (jpeg_state->extra_scan_line_needed_for_cmyk && (jpeg_state->read_options->io_options & SAIL_IO_OPTION_PROBE) == 0) {
         unsigned src_bytes_per_line;
         SAIL_TRY(sail_bytes_per_line((*image)->width,
                                         (*image)->source_image->pixel_format,
@@ -271,10 +295,50 @@ SAIL_EXPORT sail_status_t sail_codec_read_seek_next_pass_v4_jpeg(void *state, st
     SAIL_CHECK_IO(io);
     SAIL_CHECK_IMAGE(image);
 
+#ifdef HAVE_JPEG_PARTIAL_DECOMPRESSION
+    struct jpeg_state *jpeg_state = (struct jpeg_state *)state;
+    const struct sail_read_options *read_options = jpeg_state->read_options;
+
+    if (jpeg_state->libjpeg_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    /*
+     * Decode only the columns covering the region of interest. libjpeg extends them to iMCU boundaries,
+     * so remember where they start. This is possible only before reading the first scan line.
+     *
+     * Fancy upsampling treats the cropped columns as the image edges. Decode one chroma sample more
+     * on both sides of the region, so its edge pixels are upsampled exactly like in the whole frame.
+     */
+    if (read_options->roi_width > 0 && read_options->roi_height > 0 && read_options->roi_x < image->width &&
+            jpeg_state->decompress_context->output_scanline == 0) {
+        if (setjmp(jpeg_state->error_context.setjmp_buffer) != 0) {
+            jpeg_state->libjpeg_error = true;
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+        }
+
+        const unsigned margin = (unsigned)jpeg_state->decompress_context->max_h_samp_factor;
+        const unsigned roi_end = (read_options->roi_width < image->width - read_options->roi_x)
+                                    ? read_options->roi_x + read_options->roi_width
+                                    : image->width;
+
+        JDIMENSION crop_x     = (read_options->roi_x > margin) ? read_options->roi_x - margin : 0;
+        JDIMENSION crop_width = ((margin < image->width - roi_end) ? roi_end + margin : image->width) - crop_x;
+
+        jpeg_crop_scanline(jpeg_state->decompress_context, &crop_x, &crop_width);
+
+        unsigned bits_per_pixel;
+        SAIL_TRY(sail_bits_per_pixel(image->pixel_format, &bits_per_pixel));
+
+        jpeg_state->crop_offset = (size_t)crop_x * bits_per_pixel / 8;
+    }
+#endif
+
     return SAIL_OK;
 }
 
-SAIL_EXPORT sail_status_t sail_codec_read_frame_v4_jpeg(void *state, struct sail_io *io, struct sail_image *image) {
+SAIL_EXPORT sail_status_t sail_codec_read_scan_lines_v4_jpeg(void *state, struct sail_io *io, const struct sail_image *image,
+                                                            void *scan_lines, unsigned scan_lines_count) {
 
     SAIL_CHECK_STATE_PTR(state);
     SAIL_CHECK_IO(io);
@@ -291,14 +355,33 @@ SAIL_EXPORT sail_status_t sail_codec_read_frame_v4_jpeg(void *state, struct sail
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
     }
 
-    for (unsigned row = 0; row < image->height; row++) {
-        unsigned char *scanline = (unsigned char *)image->pixels + row * image->bytes_per_line;
+    /* Skip scan lines. */
+    if (scan_lines == NULL) {
+#ifdef HAVE_JPEG_PARTIAL_DECOMPRESSION
+        (void)jpeg_skip_scanlines(jpeg_state->decompress_context, scan_lines_count);
+#else
+        if (jpeg_state->scan_line_for_skipping == NULL) {
+            SAIL_TRY(sail_malloc((size_t)jpeg_state->decompress_context->output_width * jpeg_state->decompress_context->output_components,
+                                    &jpeg_state->scan_line_for_skipping));
+        }
+
+        for (unsigned row = 0; row < scan_lines_count; row++) {
+            JSAMPROW samprow = (JSAMPROW)jpeg_state->scan_line_for_skipping;
+            (void)jpeg_read_scanlines(jpeg_state->decompress_context, &samprow, 1);
+        }
+#endif
+        return SAIL_OK;
+    }
+
+    for (unsigned row = 0; row < scan_lines_count; row++) {
+        unsigned char *scanline = (unsigned char *)scan_lines + (size_t)row * image->bytes_per_line + jpeg_state->crop_offset;
 
         /* Convert the CMYK image to BPP32-RGBA/BPP32-BGRA/etc. */
         if (jpeg_state->extra_scan_line_needed_for_cmyk) {
             JSAMPROW samprow = (JSAMPROW)jpeg_state->extra_scan_line;
             (void)jpeg_read_scanlines(jpeg_state->decompress_context, &samprow, 1);
-            SAIL_TRY(jpeg_private_convert_cmyk(jpeg_state->extra_scan_line, scanline, image->width, image->pixel_format));
+            SAIL_TRY(jpeg_private_convert_cmyk(jpeg_state->extra_scan_line, scanline,
+                                                jpeg_state->decompress_context->output_width, image->pixel_format));
         } else {
             JSAMPROW samprow = (JSAMPROW)scanline;
             (void)jpeg_read_scanlines(jpeg_state->decompress_context, &samprow, 1);
@@ -308,6 +391,15 @@ SAIL_EXPORT sail_status_t sail_codec_read_frame_v4_jpeg(void *state, struct sail
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_read_frame_v4_jpeg(void *state, struct sail_io *io, struct sail_image *image) {
+
+    SAIL_CHECK_IMAGE(image);
+
+    SAIL_TRY(sail_codec_read_scan_lines_v4_jpeg(state, io, image, image->pixels, image->height));
+
+    return SAIL_OK;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_read_finish_v4_jpeg(void **state, struct sail_io *io) {
 
     SAIL_CHECK_STATE_PTR(state);
@@ -492,7 +584,7 @@ SAIL_EXPORT sail_status_t sail_codec_write_frame_v4_jpeg(void *state, struct sai
     }
 
     for (unsigned row = 0; row < image->height; row++) {
-        JSAMPROW samprow = (JSAMPROW)((const unsigned char *)image->pixels + row * image->bytes_per_line);
+        JSAMPROW samprow = (JSAMPROW)((const unsigned char *)image->pixels + (size_t)row * image->bytes_per_line);
         jpeg_write_scanlines(jpeg_state->compress_context, &samprow, 1);
     }
 
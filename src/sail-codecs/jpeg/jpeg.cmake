@@ -64,4 +64,29 @@ macro(sail_codec_post_add)
     if (HAVE_JPEG_JCS_EXT)
         target_compile_definitions(${TARGET} PRIVATE HAVE_JPEG_JCS_EXT)
     endif()
+
+    # Check for partial image decompression functions that were added in libjpeg-turbo-1.5
+    #
+    cmake_push_check_state(RESET)
+        set(CMAKE_REQUIRED_INCLUDES ${sail_jpeg_include_dirs})
+        set(CMAKE_REQUIRED_LIBRARIES ${sail_jpeg_libs})
+
+        check_c_source_compiles(
+            "
+            #include <stdio.h>
+            #include <jpeglib.h>
+
+            int main(int argc, char *argv[]) {
+                jpeg_crop_scanline(NULL, NULL, NULL);
+                jpeg_skip_scanlines(NULL, 0);
+                return 0;
+            }
+        "
+        HAVE_JPEG_PARTIAL_DECOMPRESSION
+        )
+    cmake_pop_check_state()
+
+    if (HAVE_JPEG_PARTIAL_DECOMPRESSION)
+        target_compile_definitions(${TARGET} PRIVATE HAVE_JPEG_PARTIAL_DECOMPRESSION)
+    endif()
 endmacro()
@@ -63,6 +63,8 @@ struct png_state {
     bool frame_written;
     int frames;
     int current_frame;
+    /* Index of the next scan line to read with sail_codec_read_scan_lines_v4_png(). */
+    unsigned next_scan_line;
 
     /* APNG-specific. */
 #ifdef PNG_APNG_SUPPORTED
@@ -106,6 +108,7 @@ static sail_status_t alloc_png_state(struct png_state **png_state) {
     (*png_state)->frame_written  = false;
     (*png_state)->frames         = 0;
     (*png_state)->current_frame  = 0;
+    (*png_state)->next_scan_line = 0;
 
     /* APNG-specific. */
 #ifdef PNG_APNG_SUPPORTED
@@ -154,6 +157,54 @@ static void destroy_png_state(struct png_state *png_state) {
     sail_free(png_state);
 }
 
+/* Reads the specified scan line of the current frame. */
+static sail_status_t read_scan_line(struct png_state *png_state, unsigned row, unsigned char *scanline) {
+
+#ifdef PNG_APNG_SUPPORTED
+    if (png_state->is_apng) {
+        memcpy(scanline, png_state->prev[row], png_state->first_image->width * png_state->bytes_per_pixel);
+
+        if (row >= png_state->next_frame_y_offset && row < png_state->next_frame_y_offset + png_state->next_frame_height) {
+            png_read_row(png_state->png_ptr, (png_bytep)png_state->temp_scanline, NULL);
+
+            /* Copy all pixel values including alpha. */
+            if (png_state->current_frame == 1 || png_state->next_frame_blend_op == PNG_BLEND_OP_SOURCE) {
+                SAIL_TRY(png_private_blend_source(scanline,
+                                        png_state->next_frame_x_offset,
+                                        png_state->temp_scanline,
+                                        png_state->next_frame_width,
+                                        png_state->bytes_per_pixel));
+            } else { /* PNG_BLEND_OP_OVER */
+                SAIL_TRY(png_private_blend_over(scanline,
+                                    png_state->next_frame_x_offset,
+                                    png_state->temp_scanline,
+                                    png_state->next_frame_width,
+                                    png_state->bytes_per_pixel));
+            }
+
+            if (png_state->next_frame_dispose_op == PNG_DISPOSE_OP_BACKGROUND) {
+                memset(png_state->prev[row] + png_state->next_frame_x_offset * png_state->bytes_per_pixel,
+                        0,
+                        png_state->next_frame_width * png_state->bytes_per_pixel);
+            } else if (png_state->next_frame_dispose_op == PNG_DISPOSE_OP_NONE) {
+                memcpy(png_state->prev[row] + png_state->next_frame_x_offset * png_state->bytes_per_pixel,
+                        scanline,
+                        png_state->next_frame_width * png_state->bytes_per_pixel);
+            } else { /* PNG_DISPOSE_OP_PREVIOUS */
+            }
+        }
+
+        return SAIL_OK;
+    }
+#else
+    (void)row;
+#endif
+
+    png_read_row(png_state->png_ptr, scanline, NULL);
+
+    return SAIL_OK;
+}
+
 /*
  * Decoding functions.
  */
@@ -287,8 +338,12 @@ SAIL_EXPORT sail_status_t sail_codec_read_init_v4_png(struct sail_io *io, const
     SAIL_TRY(sail_bytes_per_line(png_state->first_image->width,
                                  png_state->first_image->pixel_format,
                                  &png_state->first_image->bytes_per_line));
+    const bool probe = png_state->read_options->io_options & SAIL_IO_OPTION_PROBE;
+
     /* Apply requested transformations. */
-    png_read_update_info(png_state->png_ptr, png_state->info_ptr);
+    if (!probe) {
+        png_read_update_info(png_state->png_ptr, png_state->info_ptr);
+    }
 
 #ifdef PNG_APNG_SUPPORTED
     unsigned bits_per_pixel;
@@ -302,11 +357,19 @@ SAIL_EXPORT sail_status_t sail_codec_read_init_v4_png(struct sail_io *io, const
         SAIL_LOG_AND_RETURN(SAIL_ERROR_NO_MORE_FRAMES);
     }
 
-    if (png_state->is_apng) {
+    if (png_state->is_apng && !probe) {
         SAIL_TRY(png_private_alloc_rows(&png_state->prev, png_state->first_image->bytes_per_line, png_state->first_image->height));
     }
+
+    /* A hidden first frame is never returned. */
+    png_state->first_image->source_image->frames = png_state->frames;
+
+    if (png_state->is_apng && png_get_first_frame_is_hidden(png_state->png_ptr, png_state->info_ptr)) {
+        png_state->first_image->source_image->frames--;
+    }
 #else
     png_state->frames = 1;
+    png_state->first_image->source_image->frames = 1;
 #endif
 
     png_state->first_image->source_image->pixel_format = png_private_png_color_type_to_pixel_format(png_state->color_type, png_state->bit_depth);
@@ -326,7 +389,7 @@ SAIL_EXPORT sail_status_t sail_codec_read_init_v4_png(struct sail_io *io, const
     }
 
 #ifdef PNG_APNG_SUPPORTED
-    if (png_state->is_apng) {
+    if (png_state->is_apng && !probe) {
         SAIL_TRY(sail_malloc(png_state->first_image->width * png_state->bytes_per_pixel, &png_state->temp_scanline));
     }
 #endif
@@ -375,6 +438,13 @@ SAIL_EXPORT sail_status_t sail_codec_read_seek_next_frame_v4_png(void *state, st
     if (png_state->is_apng) {
         (*image)->animated = true;
 
+        /* Don't read frame chunks when probing. */
+        if (png_state->read_options->io_options & SAIL_IO_OPTION_PROBE) {
+            (*image)->animated = (*image)->source_image->frames > 1;
+            png_state->current_frame++;
+            return SAIL_OK;
+        }
+
         /* APNG feature: a hidden frame. */
         if (!png_state->skipped_hidden && png_get_first_frame_is_hidden(png_state->png_ptr, png_state->info_ptr)) {
             SAIL_LOG_DEBUG("PNG: Skipping hidden frame");
@@ -447,6 +517,8 @@ SAIL_EXPORT sail_status_t sail_codec_read_seek_next_pass_v4_png(void *state, str
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
     }
 
+    png_state->next_scan_line = 0;
+
     return SAIL_OK;
 }
 
@@ -467,53 +539,59 @@ SAIL_EXPORT sail_status_t sail_codec_read_frame_v4_png(void *state, struct sail_
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
     }
 
+    for (unsigned row = 0; row < image->height; row++) {
+        SAIL_TRY(read_scan_line(png_state, row, (unsigned char *)image->pixels + (size_t)row * image->bytes_per_line));
+    }
+
+    return SAIL_OK;
+}
+
+SAIL_EXPORT sail_status_t sail_codec_read_scan_lines_v4_png(void *state, struct sail_io *io, const struct sail_image *image,
+                                                           void *scan_lines, unsigned scan_lines_count) {
+
+    SAIL_CHECK_STATE_PTR(state);
+    SAIL_CHECK_IO(io);
+    SAIL_CHECK_IMAGE(image);
+
+    struct png_state *png_state = (struct png_state *)state;
+
+    if (png_state->libpng_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    if (setjmp(png_jmpbuf(png_state->png_ptr))) {
+        png_state->libpng_error = true;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    /* Skip scan lines. libpng still decompresses them, but nothing is copied. */
+    if (scan_lines == NULL) {
+        for (unsigned row = 0; row < scan_lines_count; row++) {
 #ifdef PNG_APNG_SUPPORTED
-    if (png_state->is_apng) {
-        for (unsigned row = 0; row < image->height; row++) {
-            unsigned char *scanline = (unsigned char *)image->pixels + row * image->bytes_per_line;
-
-            memcpy(scanline, png_state->prev[row], png_state->first_image->width * png_state->bytes_per_pixel);
-
-            if (row >= png_state->next_frame_y_offset && row < png_state->next_frame_y_offset + png_state->next_frame_height) {
-                png_read_row(png_state->png_ptr, (png_bytep)png_state->temp_scanline, NULL);
-
-                /* Copy all pixel values including alpha. */
-                if (png_state->current_frame == 1 || png_state->next_frame_blend_op == PNG_BLEND_OP_SOURCE) {
-                    SAIL_TRY(png_private_blend_source(scanline,
-                                            png_state->next_frame_x_offset,
-                                            png_state->temp_scanline,
-                                            png_state->next_frame_width,
-                                            png_state->bytes_per_pixel));
-                } else { /* PNG_BLEND_OP_OVER */
-                    SAIL_TRY(png_private_blend_over(scanline,
-                                        png_state->next_frame_x_offset,
-                                        png_state->temp_scanline,
-                                        png_state->next_frame_width,
-                                        png_state->bytes_per_pixel));
+            /* Skipped scan lines are still needed to compose the next frames. */
+            if (png_state->is_apng) {
+                if (png_state->scanline_for_skipping == NULL) {
+                    SAIL_TRY(sail_malloc((size_t)png_state->first_image->width * png_state->bytes_per_pixel,
+                                            &png_state->scanline_for_skipping));
                 }
 
-                if (png_state->next_frame_dispose_op == PNG_DISPOSE_OP_BACKGROUND) {
-                    memset(png_state->prev[row] + png_state->next_frame_x_offset * png_state->bytes_per_pixel,
-                            0,
-                            png_state->next_frame_width * png_state->bytes_per_pixel);
-                } else if (png_state->next_frame_dispose_op == PNG_DISPOSE_OP_NONE) {
-                    memcpy(png_state->prev[row] + png_state->next_frame_x_offset * png_state->bytes_per_pixel,
-                            scanline,
-                            png_state->next_frame_width * png_state->bytes_per_pixel);
-                } else { /* PNG_DISPOSE_OP_PREVIOUS */
-                }
+                SAIL_TRY(read_scan_line(png_state, png_state->next_scan_line, png_state->scanline_for_skipping));
+            } else {
+                png_read_row(png_state->png_ptr, NULL, NULL);
             }
+#else
+            png_read_row(png_state->png_ptr, NULL, NULL);
+#endif
+            png_state->next_scan_line++;
         }
-    } else {
-        for (unsigned row = 0; row < image->height; row++) {
-            png_read_row(png_state->png_ptr, (unsigned char *)image->pixels + row * image->bytes_per_line, NULL);
-        }
+
+        return SAIL_OK;
     }
-#else
-    for (unsigned row = 0; row < image->height; row++) {
-        png_read_row(png_state->png_ptr, (unsigned char *)image->pixels + row * image->bytes_per_line, NULL);
+
+    for (unsigned row = 0; row < scan_lines_count; row++) {
+        SAIL_TRY(read_scan_line(png_state, png_state->next_scan_line, (unsigned char *)scan_lines + (size_t)row * image->bytes_per_line));
+        png_state->next_scan_line++;
     }
-#endif
 
     return SAIL_OK;
 }
@@ -733,7 +811,7 @@ SAIL_EXPORT sail_status_t sail_codec_write_frame_v4_png(void *state, struct sail
     }
 
     for (unsigned row = 0; row < image->height; row++) {
-        png_write_row(png_state->png_ptr, (const unsigned char *)image->pixels + row * image->bytes_per_line);
+        png_write_row(png_state->png_ptr, (const unsigned char *)image->pixels + (size_t)row * image->bytes_per_line);
     }
 
     return SAIL_OK;
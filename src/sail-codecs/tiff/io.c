@@ -23,6 +23,9 @@
     SOFTWARE.
 */
 
+#include <stdint.h>
+#include <stdio.h>
+
 #include "sail-common.h"
 
 #include "io.h"
@@ -61,15 +64,15 @@ toff_t tiff_private_my_seek_proc(thandle_t client_data, toff_t offset, int whenc
 
     struct sail_io *io = (struct sail_io *)client_data;
 
-    sail_status_t err = io->seek(io->stream, (long)offset, whence);
+    sail_status_t err = sail_io_seek(io, (int64_t)offset, whence);
 
     if (err != SAIL_OK) {
         TIFFError(NULL, "Failed to seek the I/O stream: %d", err);
         return (toff_t)-1;
     }
 
-    size_t new_offset;
-    err = io->tell(io->stream, &new_offset);
+    uint64_t new_offset;
+    err = sail_io_tell(io, &new_offset);
 
     if (err != SAIL_OK) {
         TIFFError(NULL, "Failed to get the current position of the I/O stream: %d", err);
@@ -92,3 +95,72 @@ toff_t tiff_private_my_dummy_size_proc(thandle_t client_data) {
 
     return (toff_t)-1;
 }
+
+toff_t tiff_private_my_size_proc(thandle_t client_data) {
+
+    struct sail_io *io = (struct sail_io *)client_data;
+    uint64_t offset;
+    uint64_t size;
+
+    if (sail_io_tell(io, &offset) != SAIL_OK) {
+        return (toff_t)-1;
+    }
+
+    if (sail_io_seek(io, 0, SEEK_END) != SAIL_OK || sail_io_tell(io, &size) != SAIL_OK) {
+        size = (uint64_t)-1;
+    }
+
+    if (sail_io_seek(io, (int64_t)offset, SEEK_SET) != SAIL_OK) {
+        return (toff_t)-1;
+    }
+
+    return (toff_t)size;
+}
+
+int tiff_private_my_map_proc(thandle_t client_data, void **base, toff_t *size) {
+
+    struct sail_io *io = (struct sail_io *)client_data;
+
+    /* Only contiguous sources like memory buffers and mapped files could be mapped. */
+    if (io->borrow == NULL) {
+        return 0;
+    }
+
+    uint64_t offset;
+    uint64_t stream_size;
+
+    if (sail_io_tell(io, &offset) != SAIL_OK
+            || sail_io_seek(io, 0, SEEK_END) != SAIL_OK
+            || sail_io_tell(io, &stream_size) != SAIL_OK
+            || sail_io_seek(io, 0, SEEK_SET) != SAIL_OK) {
+        return 0;
+    }
+
+    /* Borrow the whole stream. The borrowed memory stays valid until the I/O object is closed. */
+    const void *data;
+    size_t data_size;
+
+    sail_status_t err = io->borrow(io->stream, SIZE_MAX, &data, &data_size);
+
+    if (sail_io_seek(io, (int64_t)offset, SEEK_SET) != SAIL_OK || err != SAIL_OK) {
+        return 0;
+    }
+
+    /* Segmented sources borrow less than the whole stream and couldn't be mapped. */
+    if (data_size != stream_size) {
+        return 0;
+    }
+
+    *base = (void *)data;
+    *size = (toff_t)data_size;
+
+    return 1;
+}
+
+void tiff_private_my_unmap_proc(thandle_t client_data, void *base, toff_t size) {
+
+    /* The borrowed memory is owned by the I/O object. */
+    (void)client_data;
+    (void)base;
+    (void)size;
+}
@@ -40,4 +40,10 @@ SAIL_HIDDEN int tiff_private_my_dummy_close_proc(thandle_t client_data);
 
 SAIL_HIDDEN toff_t tiff_private_my_dummy_size_proc(thandle_t client_data);
 
+SAIL_HIDDEN toff_t tiff_private_my_size_proc(thandle_t client_data);
+
+SAIL_HIDDEN int tiff_private_my_map_proc(thandle_t client_data, void **base, toff_t *size);
+
+SAIL_HIDDEN void tiff_private_my_unmap_proc(thandle_t client_data, void *base, toff_t size);
+
 #endif
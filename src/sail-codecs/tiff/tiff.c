@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <tiffio.h>
 
@@ -86,6 +87,39 @@ static void destroy_tiff_state(struct tiff_state *tiff_state) {
     sail_free(tiff_state);
 }
 
+/*
+ * Converts scan lines decoded by libtiff into the requested pixel format, and spreads them out
+ * to honor the image bytes per line.
+ */
+static void convert_scan_lines(const struct tiff_state *tiff_state, const struct sail_image *image, void *scan_lines, unsigned scan_lines_count) {
+
+    /* Swap colors. */
+    if (tiff_state->read_options->output_pixel_format == SAIL_PIXEL_FORMAT_BPP32_BGRA) {
+        unsigned char *pixels = scan_lines;
+        const size_t pixels_count = (size_t)image->width * scan_lines_count;
+        unsigned char tmp;
+
+        for (size_t i = 0; i < pixels_count; i++, pixels += 4) {
+            tmp = *pixels;
+            *pixels = *(pixels+2);
+            *(pixels+2) = tmp;
+        }
+    }
+
+    /* libtiff writes tightly packed scan lines. Spread them out to honor custom bytes per line. */
+    const size_t tight_bytes_per_line = (size_t)image->width * 4;
+
+    if (image->bytes_per_line != tight_bytes_per_line) {
+        unsigned char *pixels = scan_lines;
+
+        for (unsigned row = scan_lines_count; row > 1; row--) {
+            memmove(pixels + (size_t)(row-1) * image->bytes_per_line,
+                    pixels + (size_t)(row-1) * tight_bytes_per_line,
+                    tight_bytes_per_line);
+        }
+    }
+}
+
 /*
  * Decoding functions.
  */
@@ -117,17 +151,20 @@ SAIL_EXPORT sail_status_t sail_codec_read_init_v4_tiff(struct sail_io *io, const
      * 'r': reading operation
      * 'h': read TIFF header only
      * 'm': disable use of memory-mapped files
+     *
+     * Contiguous sources like memory buffers are handed to libtiff as memory-mapped files
+     * so it reads strips and tiles directly from them without copying.
      */
     tiff_state->tiff = TIFFClientOpen("tiff-sail-codec",
-                                      "rhm",
+                                      (io->borrow == NULL) ? "rhm" : "rh",
                                       io,
                                       tiff_private_my_read_proc,
                                       tiff_private_my_write_proc,
                                       tiff_private_my_seek_proc,
                                       tiff_private_my_dummy_close_proc,
-                                      tiff_private_my_dummy_size_proc,
-                                      /* map */ NULL,
-                                      /* unmap */ NULL);
+                                      tiff_private_my_size_proc,
+                                      tiff_private_my_map_proc,
+                                      tiff_private_my_unmap_proc);
 
     if (tiff_state->tiff == NULL) {
         tiff_state->libtiff_error = true;
@@ -159,15 +196,27 @@ SAIL_EXPORT sail_status_t sail_codec_read_seek_next_frame_v4_tiff(void *state, s
         SAIL_LOG_AND_RETURN(SAIL_ERROR_NO_MORE_FRAMES);
     }
 
-    /* Start reading the next image. */
-    char emsg[1024];
-    if (!TIFFRGBAImageBegin(&tiff_state->image, tiff_state->tiff, /* stop */ 1, emsg)) {
-        SAIL_LOG_ERROR("TIFF: %s", emsg);
-        sail_destroy_image(*image);
-        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    const bool probe = tiff_state->read_options->io_options & SAIL_IO_OPTION_PROBE;
+
+    /* Start reading the next image. Decoding tables are not needed when probing. */
+    if (probe) {
+        TIFFGetFieldDefaulted(tiff_state->tiff, TIFFTAG_BITSPERSAMPLE,   &tiff_state->image.bitspersample);
+        TIFFGetFieldDefaulted(tiff_state->tiff, TIFFTAG_SAMPLESPERPIXEL, &tiff_state->image.samplesperpixel);
+    } else {
+        char emsg[1024];
+        if (!TIFFRGBAImageBegin(&tiff_state->image, tiff_state->tiff, /* stop */ 1, emsg)) {
+            SAIL_LOG_ERROR("TIFF: %s", emsg);
+            sail_destroy_image(*image);
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+        }
+
+        tiff_state->image.req_orientation = ORIENTATION_TOPLEFT;
     }
 
-    tiff_state->image.req_orientation = ORIENTATION_TOPLEFT;
+    /* Count pages once. This walks all the directories, so the number of frames is left 0 when probing. */
+    if (!probe && tiff_state->current_frame == 1) {
+        (*image)->source_image->frames = TIFFNumberOfDirectories(tiff_state->tiff);
+    }
 
     /* Fill the image properties. */
     if (!TIFFGetField(tiff_state->tiff, TIFFTAG_IMAGEWIDTH,  &(*image)->width) || !TIFFGetField(tiff_state->tiff, TIFFTAG_IMAGELENGTH, &(*image)->height)) {
@@ -238,6 +287,10 @@ SAIL_EXPORT sail_status_t sail_codec_read_seek_next_pass_v4_tiff(void *state, st
     SAIL_CHECK_IO(io);
     SAIL_CHECK_IMAGE(image);
 
+    struct tiff_state *tiff_state = (struct tiff_state *)state;
+
+    tiff_state->line = 0;
+
     return SAIL_OK;
 }
 
@@ -259,17 +312,39 @@ SAIL_EXPORT sail_status_t sail_codec_read_frame_v4_tiff(void *state, struct sail
 
     TIFFRGBAImageEnd(&tiff_state->image);
 
-    /* Swap colors. */
-    if (tiff_state->read_options->output_pixel_format == SAIL_PIXEL_FORMAT_BPP32_BGRA) {
-        unsigned char *pixels = image->pixels;
-        const unsigned pixels_count = image->width * image->height;
-        unsigned char tmp;
+    convert_scan_lines(tiff_state, image, image->pixels, image->height);
 
-        for (unsigned i = 0; i < pixels_count; i++, pixels += 4) {
-            tmp = *pixels;
-            *pixels = *(pixels+2);
-            *(pixels+2) = tmp;
+    return SAIL_OK;
+}
+
+SAIL_EXPORT sail_status_t sail_codec_read_scan_lines_v4_tiff(void *state, struct sail_io *io, const struct sail_image *image,
+                                                            void *scan_lines, unsigned scan_lines_count) {
+
+    SAIL_CHECK_STATE_PTR(state);
+    SAIL_CHECK_IO(io);
+    SAIL_CHECK_IMAGE(image);
+
+    struct tiff_state *tiff_state = (struct tiff_state *)state;
+
+    if (tiff_state->libtiff_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    /* libtiff decodes only the strips or tiles covering the requested band, so skipped scan lines are never decoded. */
+    if (scan_lines != NULL) {
+        tiff_state->image.row_offset = tiff_state->line;
+
+        if (!TIFFRGBAImageGet(&tiff_state->image, scan_lines, image->width, scan_lines_count)) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
         }
+
+        convert_scan_lines(tiff_state, image, scan_lines, scan_lines_count);
+    }
+
+    tiff_state->line += scan_lines_count;
+
+    if ((unsigned)tiff_state->line == image->height) {
+        TIFFRGBAImageEnd(&tiff_state->image);
     }
 
     return SAIL_OK;
@@ -415,7 +490,7 @@ SAIL_EXPORT sail_status_t sail_codec_write_frame_v4_tiff(void *state, struct sai
     }
 
     for (unsigned row = 0; row < image->height; row++) {
-        if (TIFFWriteScanline(tiff_state->tiff, (unsigned char *)image->pixels + row * image->bytes_per_line, tiff_state->line++, 0) < 0) {
+        if (TIFFWriteScanline(tiff_state->tiff, (unsigned char *)image->pixels + (size_t)row * image->bytes_per_line, tiff_state->line++, 0) < 0) {
             SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
         }
     }
@@ -0,0 +1,313 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+#include "munit.h"
+
+/*
+ * Counting allocator.
+ */
+struct counters {
+    unsigned mallocs;
+    unsigned reallocs;
+    unsigned frees;
+};
+
+static void* counting_malloc(void *user_data, size_t size) {
+    ((struct counters *)user_data)->mallocs++;
+    return malloc(size);
+}
+
+static void* counting_realloc(void *user_data, void *ptr, size_t size) {
+    ((struct counters *)user_data)->reallocs++;
+    return realloc(ptr, size);
+}
+
+static void counting_free(void *user_data, void *ptr) {
+    ((struct counters *)user_data)->frees++;
+    free(ptr);
+}
+
+/*
+ * Arena.
+ */
+static MunitResult test_arena_malloc(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct sail_arena *arena;
+    munit_assert(sail_alloc_arena(1024, &arena) == SAIL_OK);
+
+    void *ptr1;
+    void *ptr2;
+    munit_assert(sail_arena_malloc(arena, 10, &ptr1) == SAIL_OK);
+    munit_assert(sail_arena_malloc(arena, 20, &ptr2) == SAIL_OK);
+
+    munit_assert_size((uintptr_t)ptr1 % 16, ==, 0);
+    munit_assert_size((uintptr_t)ptr2 % 16, ==, 0);
+    munit_assert_ptr_not_equal(ptr1, ptr2);
+
+    memset(ptr1, 1, 10);
+    memset(ptr2, 2, 20);
+
+    munit_assert_true(sail_arena_owns(arena, ptr1));
+    munit_assert_true(sail_arena_owns(arena, ptr2));
+
+    /* Big blocks get dedicated chunks. */
+    void *big;
+    munit_assert(sail_arena_malloc(arena, 10000, &big) == SAIL_OK);
+    memset(big, 3, 10000);
+    munit_assert_true(sail_arena_owns(arena, big));
+
+    /* Small blocks still come from the first chunk. */
+    void *ptr3;
+    munit_assert(sail_arena_malloc(arena, 30, &ptr3) == SAIL_OK);
+    munit_assert_size((uintptr_t)ptr3 - (uintptr_t)ptr2, <, 1024);
+
+    int local;
+    munit_assert_false(sail_arena_owns(arena, &local));
+    munit_assert_false(sail_arena_owns(arena, NULL));
+
+    sail_destroy_arena(arena);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_arena_realloc(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct sail_arena *arena;
+    munit_assert(sail_alloc_arena(1024, &arena) == SAIL_OK);
+
+    void *ptr1;
+    munit_assert(sail_arena_malloc(arena, 16, &ptr1) == SAIL_OK);
+    memset(ptr1, 1, 16);
+
+    /* The last block grows in place. */
+    void *ptr = ptr1;
+    munit_assert(sail_arena_realloc(arena, 100, &ptr) == SAIL_OK);
+    munit_assert_ptr_equal(ptr, ptr1);
+
+    /* Other blocks are copied. */
+    void *ptr2;
+    munit_assert(sail_arena_malloc(arena, 16, &ptr2) == SAIL_OK);
+
+    munit_assert(sail_arena_realloc(arena, 200, &ptr) == SAIL_OK);
+    munit_assert_ptr_not_equal(ptr, ptr1);
+
+    for (unsigned i = 0; i < 16; i++) {
+        munit_assert_uint8(((unsigned char *)ptr)[i], ==, 1);
+    }
+
+    sail_destroy_arena(arena);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_thread_arena(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    void *heap_ptr;
+    munit_assert(sail_malloc(8, &heap_ptr) == SAIL_OK);
+
+    struct sail_arena *arena;
+    munit_assert(sail_alloc_arena(0, &arena) == SAIL_OK);
+
+    munit_assert_null(sail_set_thread_arena(arena));
+    munit_assert_ptr_equal(sail_thread_arena(), arena);
+
+    /* Allocated from the arena. Freeing is a no-op. */
+    void *ptr;
+    munit_assert(sail_malloc(8, &ptr) == SAIL_OK);
+    munit_assert_true(sail_arena_owns(arena, ptr));
+    sail_free(ptr);
+
+    munit_assert(sail_calloc(4, 4, &ptr) == SAIL_OK);
+    munit_assert_true(sail_arena_owns(arena, ptr));
+
+    for (unsigned i = 0; i < 16; i++) {
+        munit_assert_uint8(((unsigned char *)ptr)[i], ==, 0);
+    }
+
+    /* NULL and heap blocks are never moved into the arena. */
+    void *realloc_ptr = NULL;
+    munit_assert(sail_realloc(8, &realloc_ptr) == SAIL_OK);
+    munit_assert_false(sail_arena_owns(arena, realloc_ptr));
+    sail_free(realloc_ptr);
+
+    munit_assert(sail_realloc(16, &heap_ptr) == SAIL_OK);
+    munit_assert_false(sail_arena_owns(arena, heap_ptr));
+    sail_free(heap_ptr);
+
+    munit_assert_ptr_equal(sail_set_thread_arena(NULL), arena);
+
+    sail_destroy_arena(arena);
+
+    return MUNIT_OK;
+}
+
+/*
+ * Allocator.
+ */
+static MunitResult test_allocator(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct counters counters = { 0, 0, 0 };
+    struct sail_allocator allocator = { counting_malloc, counting_realloc, counting_free, &counters };
+
+    struct sail_allocator incomplete_allocator = { counting_malloc, NULL, counting_free, &counters };
+    munit_assert(sail_set_allocator(&incomplete_allocator) == SAIL_ERROR_INVALID_ARGUMENT);
+
+    munit_assert(sail_set_allocator(&allocator) == SAIL_OK);
+
+    void *ptr;
+    munit_assert(sail_malloc(8, &ptr) == SAIL_OK);
+    munit_assert(sail_realloc(16, &ptr) == SAIL_OK);
+    sail_free(ptr);
+
+    munit_assert(sail_calloc(2, 8, &ptr) == SAIL_OK);
+    sail_free(ptr);
+
+    munit_assert_uint(counters.mallocs,  ==, 2);
+    munit_assert_uint(counters.reallocs, ==, 1);
+    munit_assert_uint(counters.frees,    ==, 2);
+
+    /* Arena chunks are allocated with the allocator too. */
+    struct sail_arena *arena;
+    munit_assert(sail_alloc_arena(0, &arena) == SAIL_OK);
+    munit_assert(sail_arena_malloc(arena, 8, &ptr) == SAIL_OK);
+    munit_assert(sail_arena_malloc(arena, 8, &ptr) == SAIL_OK);
+    sail_destroy_arena(arena);
+
+    munit_assert_uint(counters.mallocs, ==, 4);
+    munit_assert_uint(counters.frees,   ==, 4);
+
+    munit_assert(sail_set_allocator(NULL) == SAIL_OK);
+
+    munit_assert(sail_malloc(8, &ptr) == SAIL_OK);
+    sail_free(ptr);
+
+    munit_assert_uint(counters.mallocs, ==, 4);
+
+    return MUNIT_OK;
+}
+
+/*
+ * Pixel pool.
+ */
+static MunitResult test_pixel_pool(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct sail_pixel_pool_statistics statistics;
+
+    /* Disabled pool allocates plain buffers. */
+    void *pixels;
+    size_t capacity;
+    munit_assert(sail_acquire_pooled_pixels(100, &pixels, &capacity) == SAIL_OK);
+    munit_assert_size(capacity, ==, 0);
+    sail_release_pooled_pixels(pixels, capacity);
+
+    munit_assert(sail_enable_pixel_pool(0) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert(sail_enable_pixel_pool(1000000) == SAIL_OK);
+
+    /* Size classes are spaced by 25% of a power of two. */
+    munit_assert(sail_acquire_pooled_pixels(100, &pixels, &capacity) == SAIL_OK);
+    munit_assert_size(capacity, ==, 4096);
+    sail_release_pooled_pixels(pixels, capacity);
+
+    munit_assert(sail_acquire_pooled_pixels(70000, &pixels, &capacity) == SAIL_OK);
+    munit_assert_size(capacity, ==, 81920);
+
+    /* Frames of a close size reuse the released buffer. */
+    void *first_pixels = pixels;
+    sail_release_pooled_pixels(pixels, capacity);
+
+    munit_assert(sail_acquire_pooled_pixels(80000, &pixels, &capacity) == SAIL_OK);
+    munit_assert_ptr_equal(pixels, first_pixels);
+    munit_assert_size(capacity, ==, 81920);
+
+    munit_assert(sail_pixel_pool_statistics(&statistics) == SAIL_OK);
+    munit_assert_uint64(statistics.hits,     ==, 1);
+    munit_assert_uint64(statistics.misses,   ==, 2);
+    munit_assert_uint64(statistics.releases, ==, 2);
+    munit_assert_size(statistics.cached_bytes, ==, 4096);
+
+    /* Buffers over the memory limit are freed. */
+    munit_assert(sail_enable_pixel_pool(50000) == SAIL_OK);
+    sail_release_pooled_pixels(pixels, capacity);
+
+    munit_assert(sail_pixel_pool_statistics(&statistics) == SAIL_OK);
+    munit_assert_uint64(statistics.evictions, ==, 1);
+    munit_assert_size(statistics.cached_bytes, ==, 4096);
+
+    /* Images return pooled pixels on destruction. */
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+    munit_assert(sail_acquire_pooled_pixels(4000, &image->pixels, &image->pixels_pool_size) == SAIL_OK);
+    sail_destroy_image(image);
+
+    munit_assert(sail_pixel_pool_statistics(&statistics) == SAIL_OK);
+    munit_assert_uint64(statistics.hits,     ==, 1);
+    munit_assert_uint64(statistics.releases, ==, 1);
+    munit_assert_size(statistics.cached_bytes, ==, 4096);
+
+    sail_disable_pixel_pool();
+
+    munit_assert(sail_pixel_pool_statistics(&statistics) == SAIL_OK);
+    munit_assert_size(statistics.cached_bytes, ==, 0);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/arena-malloc",  test_arena_malloc,  NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/arena-realloc", test_arena_realloc, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/thread-arena",  test_thread_arena,  NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/allocator",     test_allocator,     NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/pixel-pool",    test_pixel_pool,    NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/allocator",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
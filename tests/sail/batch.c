@@ -0,0 +1,442 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sail.h"
+
+#ifdef SAIL_WIN32
+    #include <windows.h>
+#endif
+
+#include "munit.h"
+
+#include "images.h"
+
+#define TEST_WIDTH  123
+#define TEST_HEIGHT 77
+
+/* Frames of the memory cap test are big enough to tell their pixels from other allocations. */
+#define TEST_BIG_WIDTH  256
+#define TEST_BIG_HEIGHT 256
+
+/* Number of files in a batch. One of them doesn't exist. */
+#define TEST_FILES 8
+#define TEST_MISSING_FILE 3
+
+static const unsigned test_threads[] = { 1, 3, 0 };
+
+/* Image files written for a batch. Every file has its own width. */
+struct test_files {
+    char *paths[TEST_FILES];
+    struct sail_image *expected_images[TEST_FILES];
+};
+
+static void write_test_files(const struct sail_codec_info *codec_info, unsigned width, unsigned height,
+                                struct test_files *files) {
+
+    const char *extension = codec_info->extension_node->value;
+
+    for (unsigned i = 0; i < TEST_FILES; i++) {
+        char name[64];
+        snprintf(name, sizeof(name), "batch-%u.%s", i, extension);
+        munit_assert(sail_strdup(name, &files->paths[i]) == SAIL_OK);
+
+        files->expected_images[i] = NULL;
+
+        if (i == TEST_MISSING_FILE) {
+            remove(files->paths[i]);
+            continue;
+        }
+
+        void *buffer;
+        size_t buffer_length;
+        munit_assert(test_encode_image(codec_info, width + i, height, 1, &buffer, &buffer_length) == SAIL_OK);
+        munit_assert(sail_read_mem(buffer, buffer_length, &files->expected_images[i]) == SAIL_OK);
+
+        FILE *fptr = fopen(files->paths[i], "wb");
+        munit_assert_not_null(fptr);
+        munit_assert_size(fwrite(buffer, 1, buffer_length, fptr), ==, buffer_length);
+        fclose(fptr);
+
+        sail_free(buffer);
+    }
+}
+
+static void remove_test_files(struct test_files *files) {
+
+    for (unsigned i = 0; i < TEST_FILES; i++) {
+        remove(files->paths[i]);
+        sail_free(files->paths[i]);
+        sail_destroy_image(files->expected_images[i]);
+    }
+}
+
+/*
+ * Allocator that tracks the peak size of the live pixel buffers. A buffer is considered to hold pixels
+ * if it's at least as big as the pixels of the smallest frame.
+ */
+struct pixels_tracker {
+    size_t min_pixels_size;
+    uint64_t live_bytes;
+    uint64_t peak_bytes;
+};
+
+/* Keeps the returned memory aligned like malloc() does. */
+#define TRACKER_HEADER_SIZE 16
+
+static struct pixels_tracker tracker = { SIZE_MAX, 0, 0 };
+
+static uint64_t add_live_bytes(uint64_t value) {
+
+#ifdef SAIL_WIN32
+    return (uint64_t)InterlockedExchangeAdd64((volatile LONG64 *)&tracker.live_bytes, (LONG64)value) + value;
+#else
+    return __atomic_add_fetch(&tracker.live_bytes, value, __ATOMIC_RELAXED);
+#endif
+}
+
+static void update_peak_bytes(uint64_t live_bytes) {
+
+#ifdef SAIL_WIN32
+    LONG64 peak_bytes = InterlockedCompareExchange64((volatile LONG64 *)&tracker.peak_bytes, 0, 0);
+
+    while ((uint64_t)peak_bytes < live_bytes) {
+        const LONG64 previous = InterlockedCompareExchange64((volatile LONG64 *)&tracker.peak_bytes, (LONG64)live_bytes, peak_bytes);
+
+        if (previous == peak_bytes) {
+            break;
+        }
+
+        peak_bytes = previous;
+    }
+#else
+    uint64_t peak_bytes = __atomic_load_n(&tracker.peak_bytes, __ATOMIC_RELAXED);
+
+    while (peak_bytes < live_bytes
+            && !__atomic_compare_exchange_n(&tracker.peak_bytes, &peak_bytes, live_bytes, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+#endif
+}
+
+static void track_size(size_t old_size, size_t new_size) {
+
+    if (old_size >= tracker.min_pixels_size) {
+        add_live_bytes((uint64_t)0 - old_size);
+    }
+
+    if (new_size >= tracker.min_pixels_size) {
+        update_peak_bytes(add_live_bytes(new_size));
+    }
+}
+
+static void* tracking_malloc(void *user_data, size_t size) {
+    (void)user_data;
+
+    unsigned char *block = malloc(TRACKER_HEADER_SIZE + size);
+
+    if (block == NULL) {
+        return NULL;
+    }
+
+    memcpy(block, &size, sizeof(size));
+    track_size(0, size);
+
+    return block + TRACKER_HEADER_SIZE;
+}
+
+static void* tracking_realloc(void *user_data, void *ptr, size_t size) {
+    (void)user_data;
+
+    if (ptr == NULL) {
+        return tracking_malloc(user_data, size);
+    }
+
+    unsigned char *block = (unsigned char *)ptr - TRACKER_HEADER_SIZE;
+    size_t old_size;
+    memcpy(&old_size, block, sizeof(old_size));
+
+    block = realloc(block, TRACKER_HEADER_SIZE + size);
+
+    if (block == NULL) {
+        return NULL;
+    }
+
+    memcpy(block, &size, sizeof(size));
+    track_size(old_size, size);
+
+    return block + TRACKER_HEADER_SIZE;
+}
+
+static void tracking_free(void *user_data, void *ptr) {
+    (void)user_data;
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    unsigned char *block = (unsigned char *)ptr - TRACKER_HEADER_SIZE;
+    size_t size;
+    memcpy(&size, block, sizeof(size));
+
+    track_size(size, 0);
+    free(block);
+}
+
+/*
+ * Tests.
+ */
+static MunitResult test_probe_files(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    unsigned codecs = 0;
+
+    for (const struct sail_codec_info_node *node = sail_codec_info_list(); node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+
+        if (test_write_pixel_format(codec_info) == SAIL_PIXEL_FORMAT_UNKNOWN) {
+            continue;
+        }
+
+        struct test_files files;
+        write_test_files(codec_info, TEST_WIDTH, TEST_HEIGHT, &files);
+
+        for (size_t t = 0; t < sizeof(test_threads) / sizeof(test_threads[0]); t++) {
+            struct sail_probe_result results[TEST_FILES];
+            munit_assert(sail_probe_files((const char * const *)files.paths, TEST_FILES, results, test_threads[t]) == SAIL_OK);
+
+            for (unsigned i = 0; i < TEST_FILES; i++) {
+                if (i == TEST_MISSING_FILE) {
+                    munit_assert(results[i].status != SAIL_OK);
+                    munit_assert_null(results[i].image);
+                    munit_assert_null(results[i].codec_info);
+                    continue;
+                }
+
+                munit_assert(results[i].status == SAIL_OK);
+                munit_assert_ptr_equal(results[i].codec_info, codec_info);
+                munit_assert_not_null(results[i].image);
+                munit_assert_uint(results[i].image->width, ==, TEST_WIDTH + i);
+                munit_assert_uint(results[i].image->height, ==, TEST_HEIGHT);
+                munit_assert_null(results[i].image->pixels);
+
+                sail_destroy_image(results[i].image);
+            }
+        }
+
+        remove_test_files(&files);
+
+        codecs++;
+    }
+
+    sail_finish();
+
+    if (codecs == 0) {
+        return MUNIT_SKIP;
+    }
+
+    return MUNIT_OK;
+}
+
+struct read_files_result {
+    const struct test_files *files;
+    unsigned delivered;
+};
+
+/* Unloads the codecs and finishes the context the workers use while they're decoding other files. */
+static void unload_codecs_callback(size_t index, sail_status_t status, struct sail_image *image, void *user_data) {
+
+    struct read_files_result *result = user_data;
+    const struct sail_image *expected_image = result->files->expected_images[index];
+
+    if (index == TEST_MISSING_FILE) {
+        munit_assert(status != SAIL_OK);
+        munit_assert_null(image);
+    } else {
+        munit_assert(status == SAIL_OK);
+        munit_assert_uint(image->width, ==, expected_image->width);
+        munit_assert_uint(image->height, ==, expected_image->height);
+        munit_assert_memory_equal((size_t)image->bytes_per_line * image->height, image->pixels, expected_image->pixels);
+
+        sail_destroy_image(image);
+    }
+
+    munit_assert(sail_unload_codecs() == SAIL_OK);
+    sail_finish();
+
+    result->delivered++;
+}
+
+static MunitResult test_unload_in_batch(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    unsigned codecs = 0;
+
+    for (const struct sail_codec_info_node *node = sail_codec_info_list(); node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+
+        if (test_write_pixel_format(codec_info) == SAIL_PIXEL_FORMAT_UNKNOWN) {
+            continue;
+        }
+
+        struct test_files files;
+        write_test_files(codec_info, TEST_WIDTH, TEST_HEIGHT, &files);
+
+        struct read_files_result result = { &files, 0 };
+        munit_assert(sail_read_files_with_options((const char * const *)files.paths, TEST_FILES, NULL /* read options */,
+                                                  0 /* max bytes in flight */, 4 /* threads */,
+                                                  unload_codecs_callback, &result) == SAIL_OK);
+        munit_assert_uint(result.delivered, ==, TEST_FILES);
+
+        remove_test_files(&files);
+
+        codecs++;
+    }
+
+    sail_finish();
+
+    if (codecs == 0) {
+        return MUNIT_SKIP;
+    }
+
+    return MUNIT_OK;
+}
+
+static void destroy_image_callback(size_t index, sail_status_t status, struct sail_image *image, void *user_data) {
+
+    struct read_files_result *result = user_data;
+    const struct sail_image *expected_image = result->files->expected_images[index];
+
+    if (index == TEST_MISSING_FILE) {
+        munit_assert(status != SAIL_OK);
+        munit_assert_null(image);
+    } else {
+        munit_assert(status == SAIL_OK);
+        munit_assert_uint(image->width, ==, expected_image->width);
+        munit_assert_memory_equal((size_t)image->bytes_per_line * image->height, image->pixels, expected_image->pixels);
+
+        sail_destroy_image(image);
+    }
+
+    result->delivered++;
+}
+
+static MunitResult test_memory_cap(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    /* Install the allocator before SAIL allocates anything. */
+    struct sail_allocator allocator = { tracking_malloc, tracking_realloc, tracking_free, NULL };
+    munit_assert(sail_set_allocator(&allocator) == SAIL_OK);
+
+    unsigned codecs = 0;
+
+    for (const struct sail_codec_info_node *node = sail_codec_info_list(); node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+
+        if (test_write_pixel_format(codec_info) == SAIL_PIXEL_FORMAT_UNKNOWN) {
+            continue;
+        }
+
+        struct test_files files;
+        write_test_files(codec_info, TEST_BIG_WIDTH, TEST_BIG_HEIGHT, &files);
+
+        uint64_t min_frame_size = UINT64_MAX;
+        uint64_t max_frame_size = 0;
+
+        for (unsigned i = 0; i < TEST_FILES; i++) {
+            if (files.expected_images[i] == NULL) {
+                continue;
+            }
+
+            uint64_t frame_size;
+            munit_assert(sail_bytes_per_image64(files.expected_images[i], &frame_size) == SAIL_OK);
+
+            min_frame_size = (frame_size < min_frame_size) ? frame_size : min_frame_size;
+            max_frame_size = (frame_size > max_frame_size) ? frame_size : max_frame_size;
+        }
+
+        /* Two frames fit into the first cap. A single frame is bigger than the second one, so frames are read one by one. */
+        const uint64_t caps[] = { max_frame_size * 2 + max_frame_size / 2, min_frame_size / 2 };
+        const uint64_t max_peaks[] = { max_frame_size * 2, max_frame_size };
+
+        for (size_t c = 0; c < sizeof(caps) / sizeof(caps[0]); c++) {
+            tracker.min_pixels_size = (size_t)min_frame_size;
+            tracker.live_bytes = 0;
+            tracker.peak_bytes = 0;
+
+            struct read_files_result result = { &files, 0 };
+            munit_assert(sail_read_files_with_options((const char * const *)files.paths, TEST_FILES, NULL /* read options */,
+                                                      (size_t)caps[c], 4 /* threads */,
+                                                      destroy_image_callback, &result) == SAIL_OK);
+
+            tracker.min_pixels_size = SIZE_MAX;
+
+            munit_assert_uint(result.delivered, ==, TEST_FILES);
+            munit_assert_uint64(tracker.peak_bytes, >=, min_frame_size);
+            munit_assert_uint64(tracker.peak_bytes, <=, max_peaks[c]);
+        }
+
+        remove_test_files(&files);
+
+        codecs++;
+    }
+
+    /* Free the memory allocated with the tracking allocator before restoring the system one. */
+    sail_finish();
+    munit_assert(sail_set_allocator(NULL) == SAIL_OK);
+
+    if (codecs == 0) {
+        return MUNIT_SKIP;
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/probe-files",     test_probe_files,     NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/unload-in-batch", test_unload_in_batch, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/memory-cap",      test_memory_cap,      NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/batch",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,271 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#define DESCRIPTION_SIZE (64 * 1024)
+
+/* Set when libsail logs that codecs have been loaded from the cache. */
+static bool cache_loaded = false;
+
+static void cache_logger(enum SailLogLevel level, const char *file, int line, const char *format, va_list args) {
+    (void)level;
+    (void)file;
+    (void)line;
+    (void)args;
+
+    if (strncmp(format, "Loaded codecs from the cache", strlen("Loaded codecs from the cache")) == 0) {
+        cache_loaded = true;
+    }
+}
+
+static void append(char *description, const char *format, ...) {
+    const size_t length = strlen(description);
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(description + length, DESCRIPTION_SIZE - length, format, args);
+    va_end(args);
+}
+
+static void append_string_list(char *description, const struct sail_string_node *string_node) {
+    for (; string_node != NULL; string_node = string_node->next) {
+        append(description, "%s,", string_node->value);
+    }
+
+    append(description, "\n");
+}
+
+/* Describes all the fields of all the enumerated codec info objects in a single string. */
+static void describe_codec_info_list(char *description) {
+    description[0] = '\0';
+
+    for (const struct sail_codec_info_node *node = sail_codec_info_list(); node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+
+        append(description, "%s\n%d\n%s\n%s\n%s\n", codec_info->path, codec_info->layout,
+                codec_info->version, codec_info->name, codec_info->description);
+
+        append_string_list(description, codec_info->magic_number_node);
+        append_string_list(description, codec_info->extension_node);
+        append_string_list(description, codec_info->mime_type_node);
+
+        const struct sail_read_features *read_features = codec_info->read_features;
+
+        for (unsigned i = 0; i < read_features->output_pixel_formats_length; i++) {
+            append(description, "%d,", read_features->output_pixel_formats[i]);
+        }
+
+        append(description, "\n%d\n%d\n", read_features->default_output_pixel_format, read_features->features);
+
+        const struct sail_write_features *write_features = codec_info->write_features;
+
+        for (const struct sail_pixel_formats_mapping_node *mapping_node = write_features->pixel_formats_mapping_node;
+                mapping_node != NULL; mapping_node = mapping_node->next) {
+            append(description, "%d:", mapping_node->input_pixel_format);
+
+            for (unsigned i = 0; i < mapping_node->output_pixel_formats_length; i++) {
+                append(description, "%d,", mapping_node->output_pixel_formats[i]);
+            }
+
+            append(description, ";");
+        }
+
+        append(description, "\n%d\n%d\n%d\n", write_features->features, write_features->properties, write_features->interlaced_passes);
+
+        for (unsigned i = 0; i < write_features->compressions_length; i++) {
+            append(description, "%d,", write_features->compressions[i]);
+        }
+
+        append(description, "\n%d\n%a\n%a\n%a\n%a\n", write_features->default_compression,
+                write_features->compression_level_min, write_features->compression_level_max,
+                write_features->compression_level_default, write_features->compression_level_step);
+    }
+}
+
+static char* build_path(const char *codecs_path, const char *name) {
+    char *path;
+    munit_assert(sail_concat(&path, 3, codecs_path, "/", name) == SAIL_OK);
+
+    return path;
+}
+
+static void read_whole_file(const char *path, char *buf, size_t buf_size, size_t *size) {
+    FILE *fptr = fopen(path, "rb");
+    munit_assert_not_null(fptr);
+
+    *size = fread(buf, 1, buf_size, fptr);
+    munit_assert_size(*size, <, buf_size);
+
+    fclose(fptr);
+}
+
+static void write_whole_file(const char *path, const char *buf, size_t size) {
+    FILE *fptr = fopen(path, "wb");
+    munit_assert_not_null(fptr);
+    munit_assert_size(fwrite(buf, 1, size, fptr), ==, size);
+    fclose(fptr);
+}
+
+/*
+ * Tests.
+ */
+static MunitResult test_round_trip(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const char *codecs_path = getenv("SAIL_CODECS_PATH");
+
+    if (codecs_path == NULL) {
+        return MUNIT_SKIP;
+    }
+
+    char *cache_path = build_path(codecs_path, "sail-codecs.cache");
+    remove(cache_path);
+
+    char *parsed = munit_malloc(DESCRIPTION_SIZE);
+    char *cached = munit_malloc(DESCRIPTION_SIZE);
+
+    /* Parse codec info files. */
+    cache_loaded = false;
+    describe_codec_info_list(parsed);
+    sail_finish();
+
+    munit_assert_false(cache_loaded);
+    munit_assert_size(strlen(parsed), >, 0);
+
+    /* Load the same codec info objects from the cache. */
+    munit_assert(sail_update_codecs_cache(codecs_path) == SAIL_OK);
+
+    describe_codec_info_list(cached);
+    sail_finish();
+
+    munit_assert_true(cache_loaded);
+    munit_assert_string_equal(cached, parsed);
+
+    remove(cache_path);
+    sail_free(cache_path);
+    free(cached);
+    free(parsed);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_outdated(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const char *codecs_path = getenv("SAIL_CODECS_PATH");
+
+    if (codecs_path == NULL || sail_codec_info_list() == NULL) {
+        sail_finish();
+        return MUNIT_SKIP;
+    }
+
+    char *name;
+    munit_assert(sail_strdup(sail_codec_info_list()->codec_info->name, &name) == SAIL_OK);
+    sail_finish();
+
+    /* "PNG" -> "sail-codec-png.codec.info". */
+    char codec_info_file_name[64];
+    snprintf(codec_info_file_name, sizeof(codec_info_file_name), "sail-codec-%s.codec.info", name);
+
+    for (char *c = codec_info_file_name; *c != '\0'; c++) {
+        *c = (char)tolower((unsigned char)*c);
+    }
+
+    char *cache_path           = build_path(codecs_path, "sail-codecs.cache");
+    char *codec_info_file_path = build_path(codecs_path, codec_info_file_name);
+
+    char original[8192];
+    size_t size;
+    read_whole_file(codec_info_file_path, original, sizeof(original), &size);
+
+    munit_assert(sail_update_codecs_cache(codecs_path) == SAIL_OK);
+
+    /*
+     * Change the codec description without changing the file size right after the cache
+     * is written. The file keeps its modification time on file systems with coarse timestamps.
+     */
+    char changed[8192];
+    memcpy(changed, original, size);
+
+    char *description = strstr(changed, "description=");
+    munit_assert_not_null(description);
+    description += strlen("description=");
+    *description = (*description == 'X') ? 'Y' : 'X';
+
+    write_whole_file(codec_info_file_path, changed, size);
+
+    /* The outdated cache is ignored, and the changed codec info file is parsed. */
+    cache_loaded = false;
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_name(name, &codec_info) == SAIL_OK);
+    munit_assert_false(cache_loaded);
+    munit_assert_char(codec_info->description[0], ==, *description);
+
+    sail_finish();
+
+    write_whole_file(codec_info_file_path, original, size);
+    remove(cache_path);
+
+    sail_free(codec_info_file_path);
+    sail_free(cache_path);
+    sail_free(name);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/round-trip", test_round_trip, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/outdated",   test_outdated,   NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/codecs-cache",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    sail_set_log_barrier(SAIL_LOG_LEVEL_DEBUG);
+    sail_set_logger(cache_logger);
+
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
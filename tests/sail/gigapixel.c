@@ -0,0 +1,268 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+#include "munit.h"
+
+/* 40000x40000 BPP32-RGBA raster takes 6.4 GB. */
+#define GIGAPIXEL_WIDTH  40000U
+#define GIGAPIXEL_HEIGHT 40000U
+#define GIGAPIXEL_SIZE   ((uint64_t)GIGAPIXEL_WIDTH * GIGAPIXEL_HEIGHT * 4)
+
+/*
+ * A synthetic read-only stream of a gigapixel raster. Bytes are generated from their offsets,
+ * so no memory is allocated.
+ */
+struct gigapixel_stream {
+    uint64_t pos;
+};
+
+static unsigned char gigapixel_byte(uint64_t offset) {
+    return (unsigned char)((offset ^ (offset >> 32)) * 31);
+}
+
+static sail_status_t gigapixel_read(void *stream, void *buf, size_t object_size, size_t objects_count, size_t *read_objects_count) {
+    struct gigapixel_stream *gigapixel_stream = stream;
+
+    const uint64_t available = GIGAPIXEL_SIZE - gigapixel_stream->pos;
+    const uint64_t available_objects = (object_size == 0) ? 0 : available / object_size;
+
+    *read_objects_count = (objects_count < available_objects) ? objects_count : (size_t)available_objects;
+
+    for (size_t i = 0; i < *read_objects_count * object_size; i++) {
+        ((unsigned char *)buf)[i] = gigapixel_byte(gigapixel_stream->pos++);
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t gigapixel_seek64(void *stream, int64_t offset, int whence) {
+    struct gigapixel_stream *gigapixel_stream = stream;
+
+    switch (whence) {
+        case SEEK_SET: gigapixel_stream->pos = (uint64_t)offset;                   break;
+        case SEEK_CUR: gigapixel_stream->pos += (uint64_t)offset;                  break;
+        case SEEK_END: gigapixel_stream->pos = GIGAPIXEL_SIZE + (uint64_t)offset;  break;
+
+        default: return SAIL_ERROR_UNSUPPORTED_SEEK_WHENCE;
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t gigapixel_tell64(void *stream, uint64_t *offset) {
+    *offset = ((struct gigapixel_stream *)stream)->pos;
+    return SAIL_OK;
+}
+
+static sail_status_t gigapixel_seek(void *stream, long offset, int whence) {
+    return gigapixel_seek64(stream, offset, whence);
+}
+
+static sail_status_t gigapixel_tell(void *stream, size_t *offset) {
+    const uint64_t pos = ((struct gigapixel_stream *)stream)->pos;
+
+    if (pos > SIZE_MAX) {
+        return SAIL_ERROR_TELL_IO;
+    }
+
+    *offset = (size_t)pos;
+    return SAIL_OK;
+}
+
+/*
+ * Pixel sizes.
+ */
+static MunitResult test_bytes_per_line64(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    uint64_t result;
+
+    /* Matches the 32-bit version. */
+    munit_assert(sail_bytes_per_line64(12, SAIL_PIXEL_FORMAT_BPP1, &result) == SAIL_OK);
+    munit_assert_uint64(result, ==, 2);
+    munit_assert(sail_bytes_per_line64(12, SAIL_PIXEL_FORMAT_BPP16, &result) == SAIL_OK);
+    munit_assert_uint64(result, ==, 24);
+
+    /* The widest possible scan line. */
+    munit_assert(sail_bytes_per_line64(UINT32_MAX, SAIL_PIXEL_FORMAT_BPP64_RGBA, &result) == SAIL_OK);
+    munit_assert_uint64(result, ==, (uint64_t)UINT32_MAX * 8);
+
+    unsigned result32;
+    munit_assert(sail_bytes_per_line(UINT32_MAX, SAIL_PIXEL_FORMAT_BPP64_RGBA, &result32) == SAIL_ERROR_INCORRECT_IMAGE_DIMENSIONS);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_bytes_per_image64(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->width        = GIGAPIXEL_WIDTH;
+    image->height       = GIGAPIXEL_HEIGHT;
+    image->pixel_format = SAIL_PIXEL_FORMAT_BPP32_RGBA;
+
+    uint64_t result;
+    munit_assert(sail_bytes_per_image64(image, &result) == SAIL_OK);
+    munit_assert_uint64(result, ==, GIGAPIXEL_SIZE);
+
+    /* The 32-bit version fails instead of silently overflowing. */
+    unsigned result32 = 0;
+    munit_assert(sail_bytes_per_image(image, &result32) == SAIL_ERROR_INCORRECT_IMAGE_DIMENSIONS);
+
+    /* The scan line still fits. */
+    munit_assert(sail_bytes_per_line(image->width, image->pixel_format, &result32) == SAIL_OK);
+    munit_assert_uint(result32, ==, GIGAPIXEL_WIDTH * 4);
+
+    /* The biggest possible 8-bit image still fits. */
+    image->width        = UINT32_MAX;
+    image->height       = UINT32_MAX;
+    image->pixel_format = SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE;
+
+    munit_assert(sail_bytes_per_image64(image, &result) == SAIL_OK);
+    munit_assert_uint64(result, ==, (uint64_t)UINT32_MAX * UINT32_MAX);
+
+    /* And 64-bit one doesn't. */
+    image->pixel_format = SAIL_PIXEL_FORMAT_BPP64_RGBA;
+
+    munit_assert(sail_bytes_per_image64(image, &result) == SAIL_ERROR_INCORRECT_IMAGE_DIMENSIONS);
+
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+/*
+ * I/O.
+ */
+static MunitResult test_io_64_bit_offsets(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct gigapixel_stream gigapixel_stream = { 0 };
+
+    struct sail_io *io;
+    munit_assert(sail_alloc_io(&io) == SAIL_OK);
+
+    io->stream = &gigapixel_stream;
+    io->read   = gigapixel_read;
+    io->seek   = gigapixel_seek;
+    io->tell   = gigapixel_tell;
+    io->seek64 = gigapixel_seek64;
+    io->tell64 = gigapixel_tell64;
+
+    /* Seek to the last scan line which is far beyond 4 GB. */
+    const uint64_t bytes_per_line = (uint64_t)GIGAPIXEL_WIDTH * 4;
+    const uint64_t last_line      = GIGAPIXEL_SIZE - bytes_per_line;
+
+    munit_assert(sail_io_seek(io, (int64_t)last_line, SEEK_SET) == SAIL_OK);
+
+    uint64_t offset;
+    munit_assert(sail_io_tell(io, &offset) == SAIL_OK);
+    munit_assert_uint64(offset, ==, last_line);
+
+    unsigned char pixel[4];
+    size_t read_objects_count;
+    munit_assert(io->read(io->stream, pixel, sizeof(pixel), 1, &read_objects_count) == SAIL_OK);
+    munit_assert_size(read_objects_count, ==, 1);
+
+    for (unsigned i = 0; i < sizeof(pixel); i++) {
+        munit_assert_uint8(pixel[i], ==, gigapixel_byte(last_line + i));
+    }
+
+    /* Seek back over more than 4 GB. */
+    munit_assert(sail_io_seek(io, -(int64_t)(GIGAPIXEL_SIZE / 2), SEEK_END) == SAIL_OK);
+    munit_assert(sail_io_tell(io, &offset) == SAIL_OK);
+    munit_assert_uint64(offset, ==, GIGAPIXEL_SIZE / 2);
+
+    sail_destroy_io(io);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_io_long_offsets(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct gigapixel_stream gigapixel_stream = { 0 };
+
+    struct sail_io *io;
+    munit_assert(sail_alloc_io(&io) == SAIL_OK);
+
+    /* I/O objects without 64-bit callbacks fall back to the long-based ones. */
+    io->stream = &gigapixel_stream;
+    io->read   = gigapixel_read;
+    io->seek   = gigapixel_seek;
+    io->tell   = gigapixel_tell;
+
+    munit_assert(sail_io_seek(io, 1024, SEEK_SET) == SAIL_OK);
+
+    uint64_t offset;
+    munit_assert(sail_io_tell(io, &offset) == SAIL_OK);
+    munit_assert_uint64(offset, ==, 1024);
+
+    /* Offsets that don't fit into long fail cleanly. */
+    if ((uint64_t)LONG_MAX < GIGAPIXEL_SIZE) {
+        munit_assert(sail_io_seek(io, (int64_t)GIGAPIXEL_SIZE, SEEK_SET) == SAIL_ERROR_SEEK_IO);
+        munit_assert(sail_io_tell(io, &offset) == SAIL_OK);
+        munit_assert_uint64(offset, ==, 1024);
+    }
+
+    sail_destroy_io(io);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/bytes-per-line64",  test_bytes_per_line64,  NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/bytes-per-image64", test_bytes_per_image64, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { (char *)"/io-64-bit-offsets", test_io_64_bit_offsets, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/io-long-offsets",   test_io_long_offsets,   NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/gigapixel",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,122 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stddef.h>
+
+#include "sail.h"
+
+#include "images.h"
+
+enum SailPixelFormat test_write_pixel_format(const struct sail_codec_info *codec_info) {
+
+    static const enum SailPixelFormat pixel_formats[] = { SAIL_PIXEL_FORMAT_BPP32_RGBA, SAIL_PIXEL_FORMAT_BPP24_RGB };
+
+    for (size_t i = 0; i < sizeof(pixel_formats) / sizeof(pixel_formats[0]); i++) {
+        for (const struct sail_pixel_formats_mapping_node *node = codec_info->write_features->pixel_formats_mapping_node;
+                node != NULL; node = node->next) {
+            if (node->input_pixel_format == pixel_formats[i]) {
+                return pixel_formats[i];
+            }
+        }
+    }
+
+    return SAIL_PIXEL_FORMAT_UNKNOWN;
+}
+
+sail_status_t test_create_image(enum SailPixelFormat pixel_format, unsigned width, unsigned height, unsigned frame,
+                                struct sail_image **image) {
+
+    unsigned bits_per_pixel;
+    SAIL_TRY(sail_bits_per_pixel(pixel_format, &bits_per_pixel));
+
+    struct sail_image *image_local;
+    SAIL_TRY(sail_alloc_image(&image_local));
+
+    image_local->width        = width;
+    image_local->height       = height;
+    image_local->pixel_format = pixel_format;
+
+    SAIL_TRY_OR_CLEANUP(sail_bytes_per_line(width, pixel_format, &image_local->bytes_per_line),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    SAIL_TRY_OR_CLEANUP(sail_malloc((size_t)image_local->bytes_per_line * height, &image_local->pixels),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    const unsigned channels = bits_per_pixel / 8;
+
+    for (unsigned y = 0; y < height; y++) {
+        unsigned char *scan_line = (unsigned char *)image_local->pixels + (size_t)y * image_local->bytes_per_line;
+
+        for (unsigned x = 0; x < width; x++) {
+            unsigned char *pixel = scan_line + (size_t)x * channels;
+
+            pixel[0] = (unsigned char)(x * 255 / width);
+            pixel[1] = (unsigned char)(y * 255 / height);
+            pixel[2] = (unsigned char)((x * 7 + y * 13 + frame * 50) & 0xFF);
+
+            if (channels == 4) {
+                pixel[3] = (unsigned char)(((x / 8 + y / 8) % 2 == 0) ? 255 : 64 + frame * 30);
+            }
+        }
+    }
+
+    *image = image_local;
+
+    return SAIL_OK;
+}
+
+sail_status_t test_encode_image(const struct sail_codec_info *codec_info, unsigned width, unsigned height, unsigned frames,
+                                void **buffer, size_t *buffer_length) {
+
+    const enum SailPixelFormat pixel_format = test_write_pixel_format(codec_info);
+
+    if (pixel_format == SAIL_PIXEL_FORMAT_UNKNOWN) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+    }
+
+    *buffer        = NULL;
+    *buffer_length = 0;
+
+    void *state;
+    SAIL_TRY(sail_start_writing_growing_mem(buffer, buffer_length, codec_info, &state));
+
+    for (unsigned frame = 0; frame < frames; frame++) {
+        struct sail_image *image;
+        SAIL_TRY_OR_CLEANUP(test_create_image(pixel_format, width, height, frame, &image),
+                            /* cleanup */ sail_stop_writing(state),
+                                          sail_free(*buffer));
+
+        SAIL_TRY_OR_CLEANUP(sail_write_next_frame(state, image),
+                            /* cleanup */ sail_destroy_image(image),
+                                          sail_stop_writing(state),
+                                          sail_free(*buffer));
+
+        sail_destroy_image(image);
+    }
+
+    SAIL_TRY(sail_stop_writing(state));
+
+    return SAIL_OK;
+}
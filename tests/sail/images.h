@@ -0,0 +1,58 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_TESTS_IMAGES_H
+#define SAIL_TESTS_IMAGES_H
+
+#include <stddef.h>
+
+#include "sail.h"
+
+/*
+ * Synthetic images used by the tests instead of stored fixtures. The tests encode them
+ * with every built codec that can write them and decode them back.
+ */
+
+/*
+ * Returns the pixel format of the synthetic images the codec can write,
+ * or SAIL_PIXEL_FORMAT_UNKNOWN if the codec cannot write them.
+ */
+enum SailPixelFormat test_write_pixel_format(const struct sail_codec_info *codec_info);
+
+/*
+ * Allocates a new image of the specified size filled with a pattern that depends on the frame index.
+ * The alpha channel, if any, is not opaque everywhere.
+ */
+sail_status_t test_create_image(enum SailPixelFormat pixel_format, unsigned width, unsigned height, unsigned frame,
+                                struct sail_image **image);
+
+/*
+ * Encodes the specified number of synthetic frames with the codec into a new memory buffer.
+ * The caller MUST free the buffer with sail_free().
+ */
+sail_status_t test_encode_image(const struct sail_codec_info *codec_info, unsigned width, unsigned height, unsigned frames,
+                                void **buffer, size_t *buffer_length);
+
+#endif
@@ -0,0 +1,529 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#include "images.h"
+
+#define TEST_WIDTH  123
+#define TEST_HEIGHT 77
+
+/*
+ * Growing memory writer.
+ */
+static MunitResult test_growing_mem(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    unsigned codecs = 0;
+
+    for (const struct sail_codec_info_node *node = sail_codec_info_list(); node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+        const enum SailPixelFormat pixel_format = test_write_pixel_format(codec_info);
+
+        if (pixel_format == SAIL_PIXEL_FORMAT_UNKNOWN) {
+            continue;
+        }
+
+        struct sail_image *image;
+        munit_assert(test_create_image(pixel_format, TEST_WIDTH, TEST_HEIGHT, 0, &image) == SAIL_OK);
+
+        /* Write into a buffer growing on demand. */
+        void *growing_buffer;
+        size_t growing_buffer_length;
+        void *state;
+
+        munit_assert(sail_start_writing_growing_mem(&growing_buffer, &growing_buffer_length, codec_info, &state) == SAIL_OK);
+        munit_assert(sail_write_next_frame(state, image) == SAIL_OK);
+        munit_assert(sail_stop_writing(state) == SAIL_OK);
+
+        munit_assert_not_null(growing_buffer);
+        munit_assert_size(growing_buffer_length, >, 0);
+
+        /* Write the same image into a big enough fixed buffer. The encoded bytes must be the same. */
+        const size_t fixed_buffer_length = (size_t)image->bytes_per_line * image->height * 2 + 64 * 1024;
+        void *fixed_buffer = munit_malloc(fixed_buffer_length);
+        size_t written;
+
+        munit_assert(sail_start_writing_mem(fixed_buffer, fixed_buffer_length, codec_info, &state) == SAIL_OK);
+        munit_assert(sail_write_next_frame(state, image) == SAIL_OK);
+        munit_assert(sail_stop_writing_with_written(state, &written) == SAIL_OK);
+
+        munit_assert_size(growing_buffer_length, ==, written);
+        munit_assert_memory_equal(written, growing_buffer, fixed_buffer);
+
+        /* Read it back. */
+        struct sail_image *read_image;
+        munit_assert(sail_read_mem(growing_buffer, growing_buffer_length, &read_image) == SAIL_OK);
+
+        munit_assert_uint(read_image->width,  ==, TEST_WIDTH);
+        munit_assert_uint(read_image->height, ==, TEST_HEIGHT);
+        munit_assert_not_null(read_image->pixels);
+
+        sail_destroy_image(read_image);
+        free(fixed_buffer);
+        sail_free(growing_buffer);
+        sail_destroy_image(image);
+
+        codecs++;
+    }
+
+    sail_finish();
+
+    if (codecs == 0) {
+        return MUNIT_SKIP;
+    }
+
+    return MUNIT_OK;
+}
+
+/*
+ * Non-seekable sources.
+ */
+struct pipe_stream {
+    const unsigned char *data;
+    size_t size;
+    size_t pos;
+};
+
+/* The size of short reads returned by the pipe. */
+#define TEST_PIPE_CHUNK_SIZE 1000
+
+static sail_status_t pipe_read(void *stream, void *buf, size_t object_size, size_t objects_count, size_t *read_objects_count) {
+
+    struct pipe_stream *pipe_stream = stream;
+
+    /* Like pipes, return less than requested. */
+    size_t size = object_size * objects_count;
+    size = (size < TEST_PIPE_CHUNK_SIZE) ? size : TEST_PIPE_CHUNK_SIZE;
+    size = (size < pipe_stream->size - pipe_stream->pos) ? size : pipe_stream->size - pipe_stream->pos;
+    size -= size % object_size;
+
+    memcpy(buf, pipe_stream->data + pipe_stream->pos, size);
+    pipe_stream->pos += size;
+
+    *read_objects_count = size / object_size;
+
+    return SAIL_OK;
+}
+
+static sail_status_t pipe_seek(void *stream, long offset, int whence) {
+    (void)stream;
+    (void)offset;
+    (void)whence;
+
+    return SAIL_ERROR_SEEK_IO;
+}
+
+static sail_status_t pipe_tell(void *stream, size_t *offset) {
+    (void)stream;
+    (void)offset;
+
+    return SAIL_ERROR_TELL_IO;
+}
+
+static sail_status_t pipe_write(void *stream, const void *buf, size_t object_size, size_t objects_count, size_t *written_objects_count) {
+    (void)stream;
+    (void)buf;
+    (void)object_size;
+    (void)objects_count;
+    (void)written_objects_count;
+
+    return SAIL_ERROR_WRITE_IO;
+}
+
+static sail_status_t pipe_flush(void *stream) {
+    (void)stream;
+
+    return SAIL_OK;
+}
+
+static sail_status_t pipe_close(void *stream) {
+    (void)stream;
+
+    return SAIL_OK;
+}
+
+static sail_status_t pipe_eof(void *stream, bool *result) {
+
+    const struct pipe_stream *pipe_stream = stream;
+
+    *result = pipe_stream->pos == pipe_stream->size;
+
+    return SAIL_OK;
+}
+
+static struct sail_io *alloc_pipe_io(struct pipe_stream *pipe_stream, const unsigned char *data, size_t size) {
+
+    pipe_stream->data = data;
+    pipe_stream->size = size;
+    pipe_stream->pos  = 0;
+
+    struct sail_io *io;
+    munit_assert(sail_alloc_io(&io) == SAIL_OK);
+
+    io->stream   = pipe_stream;
+    io->read     = pipe_read;
+    io->seek     = pipe_seek;
+    io->tell     = pipe_tell;
+    io->write    = pipe_write;
+    io->flush    = pipe_flush;
+    io->close    = pipe_close;
+    io->eof      = pipe_eof;
+    io->features = SAIL_IO_FEATURE_NON_SEEKABLE;
+
+    return io;
+}
+
+static MunitResult test_non_seekable(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    unsigned codecs = 0;
+
+    for (const struct sail_codec_info_node *node = sail_codec_info_list(); node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+
+        if ((codec_info->read_features->features & SAIL_CODEC_FEATURE_STREAMING) == 0 ||
+                test_write_pixel_format(codec_info) == SAIL_PIXEL_FORMAT_UNKNOWN) {
+            continue;
+        }
+
+        void *buffer;
+        size_t buffer_length;
+        munit_assert(test_encode_image(codec_info, TEST_WIDTH, TEST_HEIGHT, 1, &buffer, &buffer_length) == SAIL_OK);
+
+        /* Trailing data makes the source a few rewind windows long. */
+        const size_t stream_length = buffer_length + 3 * SAIL_RING_BUFFER_DEFAULT_WINDOW_SIZE;
+        unsigned char *stream = munit_malloc(stream_length);
+        memcpy(stream, buffer, buffer_length);
+
+        for (size_t i = buffer_length; i < stream_length; i++) {
+            stream[i] = (unsigned char)(i * 7);
+        }
+
+        struct sail_image *expected_image;
+        munit_assert(sail_read_mem(buffer, buffer_length, &expected_image) == SAIL_OK);
+
+        struct pipe_stream pipe_stream;
+        struct sail_io *io = alloc_pipe_io(&pipe_stream, stream, stream_length);
+
+        /* The magic number cannot be read without rewinding the source. */
+        const struct sail_codec_info *detected_codec_info;
+        munit_assert(sail_codec_info_by_magic_number_from_io(io, &detected_codec_info) == SAIL_ERROR_SEEK_IO);
+
+        /* Detect the codec by the magic number through the ring buffer and read the frame. */
+        void *state;
+        munit_assert(sail_start_reading_io(io, NULL, &state) == SAIL_OK);
+
+        struct sail_image *image;
+        munit_assert(sail_read_next_frame(state, &image) == SAIL_OK);
+        munit_assert(sail_stop_reading(state) == SAIL_OK);
+
+        munit_assert_uint(image->width,  ==, expected_image->width);
+        munit_assert_uint(image->height, ==, expected_image->height);
+        munit_assert_int(image->pixel_format, ==, expected_image->pixel_format);
+        munit_assert_memory_equal((size_t)image->bytes_per_line * image->height, image->pixels, expected_image->pixels);
+
+        sail_destroy_image(image);
+        sail_destroy_io(io);
+
+        /* Seek the ring buffer the codec reads from. */
+        io = alloc_pipe_io(&pipe_stream, stream, stream_length);
+        munit_assert(sail_start_reading_io(io, NULL, &state) == SAIL_OK);
+
+        struct sail_io *ring_buffer_io = ((struct hidden_state *)state)->io;
+        munit_assert_uint64(ring_buffer_io->id, ==, SAIL_RING_BUFFER_IO_ID);
+
+        unsigned char data[16];
+        size_t nbytes;
+        uint64_t offset;
+
+        /* Forward beyond the window. */
+        const uint64_t forward_offset = buffer_length + 2 * SAIL_RING_BUFFER_DEFAULT_WINDOW_SIZE;
+        munit_assert(sail_io_seek(ring_buffer_io, (int64_t)forward_offset, SEEK_SET) == SAIL_OK);
+        munit_assert(sail_io_tell(ring_buffer_io, &offset) == SAIL_OK);
+        munit_assert_uint64(offset, ==, forward_offset);
+        munit_assert(ring_buffer_io->read(ring_buffer_io->stream, data, 1, sizeof(data), &nbytes) == SAIL_OK);
+        munit_assert_size(nbytes, ==, sizeof(data));
+        munit_assert_memory_equal(sizeof(data), data, stream + forward_offset);
+
+        /* Back within the window. */
+        const uint64_t backward_offset = forward_offset + sizeof(data) - SAIL_RING_BUFFER_DEFAULT_WINDOW_SIZE;
+        munit_assert(sail_io_seek(ring_buffer_io, (int64_t)backward_offset, SEEK_SET) == SAIL_OK);
+        munit_assert(ring_buffer_io->read(ring_buffer_io->stream, data, 1, sizeof(data), &nbytes) == SAIL_OK);
+        munit_assert_size(nbytes, ==, sizeof(data));
+        munit_assert_memory_equal(sizeof(data), data, stream + backward_offset);
+
+        /* Back beyond the window. */
+        munit_assert(sail_io_seek(ring_buffer_io, (int64_t)backward_offset - 1, SEEK_SET) == SAIL_ERROR_SEEK_IO);
+        munit_assert(sail_io_seek(ring_buffer_io, 0, SEEK_SET) == SAIL_ERROR_SEEK_IO);
+
+        /* The end is found by reading the rest of the source. */
+        munit_assert(sail_io_seek(ring_buffer_io, 0, SEEK_END) == SAIL_OK);
+        munit_assert(sail_io_tell(ring_buffer_io, &offset) == SAIL_OK);
+        munit_assert_uint64(offset, ==, stream_length);
+
+        munit_assert(sail_stop_reading(state) == SAIL_OK);
+        sail_destroy_io(io);
+
+        /* Probe through the ring buffer. */
+        io = alloc_pipe_io(&pipe_stream, stream, stream_length);
+        munit_assert(sail_probe_io(io, &image, &detected_codec_info) == SAIL_OK);
+        munit_assert_ptr_equal(detected_codec_info, codec_info);
+        munit_assert_uint(image->width,  ==, TEST_WIDTH);
+        munit_assert_uint(image->height, ==, TEST_HEIGHT);
+
+        sail_destroy_image(image);
+        sail_destroy_io(io);
+        sail_destroy_image(expected_image);
+        free(stream);
+        sail_free(buffer);
+
+        codecs++;
+    }
+
+    sail_finish();
+
+    if (codecs == 0) {
+        return MUNIT_SKIP;
+    }
+
+    return MUNIT_OK;
+}
+
+/*
+ * Memory segments.
+ */
+
+/* Marks the last segment holding the rest of the data. */
+#define TEST_SEGMENT_REST SIZE_MAX
+
+/* Segment lengths that split the image header at awkward offsets. Zeros are empty segments. */
+static const struct {
+    size_t segments_count;
+    size_t segment_lengths[8];
+} test_segment_chains[] = {
+    { 1, { TEST_SEGMENT_REST } },
+    { 2, { 1, TEST_SEGMENT_REST } },
+    { 4, { 2, 3, 7, TEST_SEGMENT_REST } },
+    { 5, { 0, 15, 1, TEST_SEGMENT_REST, 0 } },
+    { 8, { 16, 0, 0, 1, 0, 33, TEST_SEGMENT_REST, 0 } },
+    { 7, { 0, 0, 7, 0, 9, 0, TEST_SEGMENT_REST } },
+};
+
+static void read_mem_segments(const unsigned char *buffer, size_t buffer_length, const size_t *segment_lengths,
+                              size_t segments_count, const struct sail_image *expected_image) {
+
+    struct sail_mem_segment segments[8];
+    size_t offset = 0;
+
+    /* Every segment is a separate allocation to catch reads past its end. */
+    for (size_t i = 0; i < segments_count; i++) {
+        size_t length = (segment_lengths[i] == TEST_SEGMENT_REST) ? buffer_length - offset : segment_lengths[i];
+        length = (length < buffer_length - offset) ? length : buffer_length - offset;
+
+        void *segment_buffer = munit_malloc(length + 1);
+        memcpy(segment_buffer, buffer + offset, length);
+
+        segments[i].buffer = segment_buffer;
+        segments[i].length = length;
+
+        offset += length;
+    }
+
+    munit_assert_size(offset, ==, buffer_length);
+
+    /* Detect the codec by the magic number split between the segments. */
+    void *state;
+    munit_assert(sail_start_reading_mem_segments(segments, segments_count, NULL, &state) == SAIL_OK);
+
+    struct sail_image *image;
+    munit_assert(sail_read_next_frame(state, &image) == SAIL_OK);
+    munit_assert(sail_stop_reading(state) == SAIL_OK);
+
+    munit_assert_uint(image->width,  ==, expected_image->width);
+    munit_assert_uint(image->height, ==, expected_image->height);
+    munit_assert_int(image->pixel_format, ==, expected_image->pixel_format);
+    munit_assert_memory_equal((size_t)image->bytes_per_line * image->height, image->pixels, expected_image->pixels);
+
+    sail_destroy_image(image);
+
+    for (size_t i = 0; i < segments_count; i++) {
+        free((void *)segments[i].buffer);
+    }
+}
+
+static MunitResult test_mem_segments(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    unsigned codecs = 0;
+
+    for (const struct sail_codec_info_node *node = sail_codec_info_list(); node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+
+        if (test_write_pixel_format(codec_info) == SAIL_PIXEL_FORMAT_UNKNOWN) {
+            continue;
+        }
+
+        void *buffer;
+        size_t buffer_length;
+        munit_assert(test_encode_image(codec_info, TEST_WIDTH, TEST_HEIGHT, 1, &buffer, &buffer_length) == SAIL_OK);
+
+        struct sail_image *expected_image;
+        munit_assert(sail_read_mem(buffer, buffer_length, &expected_image) == SAIL_OK);
+
+        for (size_t i = 0; i < sizeof(test_segment_chains) / sizeof(test_segment_chains[0]); i++) {
+            read_mem_segments(buffer, buffer_length, test_segment_chains[i].segment_lengths,
+                              test_segment_chains[i].segments_count, expected_image);
+        }
+
+        /* The header split into single bytes. */
+        enum { single_bytes_count = 64 };
+        struct sail_mem_segment single_bytes[single_bytes_count + 1];
+
+        for (size_t i = 0; i < single_bytes_count; i++) {
+            single_bytes[i].buffer = (const unsigned char *)buffer + i;
+            single_bytes[i].length = 1;
+        }
+
+        single_bytes[single_bytes_count].buffer = (const unsigned char *)buffer + single_bytes_count;
+        single_bytes[single_bytes_count].length = buffer_length - single_bytes_count;
+
+        void *state;
+        munit_assert(sail_start_reading_mem_segments(single_bytes, single_bytes_count + 1, codec_info, &state) == SAIL_OK);
+
+        struct sail_image *image;
+        munit_assert(sail_read_next_frame(state, &image) == SAIL_OK);
+        munit_assert(sail_stop_reading(state) == SAIL_OK);
+        munit_assert_memory_equal((size_t)image->bytes_per_line * image->height, image->pixels, expected_image->pixels);
+
+        sail_destroy_image(image);
+        sail_destroy_image(expected_image);
+        sail_free(buffer);
+
+        codecs++;
+    }
+
+    sail_finish();
+
+    if (codecs == 0) {
+        return MUNIT_SKIP;
+    }
+
+    return MUNIT_OK;
+}
+
+/*
+ * Reading into caller buffers.
+ */
+static MunitResult test_to_buffer_retry(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    unsigned codecs = 0;
+
+    for (const struct sail_codec_info_node *node = sail_codec_info_list(); node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+
+        if (test_write_pixel_format(codec_info) == SAIL_PIXEL_FORMAT_UNKNOWN) {
+            continue;
+        }
+
+        void *buffer;
+        size_t buffer_length;
+        munit_assert(test_encode_image(codec_info, TEST_WIDTH, TEST_HEIGHT, 1, &buffer, &buffer_length) == SAIL_OK);
+
+        struct sail_image *expected_image;
+        munit_assert(sail_read_mem(buffer, buffer_length, &expected_image) == SAIL_OK);
+
+        const size_t pixels_size = (size_t)expected_image->bytes_per_line * expected_image->height;
+        void *pixels = munit_malloc(pixels_size);
+
+        void *state;
+        munit_assert(sail_start_reading_mem(buffer, buffer_length, codec_info, &state) == SAIL_OK);
+
+        /* Too small buffer and stride fail without consuming the frame. */
+        struct sail_image *image;
+        munit_assert(sail_read_next_frame_to_buffer(state, pixels, pixels_size - 1, 0, &image) == SAIL_ERROR_INVALID_ARGUMENT);
+        munit_assert(sail_read_next_frame_to_buffer(state, pixels, pixels_size, expected_image->bytes_per_line - 1, &image)
+                        == SAIL_ERROR_INCORRECT_BYTES_PER_LINE);
+
+        /* Retry the same frame with a big enough buffer. */
+        munit_assert(sail_read_next_frame_to_buffer(state, pixels, pixels_size, 0, &image) == SAIL_OK);
+        munit_assert(sail_stop_reading(state) == SAIL_OK);
+
+        munit_assert_uint(image->width,  ==, expected_image->width);
+        munit_assert_uint(image->height, ==, expected_image->height);
+        munit_assert_uint(image->bytes_per_line, ==, expected_image->bytes_per_line);
+        munit_assert_null(image->pixels);
+        munit_assert_memory_equal(pixels_size, pixels, expected_image->pixels);
+
+        sail_destroy_image(image);
+        free(pixels);
+        sail_destroy_image(expected_image);
+        sail_free(buffer);
+
+        codecs++;
+    }
+
+    sail_finish();
+
+    if (codecs == 0) {
+        return MUNIT_SKIP;
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/growing-mem", test_growing_mem, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/non-seekable", test_non_seekable, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/mem-segments", test_mem_segments, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/to-buffer-retry", test_to_buffer_retry, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/io",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,313 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#include "images.h"
+
+#define TEST_WIDTH  123
+#define TEST_HEIGHT 77
+
+/* Reads the first frame with the read options modified by the callback. */
+static sail_status_t read_with_options(const void *buffer, size_t buffer_length, const struct sail_codec_info *codec_info,
+                                       void (*modify)(struct sail_read_options *read_options, const void *arg), const void *arg,
+                                       struct sail_image **image) {
+
+    struct sail_read_options *read_options;
+    munit_assert(sail_alloc_read_options_from_features(codec_info->read_features, &read_options) == SAIL_OK);
+
+    modify(read_options, arg);
+
+    void *state;
+    munit_assert(sail_start_reading_mem_with_options(buffer, buffer_length, codec_info, read_options, &state) == SAIL_OK);
+    sail_destroy_read_options(read_options);
+
+    const sail_status_t status = sail_read_next_frame(state, image);
+    munit_assert(sail_stop_reading(state) == SAIL_OK);
+
+    return status;
+}
+
+/*
+ * Regions of interest.
+ */
+struct test_roi {
+    unsigned x;
+    unsigned y;
+    unsigned width;
+    unsigned height;
+};
+
+static const struct test_roi test_rois[] = {
+    { 0,   0,  TEST_WIDTH, TEST_HEIGHT },
+    { 0,   31, TEST_WIDTH, 15          },
+    { 10,  20, 50,         15          },
+    { 17,  3,  1,          1           },
+    { 33,  45, 64,         32          },
+    { 100, 60, 100,        100         },
+    { 122, 76, 1,          1           },
+};
+
+/* Region origins swept over the frame. */
+static const unsigned test_roi_xs[] = { 0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 64, 100 };
+
+static void set_roi(struct sail_read_options *read_options, const void *arg) {
+
+    const struct test_roi *roi = arg;
+
+    read_options->roi_x      = roi->x;
+    read_options->roi_y      = roi->y;
+    read_options->roi_width  = roi->width;
+    read_options->roi_height = roi->height;
+}
+
+/* Checks that the region is the same crop of the fully decoded frame. */
+static void check_roi(const void *buffer, size_t buffer_length, const struct sail_codec_info *codec_info,
+                      const struct sail_image *expected_image, const struct test_roi *roi) {
+
+    unsigned bits_per_pixel;
+    munit_assert(sail_bits_per_pixel(expected_image->pixel_format, &bits_per_pixel) == SAIL_OK);
+
+    struct sail_image *image;
+    munit_assert(read_with_options(buffer, buffer_length, codec_info, set_roi, roi, &image) == SAIL_OK);
+
+    const unsigned width  = (roi->width  < expected_image->width  - roi->x) ? roi->width  : expected_image->width  - roi->x;
+    const unsigned height = (roi->height < expected_image->height - roi->y) ? roi->height : expected_image->height - roi->y;
+
+    munit_assert_uint(image->width,  ==, width);
+    munit_assert_uint(image->height, ==, height);
+    munit_assert_int(image->pixel_format, ==, expected_image->pixel_format);
+
+    for (unsigned row = 0; row < height; row++) {
+        const unsigned char *expected_scan_line = (const unsigned char *)expected_image->pixels +
+                                                      (size_t)(roi->y + row) * expected_image->bytes_per_line +
+                                                      (size_t)roi->x * bits_per_pixel / 8;
+
+        munit_assert_memory_equal((size_t)width * bits_per_pixel / 8,
+                                  (const unsigned char *)image->pixels + (size_t)row * image->bytes_per_line,
+                                  expected_scan_line);
+    }
+
+    sail_destroy_image(image);
+}
+
+static MunitResult test_roi(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    unsigned codecs = 0;
+
+    for (const struct sail_codec_info_node *node = sail_codec_info_list(); node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+
+        if (test_write_pixel_format(codec_info) == SAIL_PIXEL_FORMAT_UNKNOWN) {
+            continue;
+        }
+
+        void *buffer;
+        size_t buffer_length;
+        munit_assert(test_encode_image(codec_info, TEST_WIDTH, TEST_HEIGHT, 1, &buffer, &buffer_length) == SAIL_OK);
+
+        struct sail_image *expected_image;
+        munit_assert(sail_read_mem(buffer, buffer_length, &expected_image) == SAIL_OK);
+
+        for (size_t i = 0; i < sizeof(test_rois) / sizeof(test_rois[0]); i++) {
+            check_roi(buffer, buffer_length, codec_info, expected_image, &test_rois[i]);
+        }
+
+        /* Regions starting and ending inside and on the edges of MCUs. */
+        for (size_t i = 0; i < sizeof(test_roi_xs) / sizeof(test_roi_xs[0]); i++) {
+            for (unsigned y = 0; y < TEST_HEIGHT; y++) {
+                const struct test_roi roi = { test_roi_xs[i], y, 15 + y % 3, 15 };
+                check_roi(buffer, buffer_length, codec_info, expected_image, &roi);
+            }
+        }
+
+        /* Regions outside of the frame. */
+        static const struct test_roi outside_rois[] = {
+            { TEST_WIDTH, 0,           1, 1 },
+            { 0,          TEST_HEIGHT, 1, 1 },
+            { 1000,       1000,        5, 5 },
+        };
+
+        for (size_t i = 0; i < sizeof(outside_rois) / sizeof(outside_rois[0]); i++) {
+            struct sail_image *image;
+            munit_assert(read_with_options(buffer, buffer_length, codec_info, set_roi, &outside_rois[i], &image)
+                            == SAIL_ERROR_INCORRECT_IMAGE_DIMENSIONS);
+        }
+
+        sail_destroy_image(expected_image);
+        sail_free(buffer);
+
+        codecs++;
+    }
+
+    sail_finish();
+
+    if (codecs == 0) {
+        return MUNIT_SKIP;
+    }
+
+    return MUNIT_OK;
+}
+
+/*
+ * Reduction.
+ */
+static void set_scale_denominator(struct sail_read_options *read_options, const void *arg) {
+
+    read_options->scale_denominator = *(const unsigned *)arg;
+}
+
+static void set_target_size(struct sail_read_options *read_options, const void *arg) {
+
+    read_options->target_size = *(const unsigned *)arg;
+}
+
+/* Checks the box filter of the codecs that cannot reduce frames natively. Color is weighted by alpha. */
+static void check_box_filter(const struct sail_image *expected_image, const struct sail_image *image, unsigned scale) {
+
+    const unsigned channels = (expected_image->pixel_format == SAIL_PIXEL_FORMAT_BPP32_RGBA) ? 4 : 3;
+
+    for (unsigned y = 0; y < image->height; y++) {
+        for (unsigned x = 0; x < image->width; x++) {
+            unsigned sums[4] = { 0, 0, 0, 0 };
+            unsigned samples = 0;
+
+            for (unsigned box_y = y * scale; box_y < (y + 1) * scale && box_y < expected_image->height; box_y++) {
+                for (unsigned box_x = x * scale; box_x < (x + 1) * scale && box_x < expected_image->width; box_x++) {
+                    const unsigned char *pixel = (const unsigned char *)expected_image->pixels +
+                                                    (size_t)box_y * expected_image->bytes_per_line + (size_t)box_x * channels;
+                    const unsigned weight = (channels == 4) ? pixel[3] : 1;
+
+                    for (unsigned channel = 0; channel < 3; channel++) {
+                        sums[channel] += pixel[channel] * weight;
+                    }
+
+                    sums[3] += weight;
+                    samples++;
+                }
+            }
+
+            const unsigned char *pixel = (const unsigned char *)image->pixels + (size_t)y * image->bytes_per_line + (size_t)x * channels;
+
+            for (unsigned channel = 0; channel < 3; channel++) {
+                munit_assert_uint(pixel[channel], ==, (sums[channel] + sums[3] / 2) / sums[3]);
+            }
+
+            if (channels == 4) {
+                munit_assert_uint(pixel[3], ==, (sums[3] + samples / 2) / samples);
+            }
+        }
+    }
+}
+
+static MunitResult test_reduce(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    unsigned codecs = 0;
+
+    for (const struct sail_codec_info_node *node = sail_codec_info_list(); node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+
+        if (test_write_pixel_format(codec_info) == SAIL_PIXEL_FORMAT_UNKNOWN) {
+            continue;
+        }
+
+        void *buffer;
+        size_t buffer_length;
+        munit_assert(test_encode_image(codec_info, TEST_WIDTH, TEST_HEIGHT, 1, &buffer, &buffer_length) == SAIL_OK);
+
+        struct sail_image *expected_image;
+        munit_assert(sail_read_mem(buffer, buffer_length, &expected_image) == SAIL_OK);
+
+        const bool native = (codec_info->read_features->features & SAIL_CODEC_FEATURE_SCALING) != 0;
+
+        /* Reduced dimensions are rounded up. */
+        const unsigned scale_denominator = 4;
+        struct sail_image *image;
+        munit_assert(read_with_options(buffer, buffer_length, codec_info, set_scale_denominator, &scale_denominator, &image) == SAIL_OK);
+
+        munit_assert_uint(image->width,  ==, 31);
+        munit_assert_uint(image->height, ==, 20);
+
+        if (!native) {
+            check_box_filter(expected_image, image, scale_denominator);
+        }
+
+        sail_destroy_image(image);
+
+        /* The biggest denominator that keeps the longest side not less than the target size. */
+        const unsigned target_size = 40;
+        munit_assert(read_with_options(buffer, buffer_length, codec_info, set_target_size, &target_size, &image) == SAIL_OK);
+
+        munit_assert_uint(image->width,  ==, 62);
+        munit_assert_uint(image->height, ==, 39);
+
+        if (!native) {
+            check_box_filter(expected_image, image, 2);
+        }
+
+        sail_destroy_image(image);
+        sail_destroy_image(expected_image);
+        sail_free(buffer);
+
+        codecs++;
+    }
+
+    sail_finish();
+
+    if (codecs == 0) {
+        return MUNIT_SKIP;
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/roi",    test_roi,    NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/reduce", test_reduce, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/read-options",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,228 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#include "images.h"
+
+#define TEST_WIDTH  123
+#define TEST_HEIGHT 77
+
+/* Number of frames in multi-frame images. */
+#define TEST_FRAMES 3
+
+static const unsigned test_band_heights[] = { 1, 2, 5, 16, 50, TEST_HEIGHT };
+
+/* Reads the rest of the current frame by bands and compares them with the fully decoded frame. */
+static void read_bands(void *state, const struct sail_image *expected_image, unsigned first_row, unsigned band_height) {
+
+    const size_t band_size = (size_t)expected_image->bytes_per_line * band_height;
+    void *band = munit_malloc(band_size);
+
+    for (unsigned row = first_row; row < expected_image->height; ) {
+        const unsigned count = (band_height < expected_image->height - row) ? band_height : expected_image->height - row;
+
+        munit_assert(sail_read_next_rows(state, band, count) == SAIL_OK);
+        munit_assert_memory_equal((size_t)expected_image->bytes_per_line * count,
+                                  band,
+                                  (const unsigned char *)expected_image->pixels + (size_t)expected_image->bytes_per_line * row);
+
+        row += count;
+    }
+
+    /* No more rows are left. */
+    munit_assert(sail_read_next_rows(state, band, 1) == SAIL_ERROR_INVALID_ARGUMENT);
+
+    free(band);
+}
+
+static MunitResult test_bands(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    unsigned codecs = 0;
+
+    for (const struct sail_codec_info_node *node = sail_codec_info_list(); node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+
+        if (test_write_pixel_format(codec_info) == SAIL_PIXEL_FORMAT_UNKNOWN) {
+            continue;
+        }
+
+        void *buffer;
+        size_t buffer_length;
+        munit_assert(test_encode_image(codec_info, TEST_WIDTH, TEST_HEIGHT, 1, &buffer, &buffer_length) == SAIL_OK);
+
+        struct sail_image *expected_image;
+        munit_assert(sail_read_mem(buffer, buffer_length, &expected_image) == SAIL_OK);
+
+        for (size_t i = 0; i < sizeof(test_band_heights) / sizeof(test_band_heights[0]); i++) {
+            void *state;
+            munit_assert(sail_start_reading_mem(buffer, buffer_length, codec_info, &state) == SAIL_OK);
+
+            struct sail_image *image;
+            munit_assert(sail_read_next_frame_header(state, &image) == SAIL_OK);
+
+            munit_assert_uint(image->width,  ==, expected_image->width);
+            munit_assert_uint(image->height, ==, expected_image->height);
+            munit_assert_uint(image->bytes_per_line, ==, expected_image->bytes_per_line);
+            munit_assert_int(image->pixel_format, ==, expected_image->pixel_format);
+            munit_assert_null(image->pixels);
+
+            read_bands(state, expected_image, 0, test_band_heights[i]);
+
+            munit_assert(sail_read_next_frame_header(state, &image) == SAIL_ERROR_NO_MORE_FRAMES);
+            munit_assert(sail_stop_reading(state) == SAIL_OK);
+
+            sail_destroy_image(image);
+        }
+
+        /* Stop in the middle of the only frame. */
+        void *state;
+        munit_assert(sail_start_reading_mem(buffer, buffer_length, codec_info, &state) == SAIL_OK);
+
+        struct sail_image *image;
+        munit_assert(sail_read_next_frame_header(state, &image) == SAIL_OK);
+
+        void *band = munit_malloc((size_t)image->bytes_per_line * 3);
+        munit_assert(sail_read_next_rows(state, band, 3) == SAIL_OK);
+        munit_assert_memory_equal((size_t)image->bytes_per_line * 3, band, expected_image->pixels);
+        free(band);
+        sail_destroy_image(image);
+
+        munit_assert(sail_read_next_frame(state, &image) == SAIL_ERROR_NO_MORE_FRAMES);
+        munit_assert(sail_stop_reading(state) == SAIL_OK);
+
+        sail_destroy_image(expected_image);
+        sail_free(buffer);
+
+        codecs++;
+    }
+
+    sail_finish();
+
+    if (codecs == 0) {
+        return MUNIT_SKIP;
+    }
+
+    return MUNIT_OK;
+}
+
+/* Stops reading a frame by bands in the middle and reads the next frame. */
+static MunitResult test_abandon_frame(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const int multi_frame = SAIL_CODEC_FEATURE_ANIMATED | SAIL_CODEC_FEATURE_MULTI_FRAME;
+    unsigned codecs = 0;
+
+    for (const struct sail_codec_info_node *node = sail_codec_info_list(); node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_info;
+
+        if ((codec_info->read_features->features & multi_frame) == 0 || (codec_info->write_features->features & multi_frame) == 0 ||
+                test_write_pixel_format(codec_info) == SAIL_PIXEL_FORMAT_UNKNOWN) {
+            continue;
+        }
+
+        void *buffer;
+        size_t buffer_length;
+        munit_assert(test_encode_image(codec_info, TEST_WIDTH, TEST_HEIGHT, TEST_FRAMES, &buffer, &buffer_length) == SAIL_OK);
+
+        struct sail_image *expected_images[TEST_FRAMES];
+        void *state;
+        munit_assert(sail_start_reading_mem(buffer, buffer_length, codec_info, &state) == SAIL_OK);
+
+        for (unsigned frame = 0; frame < TEST_FRAMES; frame++) {
+            munit_assert(sail_read_next_frame(state, &expected_images[frame]) == SAIL_OK);
+        }
+
+        munit_assert(sail_stop_reading(state) == SAIL_OK);
+
+        munit_assert(sail_start_reading_mem(buffer, buffer_length, codec_info, &state) == SAIL_OK);
+
+        /* Stop the first frame in the middle. */
+        struct sail_image *image;
+        munit_assert(sail_read_next_frame_header(state, &image) == SAIL_OK);
+        sail_destroy_image(image);
+
+        void *band = munit_malloc((size_t)expected_images[0]->bytes_per_line * 10);
+        munit_assert(sail_read_next_rows(state, band, 10) == SAIL_OK);
+        munit_assert_memory_equal((size_t)expected_images[0]->bytes_per_line * 10, band, expected_images[0]->pixels);
+        free(band);
+
+        /* Skip the second frame without reading its rows. */
+        munit_assert(sail_read_next_frame_header(state, &image) == SAIL_OK);
+        sail_destroy_image(image);
+
+        /* The third frame is read in full. */
+        munit_assert(sail_read_next_frame(state, &image) == SAIL_OK);
+        munit_assert_uint(image->width,  ==, expected_images[2]->width);
+        munit_assert_uint(image->height, ==, expected_images[2]->height);
+        munit_assert_memory_equal((size_t)image->bytes_per_line * image->height, image->pixels, expected_images[2]->pixels);
+        sail_destroy_image(image);
+
+        munit_assert(sail_stop_reading(state) == SAIL_OK);
+
+        for (unsigned frame = 0; frame < TEST_FRAMES; frame++) {
+            sail_destroy_image(expected_images[frame]);
+        }
+
+        sail_free(buffer);
+
+        codecs++;
+    }
+
+    sail_finish();
+
+    if (codecs == 0) {
+        return MUNIT_SKIP;
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/bands",         test_bands,         NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/abandon-frame", test_abandon_frame, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/rows",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}